@@ -0,0 +1,1283 @@
+//------------------------------------------------------------------------------
+//  Pd Spectral Toolkit
+//
+//  bench.c
+//
+//  Headless benchmark harness - instantiates toolkit objects against the stub
+//  runtime and drives their perform routines with synthetic spectra
+//
+//  Copyright (C) 2019 Cooper Baker. All Rights Reserved.
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// headers
+//------------------------------------------------------------------------------
+
+// harness interface to the stub runtime
+#include "pd_stub.h"
+
+// standard headers
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+
+//------------------------------------------------------------------------------
+// constant definitions
+//------------------------------------------------------------------------------
+#define BENCH_MAX_SIGNALS  32
+#define BENCH_FRAMES       8
+#define BENCH_WARMUP       16
+#define BENCH_PI           3.14159265358979323846
+#define BENCH_GOLDEN_FRAMES 64
+#define BENCH_GOLDEN_BLOCKS 4
+#define BENCH_WINDOW       "bench_window"
+#define BENCH_TAIL_OCTAVES 160
+#define BENCH_TAIL_PARTS   16
+#define BENCH_MAX_MESSAGES 8
+#define BENCH_MAX_ATOMS    8
+
+// shapes of the inputs
+#define BENCH_INPUT_SIGNAL   0
+#define BENCH_INPUT_SPARSE   1
+#define BENCH_INPUT_PARTIALS 2
+#define BENCH_INPUT_SCRUB    3
+
+// layout of a sparse partial list ( utility.h ) : the count, then the bins,
+// magnitudes, and frequencies, each PARTIALS_CAPACITY long
+#define BENCH_PARTIALS_CAPACITY( frames ) ( ( ( frames ) - 1 ) / 3 )
+
+
+//------------------------------------------------------------------------------
+// bench_settings - command line configuration
+//------------------------------------------------------------------------------
+typedef struct bench_settings
+{
+    t_int   frames;
+    t_int   channels;
+    t_int   overlap;
+    t_float sample_rate;
+    t_int   blocks;
+    t_int   alias;
+    t_int   capture;
+    t_int   window;
+    t_int   silence;
+    t_int   input;
+
+} t_bench_settings;
+
+
+//------------------------------------------------------------------------------
+// bench_result - measurements for one object
+//------------------------------------------------------------------------------
+typedef struct bench_result
+{
+    double ns_per_sample;
+    double max_block_us;
+    double load;
+    t_int  dsp_allocs;
+    t_int  perform_allocs;
+    t_int  messages;
+    t_int  redraws;
+
+    // slowest stretch of the decaying half when fading to silence
+    double tail_ns_per_sample;
+
+    // outlet vectors of every timed block when capturing ( block major )
+    t_sample* outputs;
+    t_int     outlets;
+
+} t_bench_result;
+
+
+//------------------------------------------------------------------------------
+// bench_tolerance - allowed deviation from golden outputs for one object
+//------------------------------------------------------------------------------
+// a sample passes when it is within either bound; nan and inf must match exactly
+//------------------------------------------------------------------------------
+typedef struct bench_tolerance
+{
+    const char* name;
+    t_int       ulps;
+    double      absolute;
+
+} t_bench_tolerance;
+
+static const t_bench_tolerance bench_tolerances[] =
+{
+    // fft based objects accumulate rounding over log2( frames ) passes
+    { "pafft~",       256, 1e-3 },
+    { "paifft~",      256, 1e-3 },
+    { "winfft~",      256, 1e-3 },
+    { "winifft~",     256, 1e-3 },
+    { "partconv~",    256, 1e-3 },
+
+    // phase unwrapping and oscillator accumulation
+    { "cartofreq~",    64, 1e-3 },
+    { "phasetofreq~",  64, 1e-3 },
+    { "polartofreq~",  64, 1e-3 },
+    { "fundfreq~",     64, 1e-3 },
+    { "freqtocar~",    64, 1e-4 },
+    { "freqtophase~",  64, 1e-4 },
+    { "freqtopolar~",  64, 1e-4 },
+    { "phaseaccum~",   64, 1e-4 },
+    { "oscbank~",      64, 1e-4 },
+
+    // transcendental conversions
+    { "amptodb~",      16, 1e-5 },
+    { "cartodb~",      16, 1e-5 },
+    { "magtodb~",      16, 1e-5 },
+    { "dbtoamp~",      16, 1e-6 },
+    { "dbtomag~",      16, 1e-6 },
+
+    // everything else
+    { 0,                4, 1e-6 }
+};
+
+
+//------------------------------------------------------------------------------
+// bench_variant - a golden case with creation arguments, messages, or input
+//------------------------------------------------------------------------------
+// the default golden case of each object has no arguments, so variants cover
+// the argument classes and modes it misses; messages are separated by
+// semicolons and sent before dsp, or before timed block n when prefixed @n
+//------------------------------------------------------------------------------
+typedef struct bench_variant
+{
+    const char* label;
+    const char* name;
+    const char* arguments;
+    const char* messages;
+    t_int       input;
+
+} t_bench_variant;
+
+static const t_bench_variant bench_variants[] =
+{
+    // operators against a constant
+    { "!&&~/arg",           "!&&~",         "0.25",       0,           BENCH_INPUT_SIGNAL   },
+    { "!=~/arg",            "!=~",          "0.25",       0,           BENCH_INPUT_SIGNAL   },
+    { "!||~/arg",           "!||~",         "0.25",       0,           BENCH_INPUT_SIGNAL   },
+    { "&&~/arg",            "&&~",          "0.25",       0,           BENCH_INPUT_SIGNAL   },
+    { "<=~/arg",            "<=~",          "0.25",       0,           BENCH_INPUT_SIGNAL   },
+    { "<~/arg",             "<~",           "0.25",       0,           BENCH_INPUT_SIGNAL   },
+    { "==~/arg",            "==~",          "0.25",       0,           BENCH_INPUT_SIGNAL   },
+    { ">=~/arg",            ">=~",          "0.25",       0,           BENCH_INPUT_SIGNAL   },
+    { ">~/arg",             ">~",           "0.25",       0,           BENCH_INPUT_SIGNAL   },
+    { "||~/arg",            "||~",          "0.25",       0,           BENCH_INPUT_SIGNAL   },
+
+    // modulo by a constant divisor of either sign
+    { "%~/divisor",         "%~",           "0.3",        0,           BENCH_INPUT_SIGNAL   },
+    { "%~/negative",        "%~",           "-0.3",       0,           BENCH_INPUT_SIGNAL   },
+
+    // complex operators against a constant
+    { "cmplxadd~/arg",      "cmplxadd~",    "0.5 -0.25",  0,           BENCH_INPUT_SIGNAL   },
+    { "cmplxdiv~/arg",      "cmplxdiv~",    "0.5 -0.25",  0,           BENCH_INPUT_SIGNAL   },
+    { "cmplxmult~/arg",     "cmplxmult~",   "0.5 -0.25",  0,           BENCH_INPUT_SIGNAL   },
+    { "cmplxsub~/arg",      "cmplxsub~",    "0.5 -0.25",  0,           BENCH_INPUT_SIGNAL   },
+
+    // other argument classes
+    { "binmonitor~/arg",    "binmonitor~",  "3",          0,           BENCH_INPUT_SIGNAL   },
+    { "rotate~/arg",        "rotate~",      "3",          0,           BENCH_INPUT_SIGNAL   },
+    { "scale~/arg",         "scale~",       "0 1 -1 1",   0,           BENCH_INPUT_SIGNAL   },
+
+    // range gates
+    { "bintrim~/gate",      "bintrim~",     "4 20",       0,           BENCH_INPUT_SIGNAL   },
+    { "magtrim~/gate",      "magtrim~",     "0.05 0.5",   0,           BENCH_INPUT_SIGNAL   },
+    { "magscale~/gate",     "magscale~",    "5000 20000", 0,           BENCH_INPUT_SIGNAL   },
+
+    // rounding to a precision
+    { "rounder~/precision", "rounder~",     "0.05",       0,           BENCH_INPUT_SIGNAL   },
+    { "trunc~/precision",   "trunc~",       "0.05",       0,           BENCH_INPUT_SIGNAL   },
+
+    // holds carried across blocks into each block's leading zero run, and
+    // dropped by a reset before the third block
+    { "blocksmooth~/carry", "blocksmooth~", 0,            0,           BENCH_INPUT_SPARSE   },
+    { "blocksmooth~/reset", "blocksmooth~", 0,            "@2 reset",  BENCH_INPUT_SPARSE   },
+
+    // oscillator bank modes
+    { "oscbank~/sparse",    "oscbank~",     0,            "sparse 1",  BENCH_INPUT_PARTIALS },
+    { "oscbank~/ifft",      "oscbank~",     0,            "ifft 1",    BENCH_INPUT_SIGNAL   },
+    { "oscbank~/threads",   "oscbank~",     0,            "threads 2", BENCH_INPUT_SIGNAL   },
+
+    // frames recorded every block and played back between whole positions
+    { "framestore~/record", "framestore~",  "2",          "record 1",  BENCH_INPUT_SCRUB    },
+
+    { 0 }
+};
+
+
+//------------------------------------------------------------------------------
+// bench_message - a message parsed from a variant
+//------------------------------------------------------------------------------
+typedef struct bench_message
+{
+    t_int     block;
+    t_symbol* selector;
+    t_atom    atoms[ BENCH_MAX_ATOMS ];
+    t_int     count;
+
+} t_bench_message;
+
+
+//------------------------------------------------------------------------------
+// allocation counters - installed with -Wl,--wrap=malloc,--wrap=calloc, ...
+//------------------------------------------------------------------------------
+void* __real_malloc  ( size_t size );
+void* __real_calloc  ( size_t count, size_t size );
+void* __real_realloc ( void* pointer, size_t size );
+void  __real_free    ( void* pointer );
+
+void* __wrap_malloc( size_t size )
+{
+    ++stub_counters.allocs;
+    return __real_malloc( size );
+}
+
+void* __wrap_calloc( size_t count, size_t size )
+{
+    ++stub_counters.allocs;
+    return __real_calloc( count, size );
+}
+
+void* __wrap_realloc( void* pointer, size_t size )
+{
+    ++stub_counters.allocs;
+    return __real_realloc( pointer, size );
+}
+
+void __wrap_free( void* pointer )
+{
+    if( pointer )
+    {
+        ++stub_counters.frees;
+    }
+    __real_free( pointer );
+}
+
+
+//------------------------------------------------------------------------------
+// bench_now - monotonic time in nanoseconds
+//------------------------------------------------------------------------------
+static double bench_now( void )
+{
+    struct timespec time;
+
+    clock_gettime( CLOCK_MONOTONIC, &time );
+
+    return time.tv_sec * 1e9 + time.tv_nsec;
+}
+
+
+//------------------------------------------------------------------------------
+// bench_fill - synthesizes test frame f for signal inlet i
+//------------------------------------------------------------------------------
+// inlet 1 : a harmonic magnitude comb over a low noise floor ( peaks, sieves,
+//           trims, and time domain inputs all see realistic structure )
+// inlet 2 : bin center frequencies with a small deviation ( frequency, phase,
+//           and imaginary inputs )
+// others  : a slow ramp scaled to the unit range ( gains, thresholds, mixes )
+//
+// a sparse input drops the comb's noise floor, leaving zero runs between the
+// harmonics, a partials input packs the harmonics as a sparse partial list,
+// and a scrub input offsets the other inlets' ramps by a fraction per frame so
+// position inputs land between whole frames
+//------------------------------------------------------------------------------
+static void bench_fill( t_sample* vector, t_int frames, t_int inlet, t_int frame, t_float sample_rate, t_int input )
+{
+    unsigned int seed        = ( unsigned int )( 1 + inlet * 7919 + frame * 104729 );
+    t_int        fundamental = 6 + frame;
+    t_int        capacity    = BENCH_PARTIALS_CAPACITY( frames );
+    t_int        count       = 0;
+    t_int        n;
+
+    if( inlet == 0 && input == BENCH_INPUT_PARTIALS )
+    {
+        memset( vector, 0, sizeof( t_sample ) * frames );
+
+        for( n = fundamental ; n < frames / 2 && count < capacity ; n += fundamental )
+        {
+            vector[ 1 + count ]                = ( t_sample )n;
+            vector[ 1 + capacity + count ]     = 1.0f / ( n / fundamental );
+            vector[ 1 + capacity * 2 + count ] = n * sample_rate / frames;
+            ++count;
+        }
+
+        vector[ 0 ] = ( t_sample )count;
+
+        return;
+    }
+
+    for( n = 0 ; n < frames ; ++n )
+    {
+        t_sample noise;
+
+        seed  = seed * 1664525 + 1013904223;
+        noise = ( t_sample )( seed >> 8 ) / ( t_sample )( 1 << 24 ) - 0.5f;
+
+        switch( inlet )
+        {
+            case 0 :
+                vector[ n ] = input == BENCH_INPUT_SPARSE ? 0.0f : 0.0001f + 0.0001f * noise;
+                if( n && n % fundamental == 0 )
+                {
+                    vector[ n ] += 1.0f / ( n / fundamental );
+                }
+                break;
+
+            case 1 :
+                vector[ n ] = n * sample_rate / frames + noise * sample_rate / frames;
+                break;
+
+            default :
+                vector[ n ] = ( t_sample )( n % 64 ) / 64.0f;
+                if( input == BENCH_INPUT_SCRUB )
+                {
+                    vector[ n ] += 0.375f * frame;
+                }
+                break;
+        }
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// bench_window - creates a hann window array of block size
+//------------------------------------------------------------------------------
+static void bench_window( const char* name, t_int frames )
+{
+    t_word* words = stub_garraywords( stub_garraynew( name, frames ) );
+    t_int   n;
+
+    for( n = 0 ; n < frames ; ++n )
+    {
+        words[ n ].w_float = ( t_float )( 0.5 - 0.5 * cos( 2.0 * BENCH_PI * n / frames ) );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// bench_atom - converts a word into a float atom, or a symbol atom otherwise
+//------------------------------------------------------------------------------
+static void bench_atom( const char* word, t_atom* atom )
+{
+    char*  end;
+    double value = strtod( word, &end );
+
+    if( *end == '\0' && end != word )
+    {
+        SETFLOAT( atom, ( t_float )value );
+    }
+    else
+    {
+        SETSYMBOL( atom, gensym( word ) );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// bench_atoms - converts space separated words into atoms, returning the count
+//------------------------------------------------------------------------------
+static t_int bench_atoms( const char* text, t_atom* atoms, t_int size )
+{
+    char  buffer[ MAXPDSTRING ];
+    char* word;
+    t_int count = 0;
+
+    strncpy( buffer, text ? text : "", MAXPDSTRING - 1 );
+    buffer[ MAXPDSTRING - 1 ] = 0;
+
+    for( word = strtok( buffer, " " ) ; word && count < size ; word = strtok( 0, " " ) )
+    {
+        bench_atom( word, &atoms[ count++ ] );
+    }
+
+    return count;
+}
+
+
+//------------------------------------------------------------------------------
+// bench_messages - parses semicolon separated messages, returning the count
+//------------------------------------------------------------------------------
+static t_int bench_messages( const char* text, t_bench_message* messages )
+{
+    char   buffer[ MAXPDSTRING ];
+    char*  next;
+    char*  part;
+    t_atom atoms[ BENCH_MAX_ATOMS + 1 ];
+    t_int  count = 0;
+    t_int  items;
+
+    strncpy( buffer, text ? text : "", MAXPDSTRING - 1 );
+    buffer[ MAXPDSTRING - 1 ] = 0;
+
+    for( part = buffer ; part && count < BENCH_MAX_MESSAGES ; part = next )
+    {
+        next = strchr( part, ';' );
+
+        if( next )
+        {
+            *next++ = 0;
+        }
+
+        while( *part == ' ' )
+        {
+            ++part;
+        }
+
+        messages[ count ].block = -1;
+
+        // a leading @n sends the message before timed block n
+        if( *part == '@' )
+        {
+            messages[ count ].block = strtol( part + 1, &part, 10 );
+        }
+
+        items = bench_atoms( part, atoms, BENCH_MAX_ATOMS + 1 );
+
+        if( !items || atoms[ 0 ].a_type != A_SYMBOL )
+        {
+            continue;
+        }
+
+        messages[ count ].selector = atoms[ 0 ].a_w.w_symbol;
+        messages[ count ].count    = items - 1;
+        memcpy( messages[ count ].atoms, atoms + 1, sizeof( t_atom ) * ( items - 1 ) );
+        ++count;
+    }
+
+    return count;
+}
+
+
+//------------------------------------------------------------------------------
+// bench_send - sends the parsed messages due before a timed block, or before
+// dsp when block is -1
+//------------------------------------------------------------------------------
+static void bench_send( t_pd* object, t_bench_message* messages, t_int count, t_int block )
+{
+    t_int n;
+
+    for( n = 0 ; n < count ; ++n )
+    {
+        if( messages[ n ].block == block )
+        {
+            stub_message( object, messages[ n ].selector->s_name, messages[ n ].count, messages[ n ].atoms );
+        }
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// bench_run - benchmarks one object and reports its measurements
+//------------------------------------------------------------------------------
+static t_int bench_run( const char* name, t_int argc, t_atom* argv, const char* message_text, t_bench_settings* settings, t_bench_result* result )
+{
+    t_bench_message messages[ BENCH_MAX_MESSAGES ];
+    t_signal  signals[ BENCH_MAX_SIGNALS ];
+    t_signal* sig[ BENCH_MAX_SIGNALS ];
+    t_sample* frames_in[ BENCH_MAX_SIGNALS ][ BENCH_FRAMES ];
+    t_sample* vectors[ BENCH_MAX_SIGNALS ];
+    t_pd*     object;
+    t_int     inlets;
+    t_int     outlets;
+    t_int     count;
+    t_int     block;
+    t_int     n;
+    t_int     f;
+    t_int     channel;
+    t_atom    overlap;
+    double    elapsed = 0;
+    double    tail[ BENCH_TAIL_PARTS ] = { 0 };
+    double    start;
+    double    duration;
+    double    gain;
+
+    // when fading to silence the second half of the timed blocks is the tail
+    t_int     signal_blocks = settings->silence ? settings->blocks / 2 : settings->blocks;
+
+    // messages from the command line or a golden variant
+    t_int     message_count = bench_messages( message_text, messages );
+
+    memset( result, 0, sizeof( t_bench_result ) );
+
+    object = stub_newobject( name, argc, argv );
+
+    if( !object )
+    {
+        fprintf( stderr, "error: %s: could not create object\n", name );
+        return 0;
+    }
+
+    // only multichannel objects take more than one channel per signal
+    if( !stub_hasmethod( object, "dsp" ) || ( settings->channels > 1 && !stub_multichannel( object ) ) )
+    {
+        stub_freeobject( object );
+        return 0;
+    }
+
+    // tell overlap aware objects about the block overlap
+    if( stub_hasmethod( object, "overlap" ) )
+    {
+        SETFLOAT( &overlap, settings->overlap );
+        stub_message( object, "overlap", 1, &overlap );
+    }
+
+    // point array based objects created without arguments at the bench window,
+    // made fresh for each object since objects such as tabindex~ write to it
+    if( settings->window && !argc && stub_methodarg( object, "set", 0 ) == A_SYMBOL )
+    {
+        t_atom window;
+
+        bench_window( BENCH_WINDOW, settings->frames );
+
+        SETSYMBOL( &window, gensym( BENCH_WINDOW ) );
+        stub_message( object, "set", 1, &window );
+    }
+
+    bench_send( object, messages, message_count, -1 );
+
+    inlets  = stub_signalinlets( object );
+    outlets = stub_signaloutlets( object );
+    count   = inlets + outlets;
+
+    if( count > BENCH_MAX_SIGNALS )
+    {
+        fprintf( stderr, "error: %s: too many signals\n", name );
+        stub_freeobject( object );
+        return 0;
+    }
+
+    // allocate signal vectors with room for every channel, letting outlets
+    // share inlet vectors when aliasing
+    for( n = 0 ; n < count ; ++n )
+    {
+        if( settings->alias && n >= inlets && n - inlets < inlets )
+        {
+            vectors[ n ] = vectors[ n - inlets ];
+        }
+        else
+        {
+            vectors[ n ] = ( t_sample* )calloc( settings->frames * settings->channels, sizeof( t_sample ) );
+        }
+
+        memset( &signals[ n ], 0, sizeof( t_signal ) );
+        signals[ n ].s_n       = ( int )settings->frames;
+        signals[ n ].s_vecsize = ( int )( settings->frames * settings->channels );
+        signals[ n ].s_vec     = vectors[ n ];
+        signals[ n ].s_sr      = settings->sample_rate * settings->overlap;
+#ifdef CLASS_MULTICHANNEL
+        signals[ n ].s_nchans  = ( int )( n < inlets ? settings->channels : 1 );
+#endif
+        sig[ n ]               = &signals[ n ];
+    }
+
+    // synthesize a rotating set of input frames
+    for( n = 0 ; n < inlets ; ++n )
+    {
+        for( f = 0 ; f < BENCH_FRAMES ; ++f )
+        {
+            frames_in[ n ][ f ] = ( t_sample* )malloc( sizeof( t_sample ) * settings->frames );
+            bench_fill( frames_in[ n ][ f ], settings->frames, n, f, settings->sample_rate * settings->overlap, settings->input );
+        }
+    }
+
+    if( settings->capture )
+    {
+        result->outlets = outlets;
+        result->outputs = ( t_sample* )malloc( sizeof( t_sample ) * ( outlets * settings->blocks * settings->frames * settings->channels + 1 ) );
+    }
+
+    // build the dsp chain
+    stub_dspclear();
+    stub_counters.allocs = 0;
+    stub_dsp( object, sig );
+    result->dsp_allocs = stub_counters.allocs;
+
+    // run the chain, timing every block after warm up
+    for( block = -BENCH_WARMUP ; block < settings->blocks ; ++block )
+    {
+        f = ( block + BENCH_WARMUP ) % BENCH_FRAMES;
+
+        // each channel starts at a different frame of the rotation
+        for( n = 0 ; n < inlets ; ++n )
+        {
+            for( channel = 0 ; channel < settings->channels ; ++channel )
+            {
+                memcpy( &vectors[ n ][ channel * settings->frames ], frames_in[ n ][ ( f + channel ) % BENCH_FRAMES ], sizeof( t_sample ) * settings->frames );
+            }
+        }
+
+        // fade every input exponentially through the subnormal range to
+        // silence over the tail, the way a decaying patch goes idle
+        if( block >= signal_blocks )
+        {
+            gain = pow( 2.0, -( double )BENCH_TAIL_OCTAVES * ( block - signal_blocks + 1 ) / ( settings->blocks - signal_blocks ) );
+
+            for( n = 0 ; n < inlets ; ++n )
+            {
+                for( f = 0 ; f < settings->frames * settings->channels ; ++f )
+                {
+                    vectors[ n ][ f ] = ( t_sample )( vectors[ n ][ f ] * gain );
+                }
+            }
+        }
+
+        if( block == 0 )
+        {
+            stub_counters.allocs   = 0;
+            stub_counters.messages = 0;
+            stub_counters.redraws  = 0;
+        }
+
+        if( block >= 0 )
+        {
+            bench_send( object, messages, message_count, block );
+        }
+
+        start = bench_now();
+        stub_dsptick();
+        duration = bench_now() - start;
+
+        // run scheduler side clocks outside the timed region
+        stub_advance( 1000.0 * settings->frames / ( settings->sample_rate * settings->overlap ) );
+
+        if( block >= signal_blocks )
+        {
+            tail[ ( block - signal_blocks ) * BENCH_TAIL_PARTS / ( settings->blocks - signal_blocks ) ] += duration;
+        }
+        else if( block >= 0 )
+        {
+            elapsed += duration;
+
+            if( duration / 1000.0 > result->max_block_us )
+            {
+                result->max_block_us = duration / 1000.0;
+            }
+        }
+
+        if( block >= 0 )
+        {
+            if( settings->capture )
+            {
+                for( n = 0 ; n < outlets ; ++n )
+                {
+                    memcpy( &result->outputs[ ( block * outlets + n ) * settings->frames * settings->channels ], sig[ inlets + n ]->s_vec, sizeof( t_sample ) * settings->frames * settings->channels );
+                }
+            }
+
+        }
+    }
+
+    result->perform_allocs = stub_counters.allocs;
+    result->messages       = stub_counters.messages;
+    result->redraws        = stub_counters.redraws;
+    result->ns_per_sample  = elapsed / ( ( double )signal_blocks * settings->frames * settings->channels );
+
+    // the subnormal part of the fade spans about one tail part, so the slowest
+    // part shows the cost of an object whose state goes subnormal
+    for( n = 0 ; settings->silence && n < BENCH_TAIL_PARTS ; ++n )
+    {
+        double part_blocks = ( double )( ( n + 1 ) * ( settings->blocks - signal_blocks ) / BENCH_TAIL_PARTS - n * ( settings->blocks - signal_blocks ) / BENCH_TAIL_PARTS );
+
+        if( tail[ n ] / ( part_blocks * settings->frames * settings->channels ) > result->tail_ns_per_sample )
+        {
+            result->tail_ns_per_sample = tail[ n ] / ( part_blocks * settings->frames * settings->channels );
+        }
+    }
+
+    // fraction of one core used at the configured sample rate and overlap
+    result->load = elapsed / signal_blocks * ( settings->sample_rate * settings->overlap / settings->frames ) / 1e7;
+
+    stub_dspclear();
+    stub_freeobject( object );
+
+    for( n = 0 ; n < count ; ++n )
+    {
+        if( !( settings->alias && n >= inlets && n - inlets < inlets ) )
+        {
+            free( vectors[ n ] );
+        }
+    }
+
+    for( n = 0 ; n < inlets ; ++n )
+    {
+        for( f = 0 ; f < BENCH_FRAMES ; ++f )
+        {
+            free( frames_in[ n ][ f ] );
+        }
+    }
+
+    return 1;
+}
+
+
+//------------------------------------------------------------------------------
+// bench_report - prints one result line
+//------------------------------------------------------------------------------
+static void bench_report( const char* name, t_bench_settings* settings, t_bench_result* result )
+{
+    printf( "%-16s %6ld %4ld %11.3f %11.2f %8.3f %9.2f %6ld %6ld %8ld %8ld",
+        name,
+        ( long )settings->frames,
+        ( long )settings->overlap,
+        result->ns_per_sample,
+        1000.0 / result->ns_per_sample,
+        result->load,
+        result->max_block_us,
+        ( long )result->dsp_allocs,
+        ( long )result->perform_allocs,
+        ( long )result->messages,
+        ( long )result->redraws );
+
+    // a flat tail keeps its cost near the signal cost as the input decays
+    if( settings->silence )
+    {
+        printf( " %11.3f %7.2f",
+            result->tail_ns_per_sample,
+            result->tail_ns_per_sample / result->ns_per_sample );
+    }
+
+    printf( "\n" );
+
+    fflush( stdout );
+}
+
+
+//------------------------------------------------------------------------------
+// bench_bits - raw bits of a sample ( exact under -Ofast, unlike isnan )
+//------------------------------------------------------------------------------
+static unsigned int bench_bits( t_sample value )
+{
+    unsigned int bits;
+
+    memcpy( &bits, &value, sizeof( bits ) );
+
+    return bits;
+}
+
+
+//------------------------------------------------------------------------------
+// bench_ulps - distance between two finite samples in units in the last place
+//------------------------------------------------------------------------------
+static long long bench_ulps( t_sample a, t_sample b )
+{
+    long long ordered_a = bench_bits( a );
+    long long ordered_b = bench_bits( b );
+
+    // map sign magnitude bit patterns onto a monotonic integer line
+    if( ordered_a & 0x80000000LL ) ordered_a = 0x80000000LL - ordered_a;
+    if( ordered_b & 0x80000000LL ) ordered_b = 0x80000000LL - ordered_b;
+
+    return ordered_a > ordered_b ? ordered_a - ordered_b : ordered_b - ordered_a;
+}
+
+
+//------------------------------------------------------------------------------
+// bench_tolerance - finds the golden tolerance for an object
+//------------------------------------------------------------------------------
+static const t_bench_tolerance* bench_tolerance( const char* name )
+{
+    const t_bench_tolerance* tolerance = bench_tolerances;
+
+    while( tolerance->name && strcmp( tolerance->name, name ) )
+    {
+        ++tolerance;
+    }
+
+    return tolerance;
+}
+
+
+//------------------------------------------------------------------------------
+// bench_objectname - name of the nth distinct object in setup order, or null
+//------------------------------------------------------------------------------
+static const char* bench_objectname( t_int index )
+{
+    t_int n;
+
+    // classes are registered newest first, so walk backwards for setup order
+    for( n = stub_classcount() - 1 ; n >= 0 ; --n )
+    {
+        const char* name = stub_classname( n );
+
+        // skip classes registered more than once under the same name
+        if( n && !strcmp( name, stub_classname( n - 1 ) ) )
+        {
+            continue;
+        }
+
+        if( index-- == 0 )
+        {
+            return name;
+        }
+    }
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+// bench_run_variant - runs a golden variant with its arguments, messages, and input
+//------------------------------------------------------------------------------
+static t_int bench_run_variant( const t_bench_variant* variant, t_bench_settings* settings, t_bench_result* result )
+{
+    t_atom atoms[ BENCH_MAX_ATOMS ];
+    t_int  count = bench_atoms( variant->arguments, atoms, BENCH_MAX_ATOMS );
+    t_int  status;
+
+    settings->input = variant->input;
+    status          = bench_run( variant->name, count, atoms, variant->messages, settings, result );
+    settings->input = BENCH_INPUT_SIGNAL;
+
+    return status;
+}
+
+
+//------------------------------------------------------------------------------
+// bench_write - writes one golden case's outputs
+//------------------------------------------------------------------------------
+static void bench_write( FILE* file, const char* kind, const char* name, t_bench_settings* settings, t_bench_result* result )
+{
+    t_int n;
+
+    fprintf( file, "%s %s %ld\n", kind, name, ( long )result->outlets );
+
+    for( n = 0 ; n < result->outlets * settings->blocks * settings->frames ; ++n )
+    {
+        fprintf( file, "%.9g%c", result->outputs[ n ], ( n % 8 == 7 ) ? '\n' : ' ' );
+    }
+
+    if( n % 8 )
+    {
+        fputc( '\n', file );
+    }
+
+    free( result->outputs );
+    printf( "recorded %s\n", name );
+}
+
+
+//------------------------------------------------------------------------------
+// bench_record - writes golden outputs of every signal object to a file
+//------------------------------------------------------------------------------
+static t_int bench_record( const char* path, t_bench_settings* settings )
+{
+    t_bench_result         result;
+    const t_bench_variant* variant;
+    const char*            name;
+    FILE*                  file = fopen( path, "w" );
+    t_int                  index;
+
+    if( !file )
+    {
+        fprintf( stderr, "error: %s: could not open for writing\n", path );
+        return 0;
+    }
+
+    fprintf( file, "pd_spectral_toolkit_golden frames %ld overlap %ld rate %g blocks %ld\n",
+        ( long )settings->frames, ( long )settings->overlap, settings->sample_rate, ( long )settings->blocks );
+
+    for( index = 0 ; ( name = bench_objectname( index ) ) ; ++index )
+    {
+        if( bench_run( name, 0, 0, 0, settings, &result ) )
+        {
+            bench_write( file, "object", name, settings, &result );
+        }
+    }
+
+    for( variant = bench_variants ; variant->label ; ++variant )
+    {
+        if( bench_run_variant( variant, settings, &result ) )
+        {
+            bench_write( file, "variant", variant->label, settings, &result );
+        }
+    }
+
+    fclose( file );
+
+    return 1;
+}
+
+
+//------------------------------------------------------------------------------
+// bench_compare - checks every object against golden outputs from a file
+//------------------------------------------------------------------------------
+static t_int bench_compare( const char* path, t_bench_settings* settings )
+{
+    t_bench_result         result;
+    const t_bench_variant* variant;
+    t_sample*              golden   = 0;
+    t_int*                 seen;
+    t_int*                 seen_variants;
+    FILE*                  file     = fopen( path, "r" );
+    char                   kind[ 16 ];
+    char                   name[ MAXPDSTRING ];
+    char                   token[ 64 ];
+    long                   frames;
+    long                   overlap;
+    long                   blocks;
+    long                   outlets;
+    double                 rate;
+    t_int                  failures = 0;
+    t_int                  compared = 0;
+    t_int                  index;
+    t_int                  count;
+    t_int                  n;
+    t_int                  status;
+
+    if( !file )
+    {
+        fprintf( stderr, "error: %s: could not open for reading\n", path );
+        return 0;
+    }
+
+    if( fscanf( file, "pd_spectral_toolkit_golden frames %ld overlap %ld rate %lf blocks %ld", &frames, &overlap, &rate, &blocks ) != 4 )
+    {
+        fprintf( stderr, "error: %s: not a golden output file\n", path );
+        fclose( file );
+        return 0;
+    }
+
+    // replay with the settings the golden outputs were recorded with
+    settings->frames      = frames;
+    settings->channels    = 1;
+    settings->overlap     = overlap;
+    settings->sample_rate = ( t_float )rate;
+    settings->blocks      = blocks;
+
+    bench_window( BENCH_WINDOW, settings->frames );
+
+    seen          = ( t_int* )calloc( stub_classcount() + 1, sizeof( t_int ) );
+    seen_variants = ( t_int* )calloc( sizeof( bench_variants ) / sizeof( bench_variants[ 0 ] ), sizeof( t_int ) );
+
+    printf( "%-16s %7s %14s %10s %s\n", "object", "outlets", "max abs error", "max ulps", "result" );
+
+    while( fscanf( file, " %15s %999s %ld", kind, name, &outlets ) == 3 )
+    {
+        const t_bench_tolerance* tolerance;
+        double                   max_error = 0;
+        long long                max_ulps  = 0;
+        t_int                    mismatch  = 0;
+
+        // a variant replays its arguments and messages, with its object's tolerance
+        variant = 0;
+
+        if( !strcmp( kind, "variant" ) )
+        {
+            variant = bench_variants;
+
+            while( variant->label && strcmp( variant->label, name ) )
+            {
+                ++variant;
+            }
+
+            if( variant->label )
+            {
+                seen_variants[ variant - bench_variants ] = 1;
+            }
+        }
+
+        tolerance = bench_tolerance( variant && variant->label ? variant->name : name );
+
+        for( index = 0 ; bench_objectname( index ) ; ++index )
+        {
+            if( !variant && !strcmp( bench_objectname( index ), name ) )
+            {
+                seen[ index ] = 1;
+            }
+        }
+
+        count  = outlets * blocks * frames;
+        golden = ( t_sample* )realloc( golden, sizeof( t_sample ) * ( count + 1 ) );
+
+        for( n = 0 ; n < count ; ++n )
+        {
+            if( fscanf( file, "%63s", token ) != 1 )
+            {
+                fprintf( stderr, "error: %s: truncated at %s\n", path, name );
+                fclose( file );
+                free( golden );
+                free( seen );
+                free( seen_variants );
+                return 0;
+            }
+
+            golden[ n ] = ( t_sample )strtod( token, 0 );
+        }
+
+        result.outputs = 0;
+
+        if( variant )
+        {
+            status = variant->label && bench_run_variant( variant, settings, &result );
+        }
+        else
+        {
+            status = bench_run( name, 0, 0, 0, settings, &result );
+        }
+
+        if( !status || result.outlets != outlets )
+        {
+            printf( "%-16s %7ld %14s %10s FAIL ( missing or changed outlets )\n", name, outlets, "-", "-" );
+            free( result.outputs );
+            ++failures;
+            continue;
+        }
+
+        for( n = 0 ; n < count ; ++n )
+        {
+            t_sample     expected      = golden[ n ];
+            t_sample     actual        = result.outputs[ n ];
+            unsigned int expected_bits = bench_bits( expected );
+            unsigned int actual_bits   = bench_bits( actual );
+            t_int        expected_nan  = ( expected_bits & 0x7fffffff ) > 0x7f800000;
+            t_int        actual_nan    = ( actual_bits   & 0x7fffffff ) > 0x7f800000;
+            double       error;
+            long long    ulps;
+
+            // non finite values must match in kind
+            if( ( expected_bits & 0x7f800000 ) == 0x7f800000 || ( actual_bits & 0x7f800000 ) == 0x7f800000 )
+            {
+                if( expected_nan != actual_nan || ( !expected_nan && expected_bits != actual_bits ) )
+                {
+                    ++mismatch;
+                }
+                continue;
+            }
+
+            error = ( double )actual - ( double )expected;
+            error = error < 0 ? -error : error;
+            ulps  = bench_ulps( actual, expected );
+
+            if( error > max_error ) max_error = error;
+            if( ulps  > max_ulps  ) max_ulps  = ulps;
+
+            if( error > tolerance->absolute && ulps > tolerance->ulps )
+            {
+                ++mismatch;
+            }
+        }
+
+        printf( "%-16s %7ld %14.3g %10lld %s\n", name, outlets, max_error, max_ulps, mismatch ? "FAIL" : "ok" );
+
+        if( mismatch )
+        {
+            ++failures;
+        }
+
+        free( result.outputs );
+        ++compared;
+    }
+
+    fclose( file );
+    free( golden );
+
+    // objects that have no golden outputs yet
+    for( index = 0 ; bench_objectname( index ) ; ++index )
+    {
+        if( !seen[ index ] && bench_run( bench_objectname( index ), 0, 0, 0, settings, &result ) )
+        {
+            printf( "%-16s %7ld %14s %10s new ( no golden outputs )\n", bench_objectname( index ), ( long )result.outlets, "-", "-" );
+            free( result.outputs );
+        }
+    }
+
+    for( variant = bench_variants ; variant->label ; ++variant )
+    {
+        if( !seen_variants[ variant - bench_variants ] && bench_run_variant( variant, settings, &result ) )
+        {
+            printf( "%-16s %7ld %14s %10s new ( no golden outputs )\n", variant->label, ( long )result.outlets, "-", "-" );
+            free( result.outputs );
+        }
+    }
+
+    free( seen );
+    free( seen_variants );
+
+    printf( "%ld compared, %ld failed\n", ( long )compared, ( long )failures );
+
+    return failures == 0;
+}
+
+
+//------------------------------------------------------------------------------
+// bench_usage - prints command line help
+//------------------------------------------------------------------------------
+static void bench_usage( void )
+{
+    fprintf( stderr,
+        "usage: pd_spectral_toolkit_bench [options] [object [arguments ...]]\n"
+        "  -n <frames>    block size ( default 1024 )\n"
+        "  -m <channels>  channels per signal for multichannel objects ( default 1 )\n"
+        "  -o <overlap>   overlap factor ( default 1 )\n"
+        "  -r <rate>      sample rate ( default 44100 )\n"
+        "  -b <blocks>    blocks to time ( default 2000 )\n"
+        "  -t <name>      create a hann window array named <name> of block size\n"
+        "  -x             alias outlet vectors onto inlet vectors ( in-place dsp )\n"
+        "  -s             fade inputs through subnormals to silence over the second half\n"
+        "                 and report the slowest sixteenth of that tail\n"
+        "  -e <messages>  send messages before dsp, separated by semicolons ( @n sends\n"
+        "                 one before timed block n, e.g. \"threads 2; @100 reset\" )\n"
+        "  -v             show pd console output\n"
+        "  -a             benchmark every signal object with default arguments\n"
+        "  -w <file>      record golden outputs of every signal object and variant\n"
+        "  -c <file>      compare every signal object and variant against golden outputs\n" );
+}
+
+
+//------------------------------------------------------------------------------
+// main
+//------------------------------------------------------------------------------
+void pd_spectral_toolkit_setup( void );
+
+int main( int argc, char** argv )
+{
+    t_bench_settings settings;
+    t_bench_result   result;
+    t_atom           atoms[ MAXPDARG * 4 ];
+    const char*      tables[ 16 ];
+    const char*      record      = 0;
+    const char*      compare     = 0;
+    const char*      messages    = 0;
+    const char*      name;
+    t_int            table_count = 0;
+    t_int            all         = 0;
+    t_int            atom_count  = 0;
+    t_int            arg         = 1;
+    t_int            status      = 1;
+    t_int            n;
+
+    memset( &settings, 0, sizeof( settings ) );
+    settings.frames      = 1024;
+    settings.channels    = 1;
+    settings.overlap     = 1;
+    settings.sample_rate = 44100;
+    settings.blocks      = 2000;
+
+    // parse options
+    for( ; arg < argc && argv[ arg ][ 0 ] == '-' && argv[ arg ][ 1 ] ; ++arg )
+    {
+        char option = argv[ arg ][ 1 ];
+
+        if( option == 'a' ) { all = 1;            continue; }
+        if( option == 'x' ) { settings.alias = 1; continue; }
+        if( option == 's' ) { settings.silence = 1; continue; }
+        if( option == 'v' ) { stub_verbose = 1;   continue; }
+
+        if( arg + 1 >= argc )
+        {
+            bench_usage();
+            return 1;
+        }
+
+        switch( option )
+        {
+            case 'n' : settings.frames      = atol( argv[ ++arg ] ); break;
+            case 'm' : settings.channels    = atol( argv[ ++arg ] ); break;
+            case 'o' : settings.overlap     = atol( argv[ ++arg ] ); break;
+            case 'r' : settings.sample_rate = ( t_float )atof( argv[ ++arg ] ); break;
+            case 'b' : settings.blocks      = atol( argv[ ++arg ] ); break;
+            case 'w' : record               = argv[ ++arg ]; break;
+            case 'c' : compare              = argv[ ++arg ]; break;
+            case 'e' : messages             = argv[ ++arg ]; break;
+            case 't' : if( table_count < 16 ) tables[ table_count++ ] = argv[ ++arg ]; else ++arg; break;
+            default  : bench_usage(); return 1;
+        }
+    }
+
+    // golden runs use a small fixed block so the reference file stays compact
+    if( record )
+    {
+        settings.frames   = BENCH_GOLDEN_FRAMES;
+        settings.blocks   = BENCH_GOLDEN_BLOCKS;
+        settings.channels = 1;
+    }
+
+    if( ( !all && !record && !compare && arg >= argc ) || settings.frames < 4 || settings.frames & ( settings.frames - 1 ) || settings.channels < 1 || settings.overlap < 1 || settings.blocks < 1 + settings.silence * 2 * BENCH_TAIL_PARTS )
+    {
+        bench_usage();
+        return 1;
+    }
+
+    pd_spectral_toolkit_setup();
+
+    // create requested window / impulse arrays
+    for( n = 0 ; n < table_count ; ++n )
+    {
+        bench_window( tables[ n ], settings.frames );
+    }
+
+    if( record || compare )
+    {
+        settings.capture = 1;
+        settings.window  = 1;
+        settings.silence = 0;
+
+        if( compare )
+        {
+            status = bench_compare( compare, &settings );
+        }
+        else
+        {
+            bench_window( BENCH_WINDOW, settings.frames );
+            status = bench_record( record, &settings );
+        }
+
+        stub_garrayfree();
+
+        return !status;
+    }
+
+    // convert creation arguments to atoms
+    for( n = arg + 1 ; n < argc && atom_count < MAXPDARG * 4 ; ++n )
+    {
+        bench_atom( argv[ n ], &atoms[ atom_count++ ] );
+    }
+
+    printf( "%-16s %6s %4s %11s %11s %8s %9s %6s %6s %8s %8s",
+        "object", "frames", "olap", "ns/sample", "Msamples/s", "load %", "max us",
+        "dsp", "perf", "messages", "redraws" );
+
+    if( settings.silence )
+    {
+        printf( " %11s %7s", "tail ns/s", "tail x" );
+    }
+
+    printf( "\n" );
+
+    if( all )
+    {
+        settings.window = 1;
+        bench_window( BENCH_WINDOW, settings.frames );
+
+        for( n = 0 ; ( name = bench_objectname( n ) ) ; ++n )
+        {
+            if( bench_run( name, 0, 0, messages, &settings, &result ) )
+            {
+                bench_report( name, &settings, &result );
+            }
+        }
+    }
+    else
+    {
+        if( !bench_run( argv[ arg ], atom_count, atoms, messages, &settings, &result ) )
+        {
+            return 1;
+        }
+
+        bench_report( argv[ arg ], &settings, &result );
+    }
+
+    stub_garrayfree();
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+// EOF
+//------------------------------------------------------------------------------
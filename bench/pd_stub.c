@@ -0,0 +1,1149 @@
+//------------------------------------------------------------------------------
+//  Pd Spectral Toolkit
+//
+//  pd_stub.c
+//
+//  Headless stand-in for the parts of the pd runtime used by the toolkit
+//  ( class registry, inlets, outlets, dsp chain, binbufs, garrays, and mayer fft )
+//
+//  Copyright (C) 2019 Cooper Baker. All Rights Reserved.
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// headers
+//------------------------------------------------------------------------------
+
+// expose the real class_add* entry points instead of the casting macros
+#define PD_CLASS_DEF
+
+// harness interface to the stub runtime
+#include "pd_stub.h"
+
+// standard headers
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+
+//------------------------------------------------------------------------------
+// constant definitions
+//------------------------------------------------------------------------------
+#define STUB_MAX_METHODS   64
+#define STUB_MAX_CHAIN     4096
+#define STUB_HASH_SIZE     1024
+#define STUB_PI            3.14159265358979323846
+
+
+//------------------------------------------------------------------------------
+// stub_method - a selector and the function that responds to it
+//------------------------------------------------------------------------------
+typedef struct stub_method
+{
+    t_symbol*  selector;
+    t_method   function;
+    t_atomtype argtypes[ MAXPDARG + 1 ];
+
+} t_stub_method;
+
+
+//------------------------------------------------------------------------------
+// _class - pd's opaque class definition
+//------------------------------------------------------------------------------
+struct _class
+{
+    t_symbol*      name;
+    t_newmethod    newmethod;
+    t_method       freemethod;
+    size_t         size;
+    int            flags;
+    t_atomtype     argtypes[ MAXPDARG + 1 ];
+    t_int          mainsignalin;
+    t_stub_method  methods[ STUB_MAX_METHODS ];
+    t_int          method_count;
+    t_method       bang;
+    t_method       float_method;
+    t_method       list;
+    struct _class* next;
+};
+
+
+//------------------------------------------------------------------------------
+// _inlet, _outlet - per object connection points
+//------------------------------------------------------------------------------
+struct _inlet
+{
+    t_inlet* next;
+    t_int    is_signal;
+};
+
+struct _outlet
+{
+    t_outlet* next;
+    t_int     is_signal;
+};
+
+
+//------------------------------------------------------------------------------
+// _clock - a scheduler callback
+//------------------------------------------------------------------------------
+struct _clock
+{
+    void*          owner;
+    t_method       function;
+    double         time;
+    t_int          set;
+    struct _clock* next;
+};
+
+
+//------------------------------------------------------------------------------
+// _binbuf - a growable atom list
+//------------------------------------------------------------------------------
+struct _binbuf
+{
+    int     size;
+    int     capacity;
+    t_atom* vec;
+};
+
+
+//------------------------------------------------------------------------------
+// _garray - a named float array
+//------------------------------------------------------------------------------
+struct _garray
+{
+    t_symbol*       name;
+    t_word*         words;
+    int             size;
+    struct _garray* next;
+};
+
+
+//------------------------------------------------------------------------------
+// global variables
+//------------------------------------------------------------------------------
+t_stub_counters stub_counters;
+t_int           stub_verbose;
+
+static t_class   garray_stub_class;
+t_class*         garray_class = &garray_stub_class;
+
+static t_class*  class_list;
+static t_garray* garray_list;
+static t_symbol* symbol_hash[ STUB_HASH_SIZE ];
+
+static t_clock*  clock_list;
+static double    logical_time;
+
+static t_int     dsp_chain[ STUB_MAX_CHAIN ];
+static t_int     dsp_chain_size;
+
+static t_sample* fft_cos;
+static t_sample* fft_sin;
+static t_sample* fft_real;
+static t_sample* fft_imag;
+static int       fft_size;
+
+
+//------------------------------------------------------------------------------
+// symbols
+//------------------------------------------------------------------------------
+t_symbol* gensym( const char* s )
+{
+    unsigned int hash = 5381;
+    const char*  c;
+    t_symbol*    symbol;
+
+    for( c = s ; *c ; ++c )
+    {
+        hash = hash * 33 + ( unsigned char )*c;
+    }
+
+    hash %= STUB_HASH_SIZE;
+
+    for( symbol = symbol_hash[ hash ] ; symbol ; symbol = symbol->s_next )
+    {
+        if( !strcmp( symbol->s_name, s ) )
+        {
+            return symbol;
+        }
+    }
+
+    symbol            = ( t_symbol* )calloc( 1, sizeof( t_symbol ) );
+    symbol->s_name    = strdup( s );
+    symbol->s_next    = symbol_hash[ hash ];
+    symbol_hash[ hash ] = symbol;
+
+    return symbol;
+}
+
+
+//------------------------------------------------------------------------------
+// atoms
+//------------------------------------------------------------------------------
+t_float atom_getfloatarg( int which, int argc, const t_atom* argv )
+{
+    if( which < 0 || which >= argc || argv[ which ].a_type != A_FLOAT )
+    {
+        return 0;
+    }
+
+    return argv[ which ].a_w.w_float;
+}
+
+
+//------------------------------------------------------------------------------
+// binbufs
+//------------------------------------------------------------------------------
+t_binbuf* binbuf_new( void )
+{
+    return ( t_binbuf* )calloc( 1, sizeof( t_binbuf ) );
+}
+
+void binbuf_free( t_binbuf* x )
+{
+    free( x->vec );
+    free( x );
+}
+
+void binbuf_clear( t_binbuf* x )
+{
+    x->size = 0;
+}
+
+void binbuf_add( t_binbuf* x, int argc, const t_atom* argv )
+{
+    if( x->size + argc > x->capacity )
+    {
+        x->capacity = ( x->size + argc ) * 2;
+        x->vec      = ( t_atom* )realloc( x->vec, x->capacity * sizeof( t_atom ) );
+    }
+
+    memcpy( x->vec + x->size, argv, argc * sizeof( t_atom ) );
+
+    x->size += argc;
+}
+
+// splits on white space, turning words that read fully as numbers into floats
+void binbuf_text( t_binbuf* x, const char* text, size_t size )
+{
+    char   word[ 1000 ];
+    size_t position = 0;
+    size_t length;
+    char*  end;
+    t_atom atom;
+
+    binbuf_clear( x );
+
+    while( position < size )
+    {
+        while( position < size && ( text[ position ] == ' ' || text[ position ] == '\t' || text[ position ] == '\n' ) )
+        {
+            ++position;
+        }
+
+        for( length = 0 ; position < size && text[ position ] != ' ' && text[ position ] != '\t' && text[ position ] != '\n' ; ++position )
+        {
+            if( length < sizeof( word ) - 1 )
+            {
+                word[ length++ ] = text[ position ];
+            }
+        }
+
+        if( !length )
+        {
+            continue;
+        }
+
+        word[ length ] = 0;
+
+        atom.a_w.w_float = ( t_float )strtod( word, &end );
+
+        if( *end )
+        {
+            SETSYMBOL( &atom, gensym( word ) );
+        }
+        else
+        {
+            atom.a_type = A_FLOAT;
+        }
+
+        binbuf_add( x, 1, &atom );
+    }
+}
+
+int binbuf_getnatom( const t_binbuf* x )
+{
+    return x->size;
+}
+
+t_atom* binbuf_getvec( const t_binbuf* x )
+{
+    return x->vec;
+}
+
+
+//------------------------------------------------------------------------------
+// console
+//------------------------------------------------------------------------------
+void post( const char* fmt, ... )
+{
+    va_list args;
+
+    if( stub_verbose )
+    {
+        va_start( args, fmt );
+        vfprintf( stderr, fmt, args );
+        va_end( args );
+        fputc( '\n', stderr );
+    }
+}
+
+void poststring( const char* s )
+{
+    if( stub_verbose )
+    {
+        fprintf( stderr, " %s", s );
+    }
+}
+
+void pd_error( const void* object, const char* fmt, ... )
+{
+    va_list args;
+
+    ( void )object;
+
+    va_start( args, fmt );
+    fprintf( stderr, "error: " );
+    vfprintf( stderr, fmt, args );
+    fputc( '\n', stderr );
+    va_end( args );
+}
+
+
+//------------------------------------------------------------------------------
+// classes
+//------------------------------------------------------------------------------
+t_class* class_new( t_symbol* name, t_newmethod newmethod, t_method freemethod, size_t size, int flags, t_atomtype arg1, ... )
+{
+    t_class*   class = ( t_class* )calloc( 1, sizeof( t_class ) );
+    t_atomtype type  = arg1;
+    t_int      count = 0;
+    va_list    args;
+
+    class->name         = name;
+    class->newmethod    = newmethod;
+    class->freemethod   = freemethod;
+    class->size         = size;
+    class->flags        = flags;
+    class->mainsignalin = -1;
+
+    va_start( args, arg1 );
+    while( type != A_NULL && count < MAXPDARG )
+    {
+        class->argtypes[ count++ ] = type;
+        type = ( t_atomtype )va_arg( args, int );
+    }
+    va_end( args );
+
+    class->next = class_list;
+    class_list  = class;
+
+    return class;
+}
+
+void class_addmethod( t_class* c, t_method fn, t_symbol* sel, t_atomtype arg1, ... )
+{
+    t_stub_method* method;
+    t_atomtype     type  = arg1;
+    t_int          count = 0;
+    va_list        args;
+
+    if( c->method_count >= STUB_MAX_METHODS )
+    {
+        return;
+    }
+
+    method           = &c->methods[ c->method_count++ ];
+    method->selector = sel;
+    method->function = fn;
+
+    va_start( args, arg1 );
+    while( type != A_NULL && count < MAXPDARG )
+    {
+        method->argtypes[ count++ ] = type;
+        type = ( t_atomtype )va_arg( args, int );
+    }
+    va_end( args );
+}
+
+void class_addbang( t_class* c, t_method fn )
+{
+    c->bang = fn;
+}
+
+void class_doaddfloat( t_class* c, t_method fn )
+{
+    c->float_method = fn;
+}
+
+void class_addlist( t_class* c, t_method fn )
+{
+    c->list = fn;
+}
+
+void class_domainsignalin( t_class* c, int onset )
+{
+    c->mainsignalin = onset;
+}
+
+void class_sethelpsymbol( t_class* c, t_symbol* s )
+{
+    ( void )c;
+    ( void )s;
+}
+
+t_int stub_classcount( void )
+{
+    t_class* class;
+    t_int    count = 0;
+
+    for( class = class_list ; class ; class = class->next )
+    {
+        count += ( class->newmethod != 0 );
+    }
+
+    return count;
+}
+
+const char* stub_classname( t_int index )
+{
+    t_class* class;
+
+    for( class = class_list ; class ; class = class->next )
+    {
+        if( class->newmethod && index-- == 0 )
+        {
+            return class->name->s_name;
+        }
+    }
+
+    return 0;
+}
+
+
+//------------------------------------------------------------------------------
+// stub_call - calls a method with pd's typed argument convention
+//------------------------------------------------------------------------------
+typedef void* ( *t_stub_gimme )( void* object, t_symbol* s, t_int argc, t_atom* argv );
+typedef void* ( *t_stub_typed )( t_int a1, t_int a2, t_int a3, t_int a4, t_int a5, t_int a6,
+                                 t_floatarg f1, t_floatarg f2, t_floatarg f3, t_floatarg f4, t_floatarg f5 );
+
+static void* stub_call( t_method fn, void* object, t_symbol* s, t_atomtype* types, t_int argc, t_atom* argv )
+{
+    t_int      ints[ MAXPDARG + 1 ] = { 0 };
+    t_floatarg floats[ MAXPDARG ]   = { 0 };
+    t_int      int_count            = 0;
+    t_int      float_count          = 0;
+    t_int      arg                  = 0;
+    t_int      n;
+
+    if( types[ 0 ] == A_GIMME )
+    {
+        if( object )
+        {
+            return ( ( t_stub_gimme )fn )( object, s, argc, argv );
+        }
+
+        return ( ( void* ( * )( t_symbol*, t_int, t_atom* ) )fn )( s, argc, argv );
+    }
+
+    if( object )
+    {
+        ints[ int_count++ ] = ( t_int )object;
+    }
+
+    for( n = 0 ; n < MAXPDARG && types[ n ] != A_NULL ; ++n, ++arg )
+    {
+        switch( types[ n ] )
+        {
+            case A_FLOAT    :
+            case A_DEFFLOAT :
+                floats[ float_count++ ] = ( arg < argc && argv[ arg ].a_type == A_FLOAT ) ? argv[ arg ].a_w.w_float : 0;
+                break;
+
+            case A_SYMBOL   :
+            case A_DEFSYM   :
+                ints[ int_count++ ] = ( t_int )( ( arg < argc && argv[ arg ].a_type == A_SYMBOL ) ? argv[ arg ].a_w.w_symbol : gensym( "" ) );
+                break;
+
+            default :
+                break;
+        }
+    }
+
+    return ( ( t_stub_typed )fn )( ints[ 0 ], ints[ 1 ], ints[ 2 ], ints[ 3 ], ints[ 4 ], ints[ 5 ],
+                                   floats[ 0 ], floats[ 1 ], floats[ 2 ], floats[ 3 ], floats[ 4 ] );
+}
+
+
+//------------------------------------------------------------------------------
+// objects
+//------------------------------------------------------------------------------
+t_pd* pd_new( t_class* c )
+{
+    t_pd* object = ( t_pd* )calloc( 1, c->size );
+
+    *object = c;
+
+    return object;
+}
+
+t_pd* stub_newobject( const char* name, t_int argc, t_atom* argv )
+{
+    t_symbol* symbol = gensym( name );
+    t_class*  class;
+
+    for( class = class_list ; class ; class = class->next )
+    {
+        if( class->name == symbol && class->newmethod )
+        {
+            return ( t_pd* )stub_call( ( t_method )class->newmethod, 0, symbol, class->argtypes, argc, argv );
+        }
+    }
+
+    return 0;
+}
+
+void stub_freeobject( t_pd* object )
+{
+    t_object* owner = ( t_object* )object;
+    t_inlet*  inlet;
+    t_outlet* outlet;
+
+    if( ( *object )->freemethod )
+    {
+        ( ( void ( * )( void* ) )( *object )->freemethod )( object );
+    }
+
+    while( ( inlet = owner->te_inlet ) )
+    {
+        owner->te_inlet = inlet->next;
+        free( inlet );
+    }
+
+    while( ( outlet = owner->te_outlet ) )
+    {
+        owner->te_outlet = outlet->next;
+        free( outlet );
+    }
+
+    free( object );
+}
+
+static t_stub_method* stub_findmethod( t_pd* object, const char* selector )
+{
+    t_symbol* symbol = gensym( selector );
+    t_int     n;
+
+    for( n = 0 ; n < ( *object )->method_count ; ++n )
+    {
+        if( ( *object )->methods[ n ].selector == symbol )
+        {
+            return &( *object )->methods[ n ];
+        }
+    }
+
+    return 0;
+}
+
+t_int stub_hasmethod( t_pd* object, const char* selector )
+{
+    return stub_findmethod( object, selector ) != 0;
+}
+
+t_atomtype stub_methodarg( t_pd* object, const char* selector, t_int index )
+{
+    t_stub_method* method = stub_findmethod( object, selector );
+
+    if( !method || index < 0 || index >= MAXPDARG )
+    {
+        return A_NULL;
+    }
+
+    return method->argtypes[ index ];
+}
+
+t_int stub_message( t_pd* object, const char* selector, t_int argc, t_atom* argv )
+{
+    t_stub_method* method = stub_findmethod( object, selector );
+
+    if( !method )
+    {
+        if( !strcmp( selector, "float" ) && ( *object )->float_method )
+        {
+            ( ( void ( * )( void*, t_floatarg ) )( *object )->float_method )( object, atom_getfloatarg( 0, ( int )argc, argv ) );
+            return 1;
+        }
+
+        if( !strcmp( selector, "bang" ) && ( *object )->bang )
+        {
+            ( ( void ( * )( void* ) )( *object )->bang )( object );
+            return 1;
+        }
+
+        // any other selector goes to an "anything" method, as in pd
+        method = stub_findmethod( object, "anything" );
+
+        if( method )
+        {
+            stub_call( method->function, object, gensym( selector ), method->argtypes, argc, argv );
+            return 1;
+        }
+
+        return 0;
+    }
+
+    stub_call( method->function, object, method->selector, method->argtypes, argc, argv );
+
+    return 1;
+}
+
+
+//------------------------------------------------------------------------------
+// inlets and outlets
+//------------------------------------------------------------------------------
+static void* stub_append( t_object* owner, t_int is_signal, t_int outlet )
+{
+    if( outlet )
+    {
+        t_outlet*  new_outlet = ( t_outlet* )calloc( 1, sizeof( t_outlet ) );
+        t_outlet** tail       = &owner->te_outlet;
+
+        new_outlet->is_signal = is_signal;
+        while( *tail ) tail = &( *tail )->next;
+        *tail = new_outlet;
+
+        return new_outlet;
+    }
+    else
+    {
+        t_inlet*  new_inlet = ( t_inlet* )calloc( 1, sizeof( t_inlet ) );
+        t_inlet** tail      = &owner->te_inlet;
+
+        new_inlet->is_signal = is_signal;
+        while( *tail ) tail = &( *tail )->next;
+        *tail = new_inlet;
+
+        return new_inlet;
+    }
+}
+
+t_inlet* inlet_new( t_object* owner, t_pd* dest, t_symbol* s1, t_symbol* s2 )
+{
+    ( void )dest;
+    ( void )s2;
+
+    return ( t_inlet* )stub_append( owner, s1 == gensym( "signal" ), 0 );
+}
+
+t_inlet* floatinlet_new( t_object* owner, t_float* fp )
+{
+    ( void )fp;
+
+    return ( t_inlet* )stub_append( owner, 0, 0 );
+}
+
+t_inlet* signalinlet_new( t_object* owner, t_float f )
+{
+    ( void )f;
+
+    return ( t_inlet* )stub_append( owner, 1, 0 );
+}
+
+t_outlet* outlet_new( t_object* owner, t_symbol* s )
+{
+    return ( t_outlet* )stub_append( owner, s == gensym( "signal" ), 1 );
+}
+
+void outlet_bang( t_outlet* x )
+{
+    ( void )x;
+    ++stub_counters.messages;
+}
+
+void outlet_float( t_outlet* x, t_float f )
+{
+    ( void )x;
+    ( void )f;
+    ++stub_counters.messages;
+}
+
+void outlet_symbol( t_outlet* x, t_symbol* s )
+{
+    ( void )x;
+    ( void )s;
+    ++stub_counters.messages;
+}
+
+void outlet_list( t_outlet* x, t_symbol* s, int argc, t_atom* argv )
+{
+    ( void )x;
+    ( void )s;
+    ( void )argc;
+    ( void )argv;
+    ++stub_counters.messages;
+}
+
+void outlet_anything( t_outlet* x, t_symbol* s, int argc, t_atom* argv )
+{
+    ( void )x;
+    ( void )s;
+    ( void )argc;
+    ( void )argv;
+    ++stub_counters.messages;
+}
+
+t_int stub_signalinlets( t_pd* object )
+{
+    t_inlet* inlet;
+    t_int    count = ( ( *object )->mainsignalin >= 0 );
+
+    for( inlet = ( ( t_object* )object )->te_inlet ; inlet ; inlet = inlet->next )
+    {
+        count += inlet->is_signal;
+    }
+
+    return count;
+}
+
+t_int stub_signaloutlets( t_pd* object )
+{
+    t_outlet* outlet;
+    t_int     count = 0;
+
+    for( outlet = ( ( t_object* )object )->te_outlet ; outlet ; outlet = outlet->next )
+    {
+        count += outlet->is_signal;
+    }
+
+    return count;
+}
+
+t_int stub_multichannel( t_pd* object )
+{
+#ifdef CLASS_MULTICHANNEL
+    return ( ( *object )->flags & CLASS_MULTICHANNEL ) != 0;
+#else
+    ( void )object;
+
+    return 0;
+#endif
+}
+
+
+//------------------------------------------------------------------------------
+// dsp chain
+//------------------------------------------------------------------------------
+static t_int* stub_dspdone( t_int* io )
+{
+    ( void )io;
+
+    return 0;
+}
+
+void dsp_add( t_perfroutine f, int n, ... )
+{
+    va_list args;
+    t_int   i;
+
+    if( dsp_chain_size + n + 2 >= STUB_MAX_CHAIN )
+    {
+        fprintf( stderr, "error: dsp chain overflow\n" );
+        exit( 1 );
+    }
+
+    dsp_chain[ dsp_chain_size++ ] = ( t_int )f;
+
+    va_start( args, n );
+    for( i = 0 ; i < n ; ++i )
+    {
+        dsp_chain[ dsp_chain_size++ ] = va_arg( args, t_int );
+    }
+    va_end( args );
+
+    dsp_chain[ dsp_chain_size ] = ( t_int )stub_dspdone;
+}
+
+t_int stub_dsp( t_pd* object, t_signal** sig )
+{
+    t_stub_method* method = stub_findmethod( object, "dsp" );
+
+    if( !method )
+    {
+        return 0;
+    }
+
+    ( ( void ( * )( void*, t_signal** ) )method->function )( object, sig );
+
+    return 1;
+}
+
+#ifdef CLASS_MULTICHANNEL
+// the harness allocates every vector with room for its channel count, so only
+// the count changes here ( pd itself would assign a fresh vector )
+void signal_setmultiout( t_signal** sig, int nchans )
+{
+    if( ( *sig )->s_n * nchans > ( *sig )->s_vecsize )
+    {
+        fprintf( stderr, "error: signal_setmultiout: %d channels do not fit\n", nchans );
+        exit( 1 );
+    }
+
+    ( *sig )->s_nchans = nchans;
+}
+#endif
+
+void stub_dsptick( void )
+{
+    t_int* io = dsp_chain;
+
+    if( !dsp_chain_size )
+    {
+        return;
+    }
+
+    while( io )
+    {
+        io = ( *( t_perfroutine )( *io ) )( io );
+    }
+}
+
+void stub_dspclear( void )
+{
+    dsp_chain_size = 0;
+    dsp_chain[ 0 ] = ( t_int )stub_dspdone;
+}
+
+
+//------------------------------------------------------------------------------
+// clocks
+//------------------------------------------------------------------------------
+t_clock* clock_new( void* owner, t_method fn )
+{
+    t_clock* clock = ( t_clock* )calloc( 1, sizeof( t_clock ) );
+
+    clock->owner    = owner;
+    clock->function = fn;
+    clock->next     = clock_list;
+    clock_list      = clock;
+
+    return clock;
+}
+
+void clock_delay( t_clock* x, double delaytime )
+{
+    x->time = logical_time + ( delaytime > 0 ? delaytime : 0 );
+    x->set  = 1;
+}
+
+void clock_unset( t_clock* x )
+{
+    x->set = 0;
+}
+
+void clock_free( t_clock* x )
+{
+    t_clock** link;
+
+    for( link = &clock_list ; *link ; link = &( *link )->next )
+    {
+        if( *link == x )
+        {
+            *link = x->next;
+            break;
+        }
+    }
+
+    free( x );
+}
+
+void stub_advance( double milliseconds )
+{
+    t_clock* clock;
+    t_int    fired = 1;
+
+    logical_time += milliseconds;
+
+    // fire due clocks until none remain, as callbacks may set clocks again
+    while( fired )
+    {
+        fired = 0;
+
+        for( clock = clock_list ; clock ; clock = clock->next )
+        {
+            if( clock->set && clock->time <= logical_time )
+            {
+                clock->set = 0;
+                ( ( void ( * )( void* ) )clock->function )( clock->owner );
+                fired = 1;
+                break;
+            }
+        }
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// arrays
+//------------------------------------------------------------------------------
+t_pd* pd_findbyclass( t_symbol* s, const t_class* c )
+{
+    t_garray* array;
+
+    if( c != garray_class )
+    {
+        return 0;
+    }
+
+    for( array = garray_list ; array ; array = array->next )
+    {
+        if( array->name == s )
+        {
+            return ( t_pd* )array;
+        }
+    }
+
+    return 0;
+}
+
+int garray_getfloatwords( t_garray* x, int* size, t_word** vec )
+{
+    *size = x->size;
+    *vec  = x->words;
+
+    return 1;
+}
+
+void garray_redraw( t_garray* x )
+{
+    ( void )x;
+    ++stub_counters.redraws;
+}
+
+void garray_usedindsp( t_garray* x )
+{
+    ( void )x;
+}
+
+void garray_resize_long( t_garray* x, long n )
+{
+    x->words = ( t_word* )realloc( x->words, n * sizeof( t_word ) );
+
+    if( n > x->size )
+    {
+        memset( x->words + x->size, 0, ( n - x->size ) * sizeof( t_word ) );
+    }
+
+    x->size = ( int )n;
+}
+
+t_garray* stub_garraynew( const char* name, t_int size )
+{
+    t_garray* array = ( t_garray* )calloc( 1, sizeof( t_garray ) );
+
+    array->name  = gensym( name );
+    array->size  = ( int )size;
+    array->words = ( t_word* )calloc( size, sizeof( t_word ) );
+    array->next  = garray_list;
+    garray_list  = array;
+
+    return array;
+}
+
+t_word* stub_garraywords( t_garray* array )
+{
+    return array->words;
+}
+
+void stub_garrayfree( void )
+{
+    t_garray* array;
+
+    while( ( array = garray_list ) )
+    {
+        garray_list = array->next;
+        free( array->words );
+        free( array );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// canvases and file names - objects are created outside any canvas, so file
+// names resolve relative to the working directory
+//------------------------------------------------------------------------------
+t_glist* canvas_getcurrent( void )
+{
+    return 0;
+}
+
+void canvas_makefilename( const t_glist* c, const char* file, char* result, int resultsize )
+{
+    ( void )c;
+    strncpy( result, file, resultsize );
+    result[ resultsize - 1 ] = 0;
+}
+
+void sys_bashfilename( const char* from, char* to )
+{
+    if( from != to )
+    {
+        strcpy( to, from );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// stub_fftsize - resizes the twiddle and work tables for an n point fft
+//------------------------------------------------------------------------------
+static void stub_fftsize( int n )
+{
+    int i;
+
+    if( n != fft_size )
+    {
+        fft_cos  = ( t_sample* )realloc( fft_cos,  sizeof( t_sample ) * n );
+        fft_sin  = ( t_sample* )realloc( fft_sin,  sizeof( t_sample ) * n );
+        fft_real = ( t_sample* )realloc( fft_real, sizeof( t_sample ) * n );
+        fft_imag = ( t_sample* )realloc( fft_imag, sizeof( t_sample ) * n );
+
+        for( i = 0 ; i < n ; ++i )
+        {
+            fft_cos[ i ] = ( t_sample )cos( 2.0 * STUB_PI * i / n );
+            fft_sin[ i ] = ( t_sample )sin( 2.0 * STUB_PI * i / n );
+        }
+
+        fft_size = n;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// stub_fft - in-place radix 2 complex fft ( sign -1 forward, +1 inverse )
+//------------------------------------------------------------------------------
+static void stub_fft( int n, t_sample* real, t_sample* imag, int sign )
+{
+    int      i;
+    int      j;
+    int      k;
+    int      span;
+    int      step;
+    t_sample temp;
+
+    // bit reversal permutation
+    for( i = 1, j = 0 ; i < n ; ++i )
+    {
+        for( k = n >> 1 ; j & k ; k >>= 1 )
+        {
+            j ^= k;
+        }
+        j |= k;
+
+        if( i < j )
+        {
+            temp = real[ i ]; real[ i ] = real[ j ]; real[ j ] = temp;
+            temp = imag[ i ]; imag[ i ] = imag[ j ]; imag[ j ] = temp;
+        }
+    }
+
+    // butterflies
+    for( span = 1 ; span < n ; span <<= 1 )
+    {
+        step = n / ( span << 1 );
+
+        for( i = 0 ; i < n ; i += span << 1 )
+        {
+            for( j = 0 ; j < span ; ++j )
+            {
+                t_sample wr = fft_cos[ j * step ];
+                t_sample wi = fft_sin[ j * step ] * sign;
+                t_sample xr = real[ i + j + span ] * wr - imag[ i + j + span ] * wi;
+                t_sample xi = real[ i + j + span ] * wi + imag[ i + j + span ] * wr;
+
+                real[ i + j + span ] = real[ i + j ] - xr;
+                imag[ i + j + span ] = imag[ i + j ] - xi;
+                real[ i + j ]       += xr;
+                imag[ i + j ]       += xi;
+            }
+        }
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// mayer_realfft - real fft in pd's packed layout
+// ( real parts in 0 to n/2, negated imaginary parts mirrored from n - 1 down )
+//------------------------------------------------------------------------------
+void mayer_realfft( int n, t_sample* real )
+{
+    int k;
+
+    stub_fftsize( n );
+
+    for( k = 0 ; k < n ; ++k )
+    {
+        fft_real[ k ] = real[ k ];
+        fft_imag[ k ] = 0;
+    }
+
+    stub_fft( n, fft_real, fft_imag, -1 );
+
+    real[ 0 ] = fft_real[ 0 ];
+
+    for( k = 1 ; k < n / 2 ; ++k )
+    {
+        real[ k ]     =  fft_real[ k ];
+        real[ n - k ] = -fft_imag[ k ];
+    }
+
+    real[ n / 2 ] = fft_real[ n / 2 ];
+}
+
+
+//------------------------------------------------------------------------------
+// mayer_realifft - unnormalized inverse of mayer_realfft
+//------------------------------------------------------------------------------
+void mayer_realifft( int n, t_sample* real )
+{
+    int k;
+
+    stub_fftsize( n );
+
+    fft_real[ 0 ]     = real[ 0 ];
+    fft_imag[ 0 ]     = 0;
+    fft_real[ n / 2 ] = real[ n / 2 ];
+    fft_imag[ n / 2 ] = 0;
+
+    for( k = 1 ; k < n / 2 ; ++k )
+    {
+        fft_real[ k ]     =  real[ k ];
+        fft_imag[ k ]     = -real[ n - k ];
+        fft_real[ n - k ] =  real[ k ];
+        fft_imag[ n - k ] =  real[ n - k ];
+    }
+
+    stub_fft( n, fft_real, fft_imag, 1 );
+
+    for( k = 0 ; k < n ; ++k )
+    {
+        real[ k ] = fft_real[ k ];
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// EOF
+//------------------------------------------------------------------------------
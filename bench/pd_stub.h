@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------------
+//  Pd Spectral Toolkit
+//
+//  pd_stub.h
+//
+//  Headless stand-in for the parts of the pd runtime used by the toolkit
+//
+//  Copyright (C) 2019 Cooper Baker. All Rights Reserved.
+//------------------------------------------------------------------------------
+
+#ifndef PD_STUB_H
+#define PD_STUB_H
+
+
+//------------------------------------------------------------------------------
+// headers
+//------------------------------------------------------------------------------
+
+// main header for pd
+#include "m_pd.h"
+
+
+//------------------------------------------------------------------------------
+// counters - runtime activity observed by the stub
+//------------------------------------------------------------------------------
+typedef struct stub_counters
+{
+    // messages sent from any control outlet
+    t_int messages;
+
+    // garray_redraw calls
+    t_int redraws;
+
+    // heap allocations and releases ( counted when linked with --wrap )
+    t_int allocs;
+    t_int frees;
+
+} t_stub_counters;
+
+extern t_stub_counters stub_counters;
+
+// nonzero to echo post() output to stderr
+extern t_int stub_verbose;
+
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+
+// class registry
+t_int       stub_classcount     ( void );
+const char* stub_classname      ( t_int index );
+
+// object lifetime and messaging
+t_pd*       stub_newobject      ( const char* name, t_int argc, t_atom* argv );
+void        stub_freeobject     ( t_pd* object );
+t_int       stub_hasmethod      ( t_pd* object, const char* selector );
+t_atomtype  stub_methodarg      ( t_pd* object, const char* selector, t_int index );
+t_int       stub_message        ( t_pd* object, const char* selector, t_int argc, t_atom* argv );
+t_int       stub_signalinlets   ( t_pd* object );
+t_int       stub_signaloutlets  ( t_pd* object );
+t_int       stub_multichannel   ( t_pd* object );
+
+// dsp chain
+t_int       stub_dsp            ( t_pd* object, t_signal** sig );
+void        stub_dsptick        ( void );
+void        stub_dspclear       ( void );
+
+// scheduler
+void        stub_advance        ( double milliseconds );
+
+// arrays
+t_garray*   stub_garraynew      ( const char* name, t_int size );
+t_word*     stub_garraywords    ( t_garray* array );
+void        stub_garrayfree     ( void );
+
+
+#endif
+
+
+//------------------------------------------------------------------------------
+// EOF
+//------------------------------------------------------------------------------
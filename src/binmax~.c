@@ -48,6 +48,9 @@ typedef struct binmax
     // needed for signalinlet_new call in binmax_new
     t_float inlet_2;
 
+    // the outlet values mirrored on a control outlet
+    t_control control;
+
 } t_binmax;
 
 
@@ -57,6 +60,7 @@ typedef struct binmax
 static t_int* binmax_perform     ( t_int* io );
 static void   binmax_dsp         ( t_binmax* object, t_signal **sig );
 static void*  binmax_new         ( void );
+static void   binmax_free        ( t_binmax* object );
 void          binmax_tilde_setup ( void );
 
 
@@ -66,23 +70,27 @@ void          binmax_tilde_setup ( void );
 static t_int* binmax_perform( t_int* io )
 {
     // store variables from dsp input/output array
-    t_float* in1    = ( t_float* )( io[ 1 ] );
-    t_float* in2    = ( t_float* )( io[ 2 ] );
-    t_float* out1   = ( t_float* )( io[ 3 ] );
-    t_float* out2   = ( t_float* )( io[ 4 ] );
-    t_float* out3   = ( t_float* )( io[ 5 ] );
-    t_int    frames = ( t_int    )( io[ 6 ] );
+    t_float*  in1    = ( t_float*  )( io[ 1 ] );
+    t_float*  in2    = ( t_float*  )( io[ 2 ] );
+    t_float*  out1   = ( t_float*  )( io[ 3 ] );
+    t_float*  out2   = ( t_float*  )( io[ 4 ] );
+    t_float*  out3   = ( t_float*  )( io[ 5 ] );
+    t_int     frames = ( t_int     )( io[ 6 ] );
+    t_binmax* object = ( t_binmax* )( io[ 7 ] );
 
     // signal vector iterator variable
     t_int n = -1;
 
     // temp sample variables
     t_float value;
-    t_float in_2;
+    t_float in_2 = 0;
+
+    // values for the control outlet
+    t_float control[ 3 ];
 
     // max and index memory
     t_float max = -C_FLOAT_MAX;
-    t_float index;
+    t_float index = 0;
 
     // loop through vector looking for max value
     while( ++n < frames )
@@ -98,20 +106,21 @@ static t_int* binmax_perform( t_int* io )
         }
     }
 
-    // reset vector iterator
-    n = -1;
-
     // fill output vectors with max and associated values
-    while( ++n < frames )
-    {
-        out1[ n ] = max;
-        out2[ n ] = in_2;
-        out3[ n ] = index;
-    }
+    FillVector( out1, max,   frames );
+    FillVector( out2, in_2,  frames );
+    FillVector( out3, index, frames );
+
+    // send the values out the control outlet when they change
+    control[ 0 ] = max;
+    control[ 1 ] = in_2;
+    control[ 2 ] = index;
+
+    ControlSet( &object->control, control );
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
-    return &( io[ 7 ] );
+    return &( io[ 8 ] );
 }
 
 
@@ -130,7 +139,8 @@ static void binmax_dsp( t_binmax* object, t_signal **sig )
     // outlet 2 sample vector
     // outlet 3 sample vector
     // sample frames to process (vector size)
-    dsp_add( binmax_perform, 6, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 4 ]->s_vec, sig[ 0 ]->s_n );
+    // pointer to this object's data structure
+    dsp_add( binmax_perform, 7, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 4 ]->s_vec, sig[ 0 ]->s_n, object );
 }
 
 
@@ -150,10 +160,22 @@ static void* binmax_new( void )
     outlet_new( &object->object, gensym( "signal" ) );
     outlet_new( &object->object, gensym( "signal" ) );
 
+    // create a control outlet for the maximum, associated value, and index
+    ControlNew( &object->control, &object->object, 3 );
+
     return object;
 }
 
 
+//------------------------------------------------------------------------------
+// binmax_free - frees this object's clock
+//------------------------------------------------------------------------------
+static void binmax_free( t_binmax* object )
+{
+    ControlFree( &object->control );
+}
+
+
 //------------------------------------------------------------------------------
 // binmax_tilde_setup - describes the attributes of this object to pd so it may be properly instantiated
 // (must always be named with _tilde replacing ~ in the object name)
@@ -161,7 +183,7 @@ static void* binmax_new( void )
 void binmax_tilde_setup( void )
 {
     // creates an instance of this object and describes it to pd
-    binmax_class = class_new( gensym( "binmax~" ), ( t_newmethod )binmax_new, 0, sizeof( t_binmax ), 0, 0, 0 );
+    binmax_class = class_new( gensym( "binmax~" ), ( t_newmethod )binmax_new, ( t_method )binmax_free, sizeof( t_binmax ), 0, 0, 0 );
 
     // declares leftmost inlet as a signal inlet
     CLASS_MAINSIGNALIN( binmax_class, t_binmax, inlet_1 );
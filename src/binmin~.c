@@ -45,9 +45,12 @@ typedef struct binmin
     // needed for CLASS_MAINSIGNALIN macro call in binmin_tilde_setup
     t_float inlet_1;
 
-    // needed for signalinlet_new call in binmax_new
+    // needed for signalinlet_new call in binmin_new
     t_float inlet_2;
 
+    // the outlet values mirrored on a control outlet
+    t_control control;
+
 } t_binmin;
 
 
@@ -57,6 +60,7 @@ typedef struct binmin
 static t_int* binmin_perform     ( t_int* io );
 static void   binmin_dsp         ( t_binmin* object, t_signal **sig );
 static void*  binmin_new         ( void );
+static void   binmin_free        ( t_binmin* object );
 void          binmin_tilde_setup ( void );
 
 
@@ -66,20 +70,24 @@ void          binmin_tilde_setup ( void );
 static t_int* binmin_perform( t_int* io )
 {
     // store variables from dsp input/output array
-    t_float* in1    = ( t_float* )( io[ 1 ] );
-    t_float* in2    = ( t_float* )( io[ 2 ] );
-    t_float* out1   = ( t_float* )( io[ 3 ] );
-    t_float* out2   = ( t_float* )( io[ 4 ] );
-    t_float* out3   = ( t_float* )( io[ 5 ] );
-    t_int    frames = ( t_int    )( io[ 6 ] );
+    t_float*  in1    = ( t_float*  )( io[ 1 ] );
+    t_float*  in2    = ( t_float*  )( io[ 2 ] );
+    t_float*  out1   = ( t_float*  )( io[ 3 ] );
+    t_float*  out2   = ( t_float*  )( io[ 4 ] );
+    t_float*  out3   = ( t_float*  )( io[ 5 ] );
+    t_int     frames = ( t_int     )( io[ 6 ] );
+    t_binmin* object = ( t_binmin* )( io[ 7 ] );
 
     // temp sample variables
     t_float value;
-    t_float in_2;
+    t_float in_2 = 0;
+
+    // values for the control outlet
+    t_float control[ 3 ];
 
     // min and index memory
     t_float min = C_FLOAT_MAX;
-    t_float index;
+    t_float index = 0;
 
     // signal vector iterator variable
     t_int n = -1;
@@ -97,20 +105,21 @@ static t_int* binmin_perform( t_int* io )
         }
     }
 
-    // reset vector iterator
-    n = -1;
+    // fill output vectors with min and index values
+    FillVector( out1, min,   frames );
+    FillVector( out2, in_2,  frames );
+    FillVector( out3, index, frames );
 
-    // fill output vectors with max and index values
-    while( ++n < frames )
-    {
-        out1[ n ] = min;
-        out2[ n ] = in_2;
-        out3[ n ] = index;
-    }
+    // send the values out the control outlet when they change
+    control[ 0 ] = min;
+    control[ 1 ] = in_2;
+    control[ 2 ] = index;
+
+    ControlSet( &object->control, control );
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
-    return &( io[ 7 ] );
+    return &( io[ 8 ] );
 }
 
 
@@ -129,7 +138,8 @@ static void binmin_dsp( t_binmin* object, t_signal **sig )
     // outlet 2 sample vector
     // outlet 3 sample vector
     // sample frames to process (vector size)
-    dsp_add( binmin_perform, 6, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 4 ]->s_vec, sig[ 0 ]->s_n );
+    // pointer to this object's data structure
+    dsp_add( binmin_perform, 7, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 4 ]->s_vec, sig[ 0 ]->s_n, object );
 }
 
 
@@ -149,10 +159,22 @@ static void* binmin_new( void )
     outlet_new( &object->object, gensym( "signal" ) );
     outlet_new( &object->object, gensym( "signal" ) );
 
+    // create a control outlet for the minimum, associated value, and index
+    ControlNew( &object->control, &object->object, 3 );
+
     return object;
 }
 
 
+//------------------------------------------------------------------------------
+// binmin_free - frees this object's clock
+//------------------------------------------------------------------------------
+static void binmin_free( t_binmin* object )
+{
+    ControlFree( &object->control );
+}
+
+
 //------------------------------------------------------------------------------
 // binmin_tilde_setup - describes the attributes of this object to pd so it may be properly instantiated
 // (must always be named with _tilde replacing ~ in the object name)
@@ -160,7 +182,7 @@ static void* binmin_new( void )
 void binmin_tilde_setup( void )
 {
     // creates an instance of this object and describes it to pd
-    binmin_class = class_new( gensym( "binmin~" ), ( t_newmethod )binmin_new, 0, sizeof( t_binmin ), 0, 0, 0 );
+    binmin_class = class_new( gensym( "binmin~" ), ( t_newmethod )binmin_new, ( t_method )binmin_free, sizeof( t_binmin ), 0, 0, 0 );
 
     // declares leftmost inlet as a signal inlet
     CLASS_MAINSIGNALIN( binmin_class, t_binmin, inlet_1 );
@@ -67,6 +67,12 @@ typedef struct binmix
     // vector memory size
     t_float memory_size;
 
+    // signal vector size of the last dsp call
+    t_int frames;
+
+    // dsp timing record read by spectprof ( empty unless profiling is compiled in )
+    PROFILE_MEMBER
+
 } t_binmix;
 
 
@@ -316,29 +322,39 @@ static void binmix_dsp( t_binmix* object, t_signal **sig )
     // temporary frame size variable
     t_int frames = sig[ 0 ]->s_n;
 
-    // calculate memory size for realloc and memset
-    t_float memory_size = frames * sizeof( t_float );
-
-    // allocate one frame's worth of memory to each pointer ( a and c need an extra location )
-    object->a            = realloc( object->a,            memory_size + sizeof( t_float ) );
-    object->b            = realloc( object->b,            memory_size );
-    object->c            = realloc( object->c,            memory_size + sizeof( t_float ) );
-    object->a_temp       = realloc( object->a_temp,       memory_size );
-    object->b_temp       = realloc( object->b_temp,       memory_size );
-    object->vector_index = realloc( object->vector_index, memory_size );
+    // only reallocate memory when the vector size has changed
+    if( frames != object->frames )
+    {
+        // calculate memory size for realloc and memset
+        t_float memory_size = frames * sizeof( t_float );
+
+        // allocate one frame's worth of memory to each pointer ( a and c need an extra location )
+        object->a            = realloc( object->a,            memory_size + sizeof( t_float ) );
+        object->b            = realloc( object->b,            memory_size );
+        object->c            = realloc( object->c,            memory_size + sizeof( t_float ) );
+        object->a_temp       = realloc( object->a_temp,       memory_size );
+        object->b_temp       = realloc( object->b_temp,       memory_size );
+        object->vector_index = realloc( object->vector_index, memory_size );
+
+        // init extra sorting location
+        object->a           [ frames ] = C_FLOAT_MIN;
+        object->c           [ frames ] = 0;
+
+        // increment values stored in vector_index
+        for( t_int index = 0 ; index < frames ; ++index )
+        {
+            object->vector_index[ index ] = ( t_float )index;
+        }
 
-    // init extra sorting location
-    object->a           [ frames ] = C_FLOAT_MIN;
-    object->c           [ frames ] = 0;
+        // save memory size
+        object->memory_size = memory_size;
 
-    // increment values stored in vector_index
-    for( t_int index = 0 ; index < frames ; ++index )
-    {
-        object->vector_index[ index ] = ( t_float )index;
+        // save frame size
+        object->frames = frames;
     }
 
-    // save memory size
-    object->memory_size = memory_size;
+    // start timing this object ( when profiling is compiled in )
+    PROFILE_DSP_BEGIN( object );
 
     // dsp_add arguments
     //--------------------------------------------------------------------------
@@ -361,6 +377,9 @@ static void binmix_dsp( t_binmix* object, t_signal **sig )
         frames,
         object
     );
+
+    // stop timing this object
+    PROFILE_DSP_END( object );
 }
 
 
@@ -372,6 +391,9 @@ static void* binmix_new( t_symbol *s, t_int argc, t_atom *argv )
     // create a pointer to this object
     t_binmix* object = ( t_binmix* )pd_new( binmix_class );
 
+    // register with the dsp profiler
+    PROFILE_REGISTER( object, "binmix~" );
+
     // create an additional signal inlet
     signalinlet_new( &object->object, object->inlet_2 );
 
@@ -391,6 +413,9 @@ static void* binmix_new( t_symbol *s, t_int argc, t_atom *argv )
     object->b_temp       = NULL;
     object->vector_index = NULL;
 
+    // initialize frame size
+    object->frames = 0;
+
     return object;
 }
 
@@ -400,6 +425,9 @@ static void* binmix_new( t_symbol *s, t_int argc, t_atom *argv )
 //------------------------------------------------------------------------------
 static void binmix_free( t_binmix* object )
 {
+    // unregister from the dsp profiler
+    PROFILE_UNREGISTER( object );
+
     // if memory is allocated
     if( object->a )
     {
@@ -3,7 +3,8 @@
 //
 //  binmonitor~.c
 //
-//  Samples a signal vector index once and outputs a float once per block
+//  Samples a signal vector index once per block and outputs it as a float
+//  from the scheduler, every block or at a set rate
 //
 //  Created by Cooper Baker on 7/16/12.
 //  Updated for 64 Bit Support in September 2019.
@@ -53,6 +54,25 @@ typedef struct binmonitor
     // variables for keeping track of signal values
     t_float bin_value;
 
+    // bin values queued by the perform routine for output by the clock
+    t_ring queue;
+
+    // newest value while an interval is set - only the newest is output then,
+    // so values arriving faster than the clock drains cannot go stale
+    t_float latest;
+
+    // TRUE while latest holds a value not yet output
+    t_int latest_fresh;
+
+    // clock that drains the queue on the scheduler side
+    t_clock* clock;
+
+    // TRUE while the clock is waiting to fire
+    t_int clock_pending;
+
+    // milliseconds between outputs ( 0 outputs every queued value )
+    t_float interval;
+
     // pointer to the outlet
     t_outlet* outlet_1;
 
@@ -66,13 +86,17 @@ static t_int* binmonitor_perform     ( t_int* io );
 static t_int* binmonitor_arg_perform ( t_int* io );
 static void   binmonitor_dsp         ( t_binmonitor* object, t_signal **sig );
 static void   binmonitor_arg_dsp     ( t_binmonitor* object, t_signal **sig );
+static void   binmonitor_queue       ( t_binmonitor* object, t_float value );
+static void   binmonitor_tick        ( t_binmonitor* object );
+static void   binmonitor_rate        ( t_binmonitor* object, t_floatarg interval );
 static void*  binmonitor_new         ( t_symbol *s, t_int argc, t_atom *argv );
+static void   binmonitor_free        ( t_binmonitor* object );
 void          binmonitor_tilde_setup ( void );
 void          binmonitor_bang        ( t_binmonitor* object );
 
 
 //------------------------------------------------------------------------------
-// binmonitor_perform - the signal processing function of this object
+// binmonitor_bang - outputs the most recently drained bin value
 //------------------------------------------------------------------------------
 void binmonitor_bang( t_binmonitor* object )
 {
@@ -80,6 +104,82 @@ void binmonitor_bang( t_binmonitor* object )
 }
 
 
+//------------------------------------------------------------------------------
+// binmonitor_queue - hands a bin value from the perform routine to the clock
+//------------------------------------------------------------------------------
+static void binmonitor_queue( t_binmonitor* object, t_float value )
+{
+    // with an interval only the newest value is output, so keep just that one
+    if( object->interval > 0 )
+    {
+        object->latest       = value;
+        object->latest_fresh = TRUE;
+    }
+    else
+    {
+        // a full queue drops the value rather than blocking the dsp thread
+        RingWrite( &object->queue, value );
+    }
+
+    // schedule output on the scheduler side unless already pending
+    if( !object->clock_pending )
+    {
+        object->clock_pending = TRUE;
+        clock_delay( object->clock, object->interval );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// binmonitor_tick - drains queued bin values to the outlet
+//------------------------------------------------------------------------------
+static void binmonitor_tick( t_binmonitor* object )
+{
+    t_float value;
+    t_int   fresh = FALSE;
+
+    object->clock_pending = FALSE;
+
+    while( RingRead( &object->queue, &value ) )
+    {
+        object->bin_value = value;
+
+        // with no interval every value is output, otherwise only the newest
+        if( object->interval <= 0 )
+        {
+            binmonitor_bang( object );
+        }
+        else
+        {
+            fresh = TRUE;
+        }
+    }
+
+    if( object->latest_fresh )
+    {
+        object->latest_fresh = FALSE;
+        object->bin_value    = object->latest;
+        fresh                = TRUE;
+    }
+
+    if( fresh )
+    {
+        binmonitor_bang( object );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// binmonitor_rate - sets the milliseconds between outputs
+//------------------------------------------------------------------------------
+static void binmonitor_rate( t_binmonitor* object, t_floatarg interval )
+{
+    // with an interval set values bypass the queue for a single latest slot,
+    // so any block rate fits however long the interval
+    object->interval = Clip( interval, 0, 1000 );
+}
+
+
 //------------------------------------------------------------------------------
 // binmonitor_perform - the signal processing function of this object
 //------------------------------------------------------------------------------
@@ -97,11 +197,8 @@ static t_int* binmonitor_perform( t_int* io )
     // constrain index to valid vector indices
     index = Clip( index, 0, frames - 1 );
 
-    // store the bin value
-    object->bin_value = in1[ index ];
-
-    // bang this object to cause float output
-    binmonitor_bang( object );
+    // queue the bin value for output by the clock
+    binmonitor_queue( object, in1[ index ] );
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
@@ -123,11 +220,8 @@ static t_int* binmonitor_arg_perform( t_int* io )
     // constrain index to valid vector indices
     index = Clip( index, 0, frames - 1 );
 
-    // store the bin value
-    object->bin_value = in1[ index ];
-
-    // bang this object to cause float output
-    binmonitor_bang( object );
+    // queue the bin value for output by the clock
+    binmonitor_queue( object, in1[ index ] );
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
@@ -192,9 +286,15 @@ static void* binmonitor_new( t_symbol *s, t_int argc, t_atom *argv )
         // create a new float outlet for this object
         object->outlet_1 = outlet_new( &object->object, gensym( "float" ) );
 
+        // create a clock to output queued values
+        object->clock = clock_new( object, ( t_method )binmonitor_tick );
+
         // initialize variables
-        object->inlet_1   = 0;
-        object->bin_value = 0;
+        object->inlet_1       = 0;
+        object->bin_value     = 0;
+        object->latest_fresh  = FALSE;
+        object->clock_pending = FALSE;
+        object->interval      = 0;
 
         return object;
     }
@@ -209,15 +309,30 @@ static void* binmonitor_new( t_symbol *s, t_int argc, t_atom *argv )
         // create a new float outlet for this object
         object->outlet_1 = outlet_new( &object->object, gensym( "float" ) );
 
+        // create a clock to output queued values
+        object->clock = clock_new( object, ( t_method )binmonitor_tick );
+
         // initialize variables
-        object->inlet_1   = 0;
-        object->bin_value = 0;
+        object->inlet_1       = 0;
+        object->bin_value     = 0;
+        object->latest_fresh  = FALSE;
+        object->clock_pending = FALSE;
+        object->interval      = 0;
 
         return object;
     }
 }
 
 
+//------------------------------------------------------------------------------
+// binmonitor_free - cleans up memory allocated by this object
+//------------------------------------------------------------------------------
+static void binmonitor_free( t_binmonitor* object )
+{
+    clock_free( object->clock );
+}
+
+
 //------------------------------------------------------------------------------
 // binmonitor_tilde_setup - describes the attributes of this object to pd so it may be properly instantiated
 // (must always be named with _tilde replacing ~ in the object name)
@@ -228,7 +343,7 @@ void binmonitor_tilde_setup( void )
     //--------------------------------------------------------------------------
 
     // creates an instance of this object and describes it to pd
-    binmonitor_class = class_new( gensym( "binmonitor~" ), ( t_newmethod )binmonitor_new, 0, sizeof( t_binmonitor ), 0, A_GIMME, 0 );
+    binmonitor_class = class_new( gensym( "binmonitor~" ), ( t_newmethod )binmonitor_new, ( t_method )binmonitor_free, sizeof( t_binmonitor ), 0, A_GIMME, 0 );
 
     // declares leftmost inlet as a signal inlet
     CLASS_MAINSIGNALIN( binmonitor_class, t_binmonitor, inlet_1 );
@@ -238,16 +353,24 @@ void binmonitor_tilde_setup( void )
 
     class_addbang( binmonitor_class, binmonitor_bang );
 
+    // installs binmonitor_rate to respond to "rate" message
+    class_addmethod( binmonitor_class, ( t_method )binmonitor_rate, gensym( "rate" ), A_FLOAT, 0 );
+
     // binmonitor arg class
     //--------------------------------------------------------------------------
 
-    binmonitor_arg_class = class_new( gensym( "binmonitor~" ), 0, 0, sizeof( t_binmonitor ), 0, 0 );
+    binmonitor_arg_class = class_new( gensym( "binmonitor~" ), 0, ( t_method )binmonitor_free, sizeof( t_binmonitor ), 0, 0 );
 
     // declares leftmost inlet as a signal inlet
     CLASS_MAINSIGNALIN( binmonitor_arg_class, t_binmonitor, inlet_1 );
 
     // installs binmonitor_arg_dsp so that it will be called when dsp is turned on
     class_addmethod( binmonitor_arg_class, ( t_method )binmonitor_arg_dsp, gensym( "dsp" ), 0 );
+
+    class_addbang( binmonitor_arg_class, binmonitor_bang );
+
+    // installs binmonitor_rate to respond to "rate" message
+    class_addmethod( binmonitor_arg_class, ( t_method )binmonitor_rate, gensym( "rate" ), A_FLOAT, 0 );
 }
 
 
@@ -53,13 +53,6 @@ typedef struct bintrim
     t_float bin_min;
     t_float bin_max;
 
-    // pointers to temporary signal vector arrays
-    t_float* in1_temp;
-    t_float* in2_temp;
-
-    // memory size of a signal vector block
-    t_int memory_size;
-
 } t_bintrim;
 
 
@@ -70,70 +63,52 @@ static t_int* bintrim_perform     ( t_int* io );
 static t_int* bintrim_arg_perform ( t_int* io );
 static void   bintrim_dsp         ( t_bintrim* object, t_signal** sig );
 static void   bintrim_arg_dsp     ( t_bintrim* object, t_signal** sig );
+static void   bintrim_gate        ( t_float* in1, t_float* in2, t_float* out1, t_float* out2, t_int bin_min, t_int bin_max, t_int frames );
 static void*  bintrim_new         ( t_symbol* selector, t_int items, t_atom* list );
-static void   bintrim_free        ( t_bintrim* object );
 void          bintrim_tilde_setup ( void );
 
 
 //------------------------------------------------------------------------------
-// bintrim_perform - the signal processing function of this object
+// bintrim_gate - zeroes bins outside of the clipped bin range in one pass
 //------------------------------------------------------------------------------
-static t_int* bintrim_perform( t_int* io )
+static void bintrim_gate( t_float* in1, t_float* in2, t_float* out1, t_float* out2, t_int bin_min, t_int bin_max, t_int frames )
 {
-    // store variables from dsp input/output array
-    t_float*   in1    = ( t_float*   )( io[ 1 ] );
-    t_float*   in2    = ( t_float*   )( io[ 2 ] );
-    t_float*   in3    = ( t_float*   )( io[ 3 ] );
-    t_float*   in4    = ( t_float*   )( io[ 4 ] );
-    t_float*   out1   = ( t_float*   )( io[ 5 ] );
-    t_float*   out2   = ( t_float*   )( io[ 6 ] );
-    t_int      frames = ( t_int      )( io[ 7 ] );
-    t_bintrim* object = ( t_bintrim* )( io[ 8 ] );
-
-    // temp signal vectors
-    t_float* in1_temp = object->in1_temp;
-    t_float* in2_temp = object->in2_temp;
-
-    // memory copying variables
-    t_int mem_copy_size = object->memory_size;
-    t_int mem_clip_size;
-    t_int offset;
-
-    // store local copies of min/max bin numbers
-    t_int bin_min = in3[ 0 ];
-    t_int bin_max = in4[ 0 ];
-
-    // constrain and store object clip parameters
+    // constrain bin numbers to the signal vector
     bin_min = Clip( bin_min, 0, frames - 1 );
     bin_max = Clip( bin_max, 0, frames - 1 );
 
-    // calculate mem_size and offset for memcpy
+    // the range may be given in either order
     if( bin_max < bin_min )
     {
-        mem_clip_size = ( ( bin_min - bin_max ) + 1 ) * sizeof( t_float );
-        offset = bin_max;
+        GateRange( in1, in2, out1, out2, bin_max, bin_min, TRUE, frames );
     }
     else
     {
-        mem_clip_size = ( ( bin_max - bin_min ) + 1 ) * sizeof( t_float );
-        offset = bin_min;
+        GateRange( in1, in2, out1, out2, bin_min, bin_max, TRUE, frames );
     }
+}
 
-    // copy inlet memory
-    memcpy( in1_temp, in1, mem_copy_size );
-    memcpy( in2_temp, in2, mem_copy_size );
 
-    // clear outlet memory
-    memset( out1, 0, mem_copy_size );
-    memset( out2, 0, mem_copy_size );
+//------------------------------------------------------------------------------
+// bintrim_perform - the signal processing function of this object
+//------------------------------------------------------------------------------
+static t_int* bintrim_perform( t_int* io )
+{
+    // store variables from dsp input/output array
+    t_float* in1    = ( t_float* )( io[ 1 ] );
+    t_float* in2    = ( t_float* )( io[ 2 ] );
+    t_float* in3    = ( t_float* )( io[ 3 ] );
+    t_float* in4    = ( t_float* )( io[ 4 ] );
+    t_float* out1   = ( t_float* )( io[ 5 ] );
+    t_float* out2   = ( t_float* )( io[ 6 ] );
+    t_int    frames = ( t_int    )( io[ 7 ] );
 
-    // copy values within clip range to outlets
-    memcpy( &( out1[ offset ] ), &( in1_temp[ offset ] ), mem_clip_size );
-    memcpy( &( out2[ offset ] ), &( in2_temp[ offset ] ), mem_clip_size );
+    // min/max bin numbers are read once per block
+    bintrim_gate( in1, in2, out1, out2, in3[ 0 ], in4[ 0 ], frames );
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
-    return &( io[ 9 ] );
+    return &( io[ 8 ] );
 }
 
 
@@ -150,46 +125,7 @@ static t_int* bintrim_arg_perform( t_int* io )
     t_int      frames = ( t_int      )( io[ 5 ] );
     t_bintrim* object = ( t_bintrim* )( io[ 6 ] );
 
-    // temp signal vectors
-    t_float* in1_temp = object->in1_temp;
-    t_float* in2_temp = object->in2_temp;
-
-    // memory copying variables
-    t_int mem_copy_size = object->memory_size;
-    t_int mem_clip_size;
-    t_int offset;
-
-    // store local copies of min/max bin numbers
-    t_int bin_min = object->bin_min;
-    t_int bin_max = object->bin_max;
-
-    // constrain and store object clip parameters
-    bin_min = Clip( bin_min, 0, frames - 1 );
-    bin_max = Clip( bin_max, 0, frames - 1 );
-
-    // calculate mem_size and offset for memcpy
-    if( bin_max < bin_min )
-    {
-        mem_clip_size = ( ( bin_min - bin_max ) + 1 ) * sizeof( t_float );
-        offset = bin_max;
-    }
-    else
-    {
-        mem_clip_size = ( ( bin_max - bin_min ) + 1 ) * sizeof( t_float );
-        offset = bin_min;
-    }
-
-    // copy inlet memory
-    memcpy( in1_temp, in1, mem_copy_size );
-    memcpy( in2_temp, in2, mem_copy_size );
-
-    // clear outlet memory
-    memset( out1, 0, mem_copy_size );
-    memset( out2, 0, mem_copy_size );
-
-    // copy values within clip range to outlets
-    memcpy( &( out1[ offset ] ), &( in1_temp[ offset ] ), mem_clip_size );
-    memcpy( &( out2[ offset ] ), &( in2_temp[ offset ] ), mem_clip_size );
+    bintrim_gate( in1, in2, out1, out2, object->bin_min, object->bin_max, frames );
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
@@ -202,16 +138,6 @@ static t_int* bintrim_arg_perform( t_int* io )
 //------------------------------------------------------------------------------
 static void bintrim_dsp( t_bintrim* object, t_signal** sig )
 {
-    // calculate memory size of signal vector for memset and realloc
-    t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
-
-    // save memory_size for use in dsp loop
-    object->memory_size = memory_size;
-
-    // allocate enough memory to hold signal vector data
-    object->in1_temp = realloc( object->in1_temp, memory_size );
-    object->in2_temp = realloc( object->in2_temp, memory_size );
-
     // dsp_add arguments
     //--------------------------------------------------------------------------
     // perform routine
@@ -223,8 +149,7 @@ static void bintrim_dsp( t_bintrim* object, t_signal** sig )
     // outlet 1 sample vector
     // outlet 2 sample vector
     // sample frames to process (vector size)
-    // pointer to this object
-    dsp_add( bintrim_perform, 8, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 4 ]->s_vec, sig[ 5 ]->s_vec, sig[ 0 ]->s_n, object );
+    dsp_add( bintrim_perform, 7, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 4 ]->s_vec, sig[ 5 ]->s_vec, sig[ 0 ]->s_n );
 }
 
 
@@ -233,16 +158,6 @@ static void bintrim_dsp( t_bintrim* object, t_signal** sig )
 //------------------------------------------------------------------------------
 static void bintrim_arg_dsp( t_bintrim* object, t_signal** sig )
 {
-    // calculate memory size of signal vector for memset and realloc
-    t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
-
-    // save memory_size for use in dsp loop
-    object->memory_size = memory_size;
-
-    // allocate enough memory to hold signal vector data
-    object->in1_temp = realloc( object->in1_temp, memory_size );
-    object->in2_temp = realloc( object->in2_temp, memory_size );
-
     // dsp_add arguments
     //--------------------------------------------------------------------------
     // perform routine
@@ -331,10 +246,6 @@ static void* bintrim_new( t_symbol* selector, t_int items, t_atom* list )
         outlet_new( &object->object, gensym( "signal" ) );
         outlet_new( &object->object, gensym( "signal" ) );
 
-        // initialize memory pointers
-        object->in1_temp = NULL;
-        object->in2_temp = NULL;
-
         // initialize the float inlet variables
         object->inlet_1 = 0;
         object->inlet_2 = 0;
@@ -346,29 +257,6 @@ static void* bintrim_new( t_symbol* selector, t_int items, t_atom* list )
 }
 
 
-//------------------------------------------------------------------------------
-// bintrim_free - cleans up memory allocated by this object
-//------------------------------------------------------------------------------
-static void bintrim_free( t_bintrim* object )
-{
-    // if memory is allocated
-    if( object->in1_temp )
-    {
-        // deallocate the memory
-        free( object->in1_temp );
-
-        // set the memory pointer to null
-        object->in1_temp = NULL;
-    }
-
-    if( object->in2_temp )
-    {
-        free( object->in2_temp );
-        object->in2_temp = NULL;
-    }
-}
-
-
 //------------------------------------------------------------------------------
 // bintrim_tilde_setup - describes the attributes of this object to pd so it may be properly instantiated
 // (must always be named with _tilde replacing ~ in the object name)
@@ -379,7 +267,7 @@ void bintrim_tilde_setup( void )
     //--------------------------------------------------------------------------
 
     // creates an instance of this object and describes it to pd
-    bintrim_class = class_new( gensym( "bintrim~" ), ( t_newmethod )bintrim_new, ( t_method )bintrim_free, sizeof( t_bintrim ), 0, A_GIMME, 0 );
+    bintrim_class = class_new( gensym( "bintrim~" ), ( t_newmethod )bintrim_new, 0, sizeof( t_bintrim ), 0, A_GIMME, 0 );
 
     // declares leftmost inlet as a signal inlet
     CLASS_MAINSIGNALIN( bintrim_class, t_bintrim, inlet_1 );
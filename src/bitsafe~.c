@@ -45,6 +45,12 @@ typedef struct bitsafe
     // needed for CLASS_MAINSIGNALIN macro call in bitsafe_tilde_setup
     t_float inlet_1;
 
+    // number of blocks that needed nan/inf repair
+    t_int repairs;
+
+    // pointer to the repair count outlet
+    t_outlet* outlet_2;
+
 } t_bitsafe;
 
 
@@ -53,6 +59,8 @@ typedef struct bitsafe
 //------------------------------------------------------------------------------
 static t_int* bitsafe_perform     ( t_int* io );
 static void   bitsafe_dsp         ( t_bitsafe* object, t_signal **sig );
+static void   bitsafe_bang        ( t_bitsafe* object );
+static void   bitsafe_reset       ( t_bitsafe* object );
 static void*  bitsafe_new         ( void );
 void          bitsafe_tilde_setup ( void );
 
@@ -63,23 +71,35 @@ void          bitsafe_tilde_setup ( void );
 static t_int* bitsafe_perform( t_int* io )
 {
     // store variables from dsp input/output array
-    t_float* in     = ( t_float* )( io[ 1 ] );
-    t_float* out    = ( t_float* )( io[ 2 ] );
-    t_int    frames = ( t_int    )( io[ 3 ] );
+    t_float*   in     = ( t_float*   )( io[ 1 ] );
+    t_float*   out    = ( t_float*   )( io[ 2 ] );
+    t_int      frames = ( t_int      )( io[ 3 ] );
+    t_bitsafe* object = ( t_bitsafe* )( io[ 4 ] );
 
     // signal vector iterator variable
     t_int n = -1;
 
-    // the dsp loop
-    while( ++n < frames )
+    // almost every block is finite, so one vectorized pass over the exponent
+    // bits copies those blocks through, or leaves them untouched in place
+    t_int finite = in == out ? FiniteVector( in, frames ) : FiniteCopy( in, out, frames );
+
+    // only blocks holding nan or infinity take the repairing loop
+    if( !finite )
     {
-        // perform nan/inf fix and store result to output sample
-        out[ n ] = FixNanInf( in[ n ] );
+        // count the repair
+        ++object->repairs;
+
+        // the dsp loop
+        while( ++n < frames )
+        {
+            // perform nan/inf fix and store result to output sample
+            out[ n ] = FixNanInf( in[ n ] );
+        }
     }
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
-    return &( io[ 4 ] );
+    return &( io[ 5 ] );
 }
 
 
@@ -95,7 +115,26 @@ static void bitsafe_dsp( t_bitsafe* object, t_signal **sig )
     // inlet sample vector
     // outlet sample vector
     // sample frames to process (vector size)
-    dsp_add( bitsafe_perform, 3, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 0 ]->s_n );
+    // pointer to this object
+    dsp_add( bitsafe_perform, 4, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 0 ]->s_n, object );
+}
+
+
+//------------------------------------------------------------------------------
+// bitsafe_bang - outputs the number of blocks that needed repair
+//------------------------------------------------------------------------------
+static void bitsafe_bang( t_bitsafe* object )
+{
+    outlet_float( object->outlet_2, object->repairs );
+}
+
+
+//------------------------------------------------------------------------------
+// bitsafe_reset - clears the repair count
+//------------------------------------------------------------------------------
+static void bitsafe_reset( t_bitsafe* object )
+{
+    object->repairs = 0;
 }
 
 
@@ -110,6 +149,13 @@ static void* bitsafe_new( void )
     // create a new signal outlet for this object
     outlet_new( &object->object, gensym( "signal" ) );
 
+    // create a float outlet for the repair count
+    object->outlet_2 = outlet_new( &object->object, gensym( "float" ) );
+
+    // initialize variables
+    object->inlet_1 = 0;
+    object->repairs = 0;
+
     return object;
 }
 
@@ -128,6 +174,12 @@ void bitsafe_tilde_setup( void )
 
     // installs bitsafe_dsp so that it will be called when dsp is turned on
     class_addmethod( bitsafe_class, ( t_method )bitsafe_dsp, gensym( "dsp" ), 0 );
+
+    // add a bang handler to this class
+    class_addbang( bitsafe_class, bitsafe_bang );
+
+    // installs bitsafe_reset to respond to "reset" message
+    class_addmethod( bitsafe_class, ( t_method )bitsafe_reset, gensym( "reset" ), 0 );
 }
 
 
@@ -3,7 +3,7 @@
 //
 //  blocksmooth~.c
 //
-//  Replaces sample values of 0 with value of last sample per block
+//  Replaces sample values of 0 with the last non-zero sample value
 //
 //  Created by Cooper Baker on 7/22/12.
 //  Updated for 64 Bit Support in September 2019.
@@ -28,6 +28,15 @@
 #endif
 
 
+//------------------------------------------------------------------------------
+// constant definitions
+//------------------------------------------------------------------------------
+
+// samples tested together for zeros - a chunk of all zeros is filled with the
+// held value in one pass, and only chunks mixing values take the sample scan
+#define BLOCKSMOOTH_CHUNK 16
+
+
 //------------------------------------------------------------------------------
 // blocksmooth_class - pointer to this object's definition
 //------------------------------------------------------------------------------
@@ -45,6 +54,9 @@ typedef struct blocksmooth
     // needed for CLASS_MAINSIGNALIN macro call in blocksmooth_tilde_setup
     t_float inlet_1;
 
+    // last non-zero value, held across signal vectors
+    t_float last_value;
+
 } t_blocksmooth;
 
 
@@ -53,6 +65,7 @@ typedef struct blocksmooth
 //------------------------------------------------------------------------------
 static t_int* blocksmooth_perform     ( t_int* io );
 static void   blocksmooth_dsp         ( t_blocksmooth* object, t_signal **sig );
+static void   blocksmooth_reset       ( t_blocksmooth* object );
 static void*  blocksmooth_new         ( void );
 void          blocksmooth_tilde_setup ( void );
 
@@ -63,39 +76,64 @@ void          blocksmooth_tilde_setup ( void );
 static t_int* blocksmooth_perform( t_int* io )
 {
     // store variables from dsp input/output array
-    t_float* in     = ( t_float* )( io[ 1 ] );
-    t_float* out    = ( t_float* )( io[ 2 ] );
-    t_int    frames = ( t_int    )( io[ 3 ] );
+    t_float*       in     = ( t_float*       )( io[ 1 ] );
+    t_float*       out    = ( t_float*       )( io[ 2 ] );
+    t_int          frames = ( t_int          )( io[ 3 ] );
+    t_blocksmooth* object = ( t_blocksmooth* )( io[ 4 ] );
 
-    // signal vector iterator variable
-    t_int n = -1;
+    // signal vector iterator variables
+    t_int n = 0;
+    t_int i;
 
-    // allocate temporary value variables
-    t_float value;
-    t_float last_value = 0;
+    // the held value carries over from the previous signal vector
+    t_float last_value = object->last_value;
 
-    // the dsp loop
-    while( ++n < frames )
+    // nonzero when any sample of a chunk is nonzero ( sign masked, so -0 is zero )
+    t_floatbits found;
+
+    // the dsp loop, a chunk at a time - sparse spectra are mostly zero chunks,
+    // which are tested and filled with packed instructions
+    for( ; n + BLOCKSMOOTH_CHUNK <= frames ; n += BLOCKSMOOTH_CHUNK )
     {
-        // store input sample
-        value = in[ n ];
+        found = 0;
 
-        if( value == 0 )
+        for( i = 0 ; i < BLOCKSMOOTH_CHUNK ; ++i )
         {
-            value = last_value;
+            found |= FloatBits( in[ n + i ] ) & ( FLOAT_EXPONENT_BITS | FLOAT_MANTISSA_BITS );
+        }
+
+        if( found )
+        {
+            // replace zeros with the last non-zero value
+            for( i = 0 ; i < BLOCKSMOOTH_CHUNK ; ++i )
+            {
+                last_value   = in[ n + i ] != 0 ? in[ n + i ] : last_value;
+                out[ n + i ] = last_value;
+            }
         }
         else
         {
-            last_value = value;
+            // hold the last non-zero value through the chunk
+            for( i = 0 ; i < BLOCKSMOOTH_CHUNK ; ++i )
+            {
+                out[ n + i ] = last_value;
+            }
         }
+    }
 
-        // store output sample
-        out[ n ] = value;
+    // samples past the last whole chunk
+    for( ; n < frames ; ++n )
+    {
+        last_value = in[ n ] != 0 ? in[ n ] : last_value;
+        out[ n ]   = last_value;
     }
 
+    // store the held value for the next signal vector
+    object->last_value = last_value;
+
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
-    return &( io[ 4 ] );
+    return &( io[ 5 ] );
 }
 
 
@@ -111,7 +149,17 @@ static void blocksmooth_dsp( t_blocksmooth* object, t_signal **sig )
     // inlet sample vector
     // outlet sample vector
     // sample frames to process (vector size)
-    dsp_add( blocksmooth_perform, 3, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 0 ]->s_n );
+    // pointer to this object
+    dsp_add( blocksmooth_perform, 4, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 0 ]->s_n, object );
+}
+
+
+//------------------------------------------------------------------------------
+// blocksmooth_reset - clears the held value
+//------------------------------------------------------------------------------
+static void blocksmooth_reset( t_blocksmooth* object )
+{
+    object->last_value = 0;
 }
 
 
@@ -126,6 +174,10 @@ static void* blocksmooth_new( void )
     // create a new signal outlet for this object
     outlet_new( &object->object, gensym( "signal" ) );
 
+    // initialize variables
+    object->inlet_1    = 0;
+    object->last_value = 0;
+
     return object;
 }
 
@@ -144,6 +196,9 @@ void blocksmooth_tilde_setup( void )
 
     // installs blocksmooth_dsp so that it will be called when dsp is turned on
     class_addmethod( blocksmooth_class, ( t_method )blocksmooth_dsp, gensym( "dsp" ), 0 );
+
+    // installs blocksmooth_reset to respond to "reset" message
+    class_addmethod( blocksmooth_class, ( t_method )blocksmooth_reset, gensym( "reset" ), 0 );
 }
 
 
@@ -75,6 +75,9 @@ typedef struct cartofreq
     // the local sample rate
     t_float sample_rate;
 
+    // dsp timing record read by spectprof ( empty unless profiling is compiled in )
+    PROFILE_MEMBER
+
 } t_cartofreq;
 
 
@@ -83,6 +86,7 @@ typedef struct cartofreq
 //------------------------------------------------------------------------------
 static t_int* cartofreq_perform     ( t_int* io );
 static void   cartofreq_dsp         ( t_cartofreq* object, t_signal **sig );
+static void   cartofreq_reset       ( t_cartofreq* object );
 static void   cartofreq_overlap     ( t_cartofreq* object, t_floatarg overlap );
 static void*  cartofreq_new         ( t_symbol* symbol, t_int items, t_atom* list );
 static void   cartofreq_free        ( t_cartofreq* object );
@@ -294,18 +298,26 @@ static void cartofreq_dsp( t_cartofreq* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate enough memory to hold signal vector data
-    object->phase_array      = realloc( object->phase_array,      memory_size );
-    object->mag_array        = realloc( object->mag_array,        memory_size );
-    object->delta_array_temp = realloc( object->delta_array_temp, memory_size );
-    object->delta_array_old  = realloc( object->delta_array_old,  memory_size );
-
-    // set allocated memory values to 0
-    memset( object->delta_array_temp, 0, memory_size );
-    memset( object->delta_array_old,  0, memory_size );
+    // only reallocate and clear memory when the vector size or sample rate has changed
+    if( ( memory_size != object->memory_size ) || ( sig[ 0 ]->s_sr != object->sample_rate ) )
+    {
+        // allocate enough memory to hold signal vector data
+        object->phase_array      = realloc( object->phase_array,      memory_size );
+        object->mag_array        = realloc( object->mag_array,        memory_size );
+        object->delta_array_temp = realloc( object->delta_array_temp, memory_size );
+        object->delta_array_old  = realloc( object->delta_array_old,  memory_size );
+
+        // set allocated memory values to 0
+        memset( object->delta_array_temp, 0, memory_size );
+        memset( object->delta_array_old,  0, memory_size );
+
+        // save vector memory size and sample rate
+        object->memory_size = memory_size;
+        object->sample_rate = sig[ 0 ]->s_sr;
+    }
 
-    object->memory_size = memory_size;
-    object->sample_rate = sig[ 0 ]->s_sr;
+    // start timing this object ( when profiling is compiled in )
+    PROFILE_DSP_BEGIN( object );
 
     // dsp_add arguments
     //--------------------------------------------------------------------------
@@ -328,6 +340,23 @@ static void cartofreq_dsp( t_cartofreq* object, t_signal **sig )
         sig[ 0 ]->s_n,
         object
     );
+
+    // stop timing this object
+    PROFILE_DSP_END( object );
+}
+
+
+//------------------------------------------------------------------------------
+// cartofreq_reset - clears the previous phase deviation data
+//------------------------------------------------------------------------------
+static void cartofreq_reset( t_cartofreq* object )
+{
+    // only clear memory that has been allocated
+    if( object->delta_array_old )
+    {
+        memset( object->delta_array_temp, 0, object->memory_size );
+        memset( object->delta_array_old,  0, object->memory_size );
+    }
 }
 
 
@@ -348,6 +377,9 @@ static void* cartofreq_new( t_symbol* symbol, t_int items, t_atom* list )
     // create a pointer to this object
     t_cartofreq* object = ( t_cartofreq* )pd_new( cartofreq_class );
 
+    // register with the dsp profiler
+    PROFILE_REGISTER( object, "cartofreq~" );
+
     // create a second signal inlet
     signalinlet_new( &object->object, object->inlet_2 );
 
@@ -383,6 +415,9 @@ static void* cartofreq_new( t_symbol* symbol, t_int items, t_atom* list )
 //------------------------------------------------------------------------------
 static void cartofreq_free( t_cartofreq* object )
 {
+    // unregister from the dsp profiler
+    PROFILE_UNREGISTER( object );
+
     // if memory is allocated
     if( object->phase_array )
     {
@@ -431,6 +466,9 @@ void cartofreq_tilde_setup( void )
 
     // associate a method with the "overlap" symbol for subsequent overlap inlet handling
     class_addmethod( cartofreq_class, ( t_method )cartofreq_overlap, gensym( "overlap" ), A_FLOAT, 0 );
+
+    // installs cartofreq_reset to respond to "reset" message
+    class_addmethod( cartofreq_class, ( t_method )cartofreq_reset, gensym( "reset" ), 0 );
 }
 
 
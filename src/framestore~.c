@@ -0,0 +1,728 @@
+//------------------------------------------------------------------------------
+//  Pd Spectral Toolkit
+//
+//  framestore~.c
+//
+//  Records spectral frames into a ring and plays them back with interpolation,
+//  saving and opening snapshots as memory mapped files
+//
+//  Copyright (C) 2019 Cooper Baker. All Rights Reserved.
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// headers
+//------------------------------------------------------------------------------
+
+// main header for pd
+#include "m_pd.h"
+
+// utility header for Pd Spectral Toolkit project
+#include "utility.h"
+
+// standard headers
+#include <stdlib.h>
+#include <string.h>
+
+// memory mapped file headers
+#ifdef NT
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// disable compiler warnings on windows
+#ifdef NT
+#pragma warning( disable : 4244 )
+#pragma warning( disable : 4305 )
+#endif
+
+
+//------------------------------------------------------------------------------
+// constant definitions
+//------------------------------------------------------------------------------
+#define DEFAULT_FRAMES 16
+#define FILE_MAGIC     "PSTFRAME"
+#define FILE_VERSION   1
+
+
+//------------------------------------------------------------------------------
+// framestore_header - leads a snapshot file, followed by its frames oldest
+// first, each frame holding bins part 1 values and then bins part 2 values
+//------------------------------------------------------------------------------
+typedef struct framestore_header
+{
+    char magic[ 8 ];
+    int  version;
+    int  float_size;
+    int  bins;
+    int  frames;
+
+} t_framestore_header;
+
+
+//------------------------------------------------------------------------------
+// framestore_class - pointer to this object's definition
+//------------------------------------------------------------------------------
+static t_class* framestore_class;
+
+
+//------------------------------------------------------------------------------
+// framestore - data structure holding this object's data
+//------------------------------------------------------------------------------
+typedef struct framestore
+{
+    // this object - must always be first variable in struct
+    t_object object;
+
+    // needed for CLASS_MAINSIGNALIN macro call in framestore_tilde_setup
+    t_float inlet_1;
+
+    // needed for signalinlet_new calls in framestore_new
+    t_float inlet_2;
+    t_float inlet_3;
+
+    // the frame ring - frames of bins part 1 values followed by bins part 2 values
+    t_float* store;
+
+    // capacity of the ring and number of frames recorded into it
+    t_int frames;
+    t_int filled;
+
+    // ring slot the next frame is recorded into
+    t_int write_index;
+
+    // values in each part of a frame ( the block size the ring was made for )
+    t_int bins;
+
+    // flags to record every block or only the next block
+    t_int record;
+    t_int record_once;
+
+    // snapshot file mapping holding the ring ( NULL when the ring is allocated )
+    void*  map;
+    size_t map_size;
+
+    // canvas used to resolve file names
+    t_canvas* canvas;
+
+} t_framestore;
+
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+static void*    framestore_map_file    ( const char* path, size_t* size );
+static void*    framestore_create_file ( const char* path, size_t size );
+static t_int    framestore_replace_file( const char* from, const char* to );
+static void     framestore_unmap       ( void* map, size_t size );
+static t_float* framestore_frame       ( t_framestore* object, t_int index );
+static t_int*   framestore_perform     ( t_int* io );
+static void     framestore_dsp         ( t_framestore* object, t_signal **sig );
+static void     framestore_release     ( t_framestore* object );
+static void     framestore_allocate    ( t_framestore* object, t_int bins );
+static void     framestore_bang        ( t_framestore* object );
+static void     framestore_record      ( t_framestore* object, t_floatarg record );
+static void     framestore_clear       ( t_framestore* object );
+static void     framestore_size        ( t_framestore* object, t_floatarg frames );
+static void     framestore_save        ( t_framestore* object, t_symbol* name );
+static void     framestore_open        ( t_framestore* object, t_symbol* name );
+static void*    framestore_new         ( t_floatarg frames );
+static void     framestore_free        ( t_framestore* object );
+void            framestore_tilde_setup ( void );
+
+
+#ifdef NT
+//------------------------------------------------------------------------------
+// framestore_map_file - maps an existing file copy on write ( NULL on failure )
+//------------------------------------------------------------------------------
+static void* framestore_map_file( const char* path, size_t* size )
+{
+    HANDLE        file = CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+    HANDLE        mapping;
+    LARGE_INTEGER file_size;
+    void*         map = NULL;
+
+    if( file == INVALID_HANDLE_VALUE )
+    {
+        return NULL;
+    }
+
+    if( GetFileSizeEx( file, &file_size ) && file_size.QuadPart > 0 )
+    {
+        mapping = CreateFileMappingA( file, NULL, PAGE_WRITECOPY, 0, 0, NULL );
+
+        if( mapping )
+        {
+            map = MapViewOfFile( mapping, FILE_MAP_COPY, 0, 0, 0 );
+            CloseHandle( mapping );
+        }
+
+        *size = ( size_t )file_size.QuadPart;
+    }
+
+    CloseHandle( file );
+
+    return map;
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_create_file - creates a file of the given size and maps it for writing
+//------------------------------------------------------------------------------
+static void* framestore_create_file( const char* path, size_t size )
+{
+    HANDLE file = CreateFileA( path, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL );
+    HANDLE mapping;
+    void*  map = NULL;
+
+    if( file == INVALID_HANDLE_VALUE )
+    {
+        return NULL;
+    }
+
+    mapping = CreateFileMappingA( file, NULL, PAGE_READWRITE, ( DWORD )( ( unsigned long long )size >> 32 ), ( DWORD )size, NULL );
+
+    if( mapping )
+    {
+        map = MapViewOfFile( mapping, FILE_MAP_WRITE, 0, 0, size );
+        CloseHandle( mapping );
+    }
+
+    CloseHandle( file );
+
+    return map;
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_replace_file - moves a written file over the target, removing it
+// on failure ( FALSE when the target is in use or cannot be replaced )
+//------------------------------------------------------------------------------
+static t_int framestore_replace_file( const char* from, const char* to )
+{
+    if( MoveFileExA( from, to, MOVEFILE_REPLACE_EXISTING ) )
+    {
+        return TRUE;
+    }
+
+    DeleteFileA( from );
+
+    return FALSE;
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_unmap - releases a file mapping
+//------------------------------------------------------------------------------
+static void framestore_unmap( void* map, size_t size )
+{
+    UnmapViewOfFile( map );
+}
+#else
+//------------------------------------------------------------------------------
+// framestore_map_file - maps an existing file copy on write ( NULL on failure )
+//------------------------------------------------------------------------------
+static void* framestore_map_file( const char* path, size_t* size )
+{
+    struct stat info;
+    void*       map;
+    int         file = open( path, O_RDONLY );
+
+    if( file < 0 )
+    {
+        return NULL;
+    }
+
+    if( fstat( file, &info ) < 0 || info.st_size <= 0 )
+    {
+        close( file );
+        return NULL;
+    }
+
+    // pages are read from disk as they are touched, so opening is immediate,
+    // and recording over a mapped snapshot never writes back to the file
+    map = mmap( NULL, ( size_t )info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0 );
+
+    close( file );
+
+    if( map == MAP_FAILED )
+    {
+        return NULL;
+    }
+
+    *size = ( size_t )info.st_size;
+
+    return map;
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_create_file - creates a file of the given size and maps it for writing
+//------------------------------------------------------------------------------
+static void* framestore_create_file( const char* path, size_t size )
+{
+    void* map;
+    int   file = open( path, O_RDWR | O_CREAT | O_TRUNC, 0666 );
+
+    if( file < 0 )
+    {
+        return NULL;
+    }
+
+    if( ftruncate( file, ( off_t )size ) < 0 )
+    {
+        close( file );
+        return NULL;
+    }
+
+    map = mmap( NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0 );
+
+    close( file );
+
+    return map == MAP_FAILED ? NULL : map;
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_replace_file - moves a written file over the target, removing it
+// on failure ( a mapping of the old target keeps reading the old file )
+//------------------------------------------------------------------------------
+static t_int framestore_replace_file( const char* from, const char* to )
+{
+    if( rename( from, to ) == 0 )
+    {
+        return TRUE;
+    }
+
+    unlink( from );
+
+    return FALSE;
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_unmap - releases a file mapping
+//------------------------------------------------------------------------------
+static void framestore_unmap( void* map, size_t size )
+{
+    munmap( map, size );
+}
+#endif
+
+
+//------------------------------------------------------------------------------
+// framestore_frame - locates a recorded frame, counting from the oldest
+//------------------------------------------------------------------------------
+static t_float* framestore_frame( t_framestore* object, t_int index )
+{
+    t_int oldest = object->write_index - object->filled + object->frames;
+
+    return &( object->store[ ( ( oldest + index ) % object->frames ) * object->bins * 2 ] );
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_perform - the signal processing function of this object
+//------------------------------------------------------------------------------
+static t_int* framestore_perform( t_int* io )
+{
+    // store variables from dsp input/output array
+    t_float*      in1    = ( t_float*      )( io[ 1 ] );
+    t_float*      in2    = ( t_float*      )( io[ 2 ] );
+    t_float*      in3    = ( t_float*      )( io[ 3 ] );
+    t_float*      out1   = ( t_float*      )( io[ 4 ] );
+    t_float*      out2   = ( t_float*      )( io[ 5 ] );
+    t_int         frames = ( t_int         )( io[ 6 ] );
+    t_framestore* object = ( t_framestore* )( io[ 7 ] );
+
+    // frame position is read once per block, before the outlets are written
+    t_float position = in3[ 0 ];
+
+    // playback frames and the fraction between them
+    t_float* frame_a;
+    t_float* frame_b;
+    t_float  fraction;
+    t_int    index;
+
+    // signal vector iterator variable
+    t_int n = -1;
+
+    // the ring must exist and match the block size
+    if( object->store == NULL || object->bins != frames )
+    {
+        memset( out1, 0, frames * sizeof( t_float ) );
+        memset( out2, 0, frames * sizeof( t_float ) );
+
+        return &( io[ 8 ] );
+    }
+
+    // record the input frame into the next ring slot
+    if( object->record || object->record_once )
+    {
+        frame_a = &( object->store[ object->write_index * frames * 2 ] );
+
+        memcpy( frame_a,            in1, frames * sizeof( t_float ) );
+        memcpy( frame_a + frames,   in2, frames * sizeof( t_float ) );
+
+        object->write_index = ( object->write_index + 1 ) % object->frames;
+        object->filled      = object->filled < object->frames ? object->filled + 1 : object->frames;
+        object->record_once = FALSE;
+    }
+
+    // nothing to play yet
+    if( object->filled == 0 )
+    {
+        memset( out1, 0, frames * sizeof( t_float ) );
+        memset( out2, 0, frames * sizeof( t_float ) );
+
+        return &( io[ 8 ] );
+    }
+
+    // wrap the position around the recorded frames
+    position = Modulo( position, object->filled );
+
+    if( position < 0 )
+    {
+        position += object->filled;
+    }
+
+    index    = ( t_int )position;
+    index    = index < object->filled ? index : 0;
+    fraction = position - index;
+
+    frame_a = framestore_frame( object, index );
+
+    // whole frame positions are copied directly
+    if( fraction == 0 )
+    {
+        memcpy( out1, frame_a,          frames * sizeof( t_float ) );
+        memcpy( out2, frame_a + frames, frames * sizeof( t_float ) );
+    }
+    // otherwise interpolate toward the following frame ( wrapping to the oldest )
+    else
+    {
+        frame_b = framestore_frame( object, ( index + 1 ) % object->filled );
+
+        while( ++n < frames )
+        {
+            out1[ n ] = Lerp( frame_a[ n ],          frame_b[ n ],          fraction );
+            out2[ n ] = Lerp( frame_a[ n + frames ], frame_b[ n + frames ], fraction );
+        }
+    }
+
+    // return the dsp input/output array address plus one more than its size
+    // to provide a pointer to the next perform function in pd's call list
+    return &( io[ 8 ] );
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_dsp - installs this object's dsp function in pd's callback list
+//------------------------------------------------------------------------------
+static void framestore_dsp( t_framestore* object, t_signal **sig )
+{
+    // a mapped snapshot keeps its own frame size
+    if( object->map )
+    {
+        if( object->bins != sig[ 0 ]->s_n )
+        {
+            pd_error( object, "framestore~: snapshot frames hold %d bins, block size is %d", ( int )object->bins, ( int )sig[ 0 ]->s_n );
+        }
+    }
+    // only reallocate the ring when the vector size has changed
+    else if( object->store == NULL || object->bins != sig[ 0 ]->s_n )
+    {
+        framestore_allocate( object, sig[ 0 ]->s_n );
+    }
+
+    // dsp_add arguments
+    //--------------------------------------------------------------------------
+    // perform routine
+    // number of passed parameters
+    // inlet 1 sample vector
+    // inlet 2 sample vector
+    // inlet 3 sample vector
+    // outlet 1 sample vector
+    // outlet 2 sample vector
+    // sample frames to process (vector size)
+    // pointer to this object
+    dsp_add( framestore_perform, 7, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 4 ]->s_vec, sig[ 0 ]->s_n, object );
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_release - frees or unmaps the ring
+//------------------------------------------------------------------------------
+static void framestore_release( t_framestore* object )
+{
+    if( object->map )
+    {
+        framestore_unmap( object->map, object->map_size );
+    }
+    else if( object->store )
+    {
+        free( object->store );
+    }
+
+    object->store       = NULL;
+    object->map         = NULL;
+    object->map_size    = 0;
+    object->filled      = 0;
+    object->write_index = 0;
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_allocate - replaces the ring with an empty one of bins per part
+//------------------------------------------------------------------------------
+static void framestore_allocate( t_framestore* object, t_int bins )
+{
+    framestore_release( object );
+
+    object->bins = bins;
+
+    // the block size is unknown until dsp starts
+    if( bins > 0 )
+    {
+        object->store = ( t_float* )calloc( object->frames * bins * 2, sizeof( t_float ) );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_bang - records the next block's frame
+//------------------------------------------------------------------------------
+static void framestore_bang( t_framestore* object )
+{
+    object->record_once = TRUE;
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_record - turns recording of every block on or off
+//------------------------------------------------------------------------------
+static void framestore_record( t_framestore* object, t_floatarg record )
+{
+    object->record = record != 0;
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_clear - forgets the recorded frames
+//------------------------------------------------------------------------------
+static void framestore_clear( t_framestore* object )
+{
+    object->filled      = 0;
+    object->write_index = 0;
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_size - sets the number of frames the ring holds ( clears it )
+//------------------------------------------------------------------------------
+static void framestore_size( t_framestore* object, t_floatarg frames )
+{
+    object->frames = ClipMin( frames, 1 );
+
+    framestore_allocate( object, object->bins );
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_save - writes the recorded frames to a snapshot file, oldest first
+//------------------------------------------------------------------------------
+// the frames are written to a temporary file that then replaces the target,
+// since the ring may be a snapshot mapped from that very file, and truncating
+// it in place would empty the pages being copied
+//------------------------------------------------------------------------------
+static void framestore_save( t_framestore* object, t_symbol* name )
+{
+    char                 path[ MAXPDSTRING ];
+    char                 temp[ MAXPDSTRING ];
+    char*                map;
+    t_framestore_header* header;
+    size_t               frame_size = object->bins * 2 * sizeof( t_float );
+    size_t               size       = sizeof( t_framestore_header ) + object->filled * frame_size;
+    t_int                index;
+
+    if( object->filled == 0 )
+    {
+        pd_error( object, "framestore~: no frames to save" );
+        return;
+    }
+
+    canvas_makefilename( object->canvas, name->s_name, path, MAXPDSTRING );
+    sys_bashfilename( path, path );
+
+    if( snprintf( temp, MAXPDSTRING, "%s.tmp", path ) >= MAXPDSTRING )
+    {
+        pd_error( object, "framestore~: %s: path too long", path );
+        return;
+    }
+
+    map = ( char* )framestore_create_file( temp, size );
+
+    if( map == NULL )
+    {
+        pd_error( object, "framestore~: %s: could not write file", temp );
+        return;
+    }
+
+    header = ( t_framestore_header* )map;
+
+    memcpy( header->magic, FILE_MAGIC, sizeof( header->magic ) );
+
+    header->version    = FILE_VERSION;
+    header->float_size = sizeof( t_float );
+    header->bins       = ( int )object->bins;
+    header->frames     = ( int )object->filled;
+
+    for( index = 0 ; index < object->filled ; ++index )
+    {
+        memcpy( map + sizeof( t_framestore_header ) + index * frame_size, framestore_frame( object, index ), frame_size );
+    }
+
+    framestore_unmap( map, size );
+
+    if( !framestore_replace_file( temp, path ) )
+    {
+        pd_error( object, "framestore~: %s: could not replace file", path );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_open - maps a snapshot file as the ring
+//------------------------------------------------------------------------------
+static void framestore_open( t_framestore* object, t_symbol* name )
+{
+    char                 path[ MAXPDSTRING ];
+    void*                map;
+    size_t               size = 0;
+    t_framestore_header* header;
+
+    canvas_makefilename( object->canvas, name->s_name, path, MAXPDSTRING );
+    sys_bashfilename( path, path );
+
+    map = framestore_map_file( path, &size );
+
+    if( map == NULL )
+    {
+        pd_error( object, "framestore~: %s: could not open file", path );
+        return;
+    }
+
+    header = ( t_framestore_header* )map;
+
+    // check the header before trusting any sizes in it
+    if( size < sizeof( t_framestore_header )
+        || memcmp( header->magic, FILE_MAGIC, sizeof( header->magic ) )
+        || header->version    != FILE_VERSION
+        || header->float_size != sizeof( t_float )
+        || header->bins       <= 0
+        || header->frames     <= 0
+        || size < sizeof( t_framestore_header ) + ( size_t )header->frames * header->bins * 2 * sizeof( t_float ) )
+    {
+        pd_error( object, "framestore~: %s: not a framestore~ snapshot", path );
+        framestore_unmap( map, size );
+        return;
+    }
+
+    framestore_release( object );
+
+    object->map         = map;
+    object->map_size    = size;
+    object->store       = ( t_float* )( ( char* )map + sizeof( t_framestore_header ) );
+    object->bins        = header->bins;
+    object->frames      = header->frames;
+    object->filled      = header->frames;
+    object->write_index = 0;
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_new - instantiates a copy of this object in pd
+//------------------------------------------------------------------------------
+static void* framestore_new( t_floatarg frames )
+{
+    // create a pointer to this object
+    t_framestore* object = ( t_framestore* )pd_new( framestore_class );
+
+    // create two additional signal inlets
+    signalinlet_new( &object->object, object->inlet_2 );
+    signalinlet_new( &object->object, object->inlet_3 );
+
+    // create two signal outlets
+    outlet_new( &object->object, gensym( "signal" ) );
+    outlet_new( &object->object, gensym( "signal" ) );
+
+    // initialize variables
+    object->inlet_1     = 0;
+    object->inlet_2     = 0;
+    object->inlet_3     = 0;
+    object->store       = NULL;
+    object->frames      = frames > 0 ? ClipMin( frames, 1 ) : DEFAULT_FRAMES;
+    object->filled      = 0;
+    object->write_index = 0;
+    object->bins        = 0;
+    object->record      = FALSE;
+    object->record_once = FALSE;
+    object->map         = NULL;
+    object->map_size    = 0;
+    object->canvas      = canvas_getcurrent();
+
+    return object;
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_free - cleans up memory allocated by this object
+//------------------------------------------------------------------------------
+static void framestore_free( t_framestore* object )
+{
+    framestore_release( object );
+}
+
+
+//------------------------------------------------------------------------------
+// framestore_tilde_setup - describes the attributes of this object to pd so it may be properly instantiated
+// (must always be named with _tilde replacing ~ in the object name)
+//------------------------------------------------------------------------------
+void framestore_tilde_setup( void )
+{
+    // creates an instance of this object and describes it to pd
+    framestore_class = class_new( gensym( "framestore~" ), ( t_newmethod )framestore_new, ( t_method )framestore_free, sizeof( t_framestore ), 0, A_DEFFLOAT, 0 );
+
+    // declares leftmost inlet as a signal inlet
+    CLASS_MAINSIGNALIN( framestore_class, t_framestore, inlet_1 );
+
+    // installs framestore_dsp so that it will be called when dsp is turned on
+    class_addmethod( framestore_class, ( t_method )framestore_dsp, gensym( "dsp" ), 0 );
+
+    // installs framestore_bang to record a single frame
+    class_addbang( framestore_class, framestore_bang );
+
+    // installs framestore_record to respond to "record" message
+    class_addmethod( framestore_class, ( t_method )framestore_record, gensym( "record" ), A_FLOAT, 0 );
+
+    // installs framestore_clear to respond to "clear" message
+    class_addmethod( framestore_class, ( t_method )framestore_clear, gensym( "clear" ), 0 );
+
+    // installs framestore_size to respond to "size" message
+    class_addmethod( framestore_class, ( t_method )framestore_size, gensym( "size" ), A_FLOAT, 0 );
+
+    // installs framestore_save to respond to "save" message
+    class_addmethod( framestore_class, ( t_method )framestore_save, gensym( "save" ), A_SYMBOL, 0 );
+
+    // installs framestore_open to respond to "open" message
+    class_addmethod( framestore_class, ( t_method )framestore_open, gensym( "open" ), A_SYMBOL, 0 );
+}
+
+
+//------------------------------------------------------------------------------
+// EOF
+//------------------------------------------------------------------------------
@@ -82,6 +82,9 @@ typedef struct freqsieve
     // flag for remainder mode of this object
     t_int remainder_flag;
 
+    // nonzero when sieved bins are output as a sparse partial list
+    t_int sparse;
+
 } t_freqsieve;
 
 
@@ -92,6 +95,7 @@ static t_int* freqsieve_perform          ( t_int* io );
 static t_int* freqsieve_perform_remainder( t_int* io );
 static void   freqsieve_dsp              ( t_freqsieve* object, t_signal **sig );
 static void   freqsieve_overlap          ( t_freqsieve* object, t_floatarg overlap );
+static void   freqsieve_sparse           ( t_freqsieve* object, t_floatarg sparse );
 static void*  freqsieve_new              ( t_symbol* symbol, t_int items, t_atom* list );
 static void   freqsieve_free             ( t_freqsieve* object );
 void          freqsieve_tilde_setup      ( void );
@@ -174,13 +178,18 @@ static t_int* freqsieve_perform( t_int* io )
         }
     }
 
-    // clear the output arrays
-    memset( out1, 0, memory_size );
-    memset( out2, 0, memory_size );
-
+    // pack the sieved bins into a partial list on outlet 1, leaving outlet 2 silent
+    if( object->sparse )
+    {
+        PartialsPack( out1, frames, mag_array, freq_array, frames );
+        memset( out2, 0, memory_size );
+    }
     // copy temporary arrays to output arrays
-    memcpy( out1, mag_array,  memory_size );
-    memcpy( out2, freq_array, memory_size );
+    else
+    {
+        memcpy( out1, mag_array,  memory_size );
+        memcpy( out2, freq_array, memory_size );
+    }
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
@@ -295,9 +304,18 @@ static t_int* freqsieve_perform_remainder( t_int* io )
     memset( out3, 0, memory_size );
     memset( out4, 0, memory_size );
 
-    // copy temporary arrays to output arrays
-    memcpy( out1, mag_array,  memory_size );
-    memcpy( out2, freq_array, memory_size );
+    // copy temporary arrays to output arrays, packing the sieved bins into a
+    // partial list on outlet 1 in sparse mode
+    if( object->sparse )
+    {
+        PartialsPack( out1, frames, mag_array, freq_array, frames );
+    }
+    else
+    {
+        memcpy( out1, mag_array,  memory_size );
+        memcpy( out2, freq_array, memory_size );
+    }
+
     memcpy( out3, mag_remain_array, memory_size );
     memcpy( out4, freq_remain_array, memory_size );
 
@@ -315,18 +333,24 @@ static void freqsieve_dsp( t_freqsieve* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
+    // only reallocate memory when the vector size has changed
+    t_int resize = ( memory_size != object->memory_size );
+
     // store values for use in dsp loop
     object->memory_size = memory_size;
     object->sample_rate = sig[ 0 ]->s_sr;
 
     if( object->remainder_flag )
     {
-        // allocate enough memory to hold vectors of data
-        object->freq_array        = realloc( object->freq_array,        memory_size );
-        object->mag_array         = realloc( object->mag_array,         memory_size );
-        object->freq_remain_array = realloc( object->freq_remain_array, memory_size );
-        object->mag_remain_array  = realloc( object->mag_remain_array,  memory_size );
-        object->zero_index_array  = realloc( object->zero_index_array,  memory_size );
+        if( resize )
+        {
+            // allocate enough memory to hold vectors of data
+            object->freq_array        = realloc( object->freq_array,        memory_size );
+            object->mag_array         = realloc( object->mag_array,         memory_size );
+            object->freq_remain_array = realloc( object->freq_remain_array, memory_size );
+            object->mag_remain_array  = realloc( object->mag_remain_array,  memory_size );
+            object->zero_index_array  = realloc( object->zero_index_array,  memory_size );
+        }
 
         // dsp_add arguments
         //----------------------------------------------------------------------
@@ -344,9 +368,12 @@ static void freqsieve_dsp( t_freqsieve* object, t_signal **sig )
     }
     else
     {
-        // allocate enough memory to hold vectors of data
-        object->freq_array = realloc( object->freq_array, memory_size );
-        object->mag_array  = realloc( object->mag_array,  memory_size );
+        if( resize )
+        {
+            // allocate enough memory to hold vectors of data
+            object->freq_array = realloc( object->freq_array, memory_size );
+            object->mag_array  = realloc( object->mag_array,  memory_size );
+        }
 
         // dsp_add arguments
         //----------------------------------------------------------------------
@@ -377,6 +404,15 @@ static void freqsieve_overlap( t_freqsieve* object, t_floatarg overlap )
 }
 
 
+//------------------------------------------------------------------------------
+// freqsieve_sparse - switches between dense vectors and a sparse partial list
+//------------------------------------------------------------------------------
+static void freqsieve_sparse( t_freqsieve* object, t_floatarg sparse )
+{
+    object->sparse = ( sparse != 0 );
+}
+
+
 //------------------------------------------------------------------------------
 // freqsieve_new - instantiates a copy of this object in pd
 //------------------------------------------------------------------------------
@@ -403,6 +439,7 @@ static void* freqsieve_new(  t_symbol* symbol, t_int items, t_atom* list )
     object->zero_index_array  = NULL;
     object->overlap           = 1;
     object->remainder_flag    = FALSE;
+    object->sparse            = FALSE;
 
     // temporary string for argument evaluation
     const char* symbol_string;
@@ -513,6 +550,9 @@ void freqsieve_tilde_setup( void )
 
     // associate a method with the "overlap" symbol for subsequent overlap inlet handling
     class_addmethod( freqsieve_class, ( t_method )freqsieve_overlap, gensym( "overlap" ), A_FLOAT, 0 );
+
+    // installs freqsieve_sparse to respond to "sparse" message
+    class_addmethod( freqsieve_class, ( t_method )freqsieve_sparse, gensym( "sparse" ), A_FLOAT, 0 );
 }
 
 
@@ -66,6 +66,12 @@ typedef struct freqtocar
     // the local sample rate
     t_float sample_rate;
 
+    // memory size of the phase accumulator
+    t_int memory_size;
+
+    // dsp timing record read by spectprof ( empty unless profiling is compiled in )
+    PROFILE_MEMBER
+
 } t_freqtocar;
 
 
@@ -74,6 +80,7 @@ typedef struct freqtocar
 //------------------------------------------------------------------------------
 static t_int* freqtocar_perform     ( t_int* io );
 static void   freqtocar_dsp         ( t_freqtocar* object, t_signal **sig );
+static void   freqtocar_reset       ( t_freqtocar* object );
 static void   freqtocar_overlap     ( t_freqtocar* object, t_floatarg overlap );
 static void*  freqtocar_new         ( t_symbol* symbol, t_int items, t_atom* list );
 static void   freqtocar_free        ( t_freqtocar* object );
@@ -122,15 +129,15 @@ static t_int* freqtocar_perform( t_int* io )
         // magnitude ( inlet 1 )
         //----------------------------------------------------------------------
 
-        // store magnitude value
-        magnitude = in1[ n ];
+        // store magnitude value, flushing a decayed magnitude
+        magnitude = FlushDenormal( in1[ n ] );
 
 
         // frequency to phase ( inlet 2 )
         //----------------------------------------------------------------------
 
-        // store input frequency
-        frequency = in2[ n ];
+        // store input frequency, flushing a decayed frequency
+        frequency = FlushDenormal( in2[ n ] );
 
         // calculate center frequency of each bin
         bin_freq = ( ( t_float )n / frames ) * sample_rate;
@@ -141,8 +148,8 @@ static t_int* freqtocar_perform( t_int* io )
         // calculate phase of each bins contents
         phase = bin_offset / ( ( ( sample_rate * overlap ) / frames ) / C_2_PI );
 
-        // accumulate phase in each bin
-        phase_accum[ n ] += phase;
+        // accumulate phase in each bin, flushing a phase decayed to nothing
+        phase_accum[ n ] = FlushDenormal( phase_accum[ n ] + phase );
 
         // note
         //----------------------------------------------------------------------
@@ -173,14 +180,24 @@ static void freqtocar_dsp( t_freqtocar* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate enough memory to hold signal vector data
-    object->phase_accum = realloc( object->phase_accum,  memory_size );
+    // only reallocate and clear memory when the vector size or sample rate has changed
+    if( ( memory_size != object->memory_size ) || ( sig[ 0 ]->s_sr != object->sample_rate ) )
+    {
+        // allocate enough memory to hold signal vector data
+        object->phase_accum = realloc( object->phase_accum,  memory_size );
+
+        // set allocated memory values to 0
+        memset( object->phase_accum, 0, memory_size );
+
+        // store sample rate for use in dsp loop
+        object->sample_rate = sig[ 0 ]->s_sr;
 
-    // set allocated memory values to 0
-    memset( object->phase_accum, 0, memory_size );
+        // store memory size for reset and dsp change detection
+        object->memory_size = memory_size;
+    }
 
-    // store sample rate for use in dsp loop
-    object->sample_rate = sig[ 0 ]->s_sr;
+    // start timing this object ( when profiling is compiled in )
+    PROFILE_DSP_BEGIN( object );
 
     // dsp_add arguments
     //--------------------------------------------------------------------------
@@ -203,6 +220,22 @@ static void freqtocar_dsp( t_freqtocar* object, t_signal **sig )
         sig[ 0 ]->s_n,
         object
     );
+
+    // stop timing this object
+    PROFILE_DSP_END( object );
+}
+
+
+//------------------------------------------------------------------------------
+// freqtocar_reset - clears the accumulated phase
+//------------------------------------------------------------------------------
+static void freqtocar_reset( t_freqtocar* object )
+{
+    // only clear memory that has been allocated
+    if( object->phase_accum )
+    {
+        memset( object->phase_accum, 0, object->memory_size );
+    }
 }
 
 
@@ -223,6 +256,9 @@ static void* freqtocar_new( t_symbol* symbol, t_int items, t_atom* list )
     // create a pointer to this object
     t_freqtocar* object = ( t_freqtocar* )pd_new( freqtocar_class );
 
+    // register with the dsp profiler
+    PROFILE_REGISTER( object, "freqtocar~" );
+
     // create a second signal inlet
     signalinlet_new( &object->object, object->inlet_2 );
 
@@ -235,6 +271,7 @@ static void* freqtocar_new( t_symbol* symbol, t_int items, t_atom* list )
 
     // initialize variables
     object->phase_accum = NULL;
+    object->memory_size = 0;
 
     // handle overlap argument
     if( items )
@@ -255,6 +292,9 @@ static void* freqtocar_new( t_symbol* symbol, t_int items, t_atom* list )
 //------------------------------------------------------------------------------
 static void freqtocar_free( t_freqtocar* object )
 {
+    // unregister from the dsp profiler
+    PROFILE_UNREGISTER( object );
+
     // if memory is allocated
     if( object->phase_accum )
     {
@@ -284,6 +324,9 @@ void freqtocar_tilde_setup( void )
 
     // associate a method with the "overlap" symbol for subsequent overlap inlet handling
     class_addmethod( freqtocar_class, ( t_method )freqtocar_overlap, gensym( "overlap" ), A_FLOAT, 0 );
+
+    // installs freqtocar_reset to respond to "reset" message
+    class_addmethod( freqtocar_class, ( t_method )freqtocar_reset, gensym( "reset" ), 0 );
 }
 
 
@@ -63,6 +63,12 @@ typedef struct freqtophase
     // the local sample rate
     t_float sample_rate;
 
+    // memory size of the phase accumulator
+    t_int memory_size;
+
+    // dsp timing record read by spectprof ( empty unless profiling is compiled in )
+    PROFILE_MEMBER
+
 } t_freqtophase;
 
 
@@ -71,6 +77,7 @@ typedef struct freqtophase
 //------------------------------------------------------------------------------
 static t_int* freqtophase_perform     ( t_int* io );
 static void   freqtophase_dsp         ( t_freqtophase* object, t_signal **sig );
+static void   freqtophase_reset       ( t_freqtophase* object );
 static void   freqtophase_overlap     ( t_freqtophase* object, t_floatarg overlap );
 static void*  freqtophase_new         ( t_symbol* symbol, t_int items, t_atom* list );
 static void   freqtophase_free        ( t_freqtophase* object );
@@ -126,8 +133,9 @@ static t_int* freqtophase_perform( t_int* io )
         // accumulate phase with phase of last bin
         phase += phase_accum[ n ];
 
-        // wrap accumulated phase between positive and negative pi
-        phase = WrapPosNegPi( phase );
+        // wrap accumulated phase between positive and negative pi, flushing
+        // a phase decayed to nothing
+        phase = FlushDenormal( WrapPosNegPi( phase ) );
 
         // store accumulated phase for next dsp loop
         phase_accum[ n ] = phase;
@@ -150,14 +158,24 @@ static void freqtophase_dsp( t_freqtophase* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate enough memory to hold signal vector data
-    object->phase_accum = realloc( object->phase_accum,  memory_size );
+    // only reallocate and clear memory when the vector size or sample rate has changed
+    if( ( memory_size != object->memory_size ) || ( sig[ 0 ]->s_sr != object->sample_rate ) )
+    {
+        // allocate enough memory to hold signal vector data
+        object->phase_accum = realloc( object->phase_accum,  memory_size );
+
+        // set allocated memory values to 0
+        memset( object->phase_accum, 0, memory_size );
+
+        // store sample rate for use in dsp loop
+        object->sample_rate = sig[ 0 ]->s_sr;
 
-    // set allocated memory values to 0
-    memset( object->phase_accum, 0, memory_size );
+        // store memory size for reset and dsp change detection
+        object->memory_size = memory_size;
+    }
 
-    // store sample rate for use in dsp loop
-    object->sample_rate = sig[ 0 ]->s_sr;
+    // start timing this object ( when profiling is compiled in )
+    PROFILE_DSP_BEGIN( object );
 
     // dsp_add arguments
     //--------------------------------------------------------------------------
@@ -176,6 +194,22 @@ static void freqtophase_dsp( t_freqtophase* object, t_signal **sig )
         sig[ 0 ]->s_n,
         object
     );
+
+    // stop timing this object
+    PROFILE_DSP_END( object );
+}
+
+
+//------------------------------------------------------------------------------
+// freqtophase_reset - clears the accumulated phase
+//------------------------------------------------------------------------------
+static void freqtophase_reset( t_freqtophase* object )
+{
+    // only clear memory that has been allocated
+    if( object->phase_accum )
+    {
+        memset( object->phase_accum, 0, object->memory_size );
+    }
 }
 
 
@@ -196,6 +230,9 @@ static void* freqtophase_new( t_symbol* symbol, t_int items, t_atom* list )
     // create a pointer to this object
     t_freqtophase* object = ( t_freqtophase* )pd_new( freqtophase_class );
 
+    // register with the dsp profiler
+    PROFILE_REGISTER( object, "freqtophase~" );
+
     // create a float inlet to receive overlap factor value
     inlet_new( &object->object, &object->object.ob_pd, gensym( "float" ), gensym( "overlap" ) );
 
@@ -204,6 +241,7 @@ static void* freqtophase_new( t_symbol* symbol, t_int items, t_atom* list )
 
     // initialize variables
     object->phase_accum = NULL;
+    object->memory_size = 0;
 
     // handle overlap argument
     if( items )
@@ -224,6 +262,9 @@ static void* freqtophase_new( t_symbol* symbol, t_int items, t_atom* list )
 //------------------------------------------------------------------------------
 static void freqtophase_free( t_freqtophase* object )
 {
+    // unregister from the dsp profiler
+    PROFILE_UNREGISTER( object );
+
     // if memory is allocated
     if( object->phase_accum )
     {
@@ -253,6 +294,9 @@ void freqtophase_tilde_setup( void )
 
     // associate a method with the "overlap" symbol for subsequent overlap inlet handling
     class_addmethod( freqtophase_class, ( t_method )freqtophase_overlap, gensym( "overlap" ), A_FLOAT, 0 );
+
+    // installs freqtophase_reset to respond to "reset" message
+    class_addmethod( freqtophase_class, ( t_method )freqtophase_reset, gensym( "reset" ), 0 );
 }
 
 
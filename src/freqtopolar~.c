@@ -63,6 +63,12 @@ typedef struct freqtopolar
     // the local sample rate
     t_float sample_rate;
 
+    // memory size of the phase accumulator
+    t_int memory_size;
+
+    // dsp timing record read by spectprof ( empty unless profiling is compiled in )
+    PROFILE_MEMBER
+
 } t_freqtopolar;
 
 
@@ -71,6 +77,7 @@ typedef struct freqtopolar
 //------------------------------------------------------------------------------
 static t_int* freqtopolar_perform     ( t_int* io );
 static void   freqtopolar_dsp         ( t_freqtopolar* object, t_signal **sig );
+static void   freqtopolar_reset       ( t_freqtopolar* object );
 static void   freqtopolar_overlap     ( t_freqtopolar* object, t_floatarg overlap );
 static void*  freqtopolar_new         ( t_symbol* symbol, t_int items, t_atom* list );
 static void   freqtopolar_free        ( t_freqtopolar* object );
@@ -166,14 +173,24 @@ static void freqtopolar_dsp( t_freqtopolar* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate enough memory to hold signal vector data
-    object->phase_accum = realloc( object->phase_accum,  memory_size );
+    // only reallocate and clear memory when the vector size or sample rate has changed
+    if( ( memory_size != object->memory_size ) || ( sig[ 0 ]->s_sr != object->sample_rate ) )
+    {
+        // allocate enough memory to hold signal vector data
+        object->phase_accum = realloc( object->phase_accum,  memory_size );
+
+        // set allocated memory values to 0
+        memset( object->phase_accum, 0, memory_size );
+
+        // store sample rate for use in dsp loop
+        object->sample_rate = sig[ 0 ]->s_sr;
 
-    // set allocated memory values to 0
-    memset( object->phase_accum, 0, memory_size );
+        // store memory size for reset and dsp change detection
+        object->memory_size = memory_size;
+    }
 
-    // store sample rate for use in dsp loop
-    object->sample_rate = sig[ 0 ]->s_sr;
+    // start timing this object ( when profiling is compiled in )
+    PROFILE_DSP_BEGIN( object );
 
     // dsp_add arguments
     //--------------------------------------------------------------------------
@@ -196,6 +213,22 @@ static void freqtopolar_dsp( t_freqtopolar* object, t_signal **sig )
         sig[ 0 ]->s_n,
         object
     );
+
+    // stop timing this object
+    PROFILE_DSP_END( object );
+}
+
+
+//------------------------------------------------------------------------------
+// freqtopolar_reset - clears the accumulated phase
+//------------------------------------------------------------------------------
+static void freqtopolar_reset( t_freqtopolar* object )
+{
+    // only clear memory that has been allocated
+    if( object->phase_accum )
+    {
+        memset( object->phase_accum, 0, object->memory_size );
+    }
 }
 
 
@@ -216,6 +249,9 @@ static void* freqtopolar_new( t_symbol* symbol, t_int items, t_atom* list )
     // create a pointer to this object
     t_freqtopolar* object = ( t_freqtopolar* )pd_new( freqtopolar_class );
 
+    // register with the dsp profiler
+    PROFILE_REGISTER( object, "freqtopolar~" );
+
     // create a second signal inlet
     signalinlet_new( &object->object, object->inlet_2 );
 
@@ -228,6 +264,7 @@ static void* freqtopolar_new( t_symbol* symbol, t_int items, t_atom* list )
 
     // initialize variables
     object->phase_accum = NULL;
+    object->memory_size = 0;
 
     // handle overlap argument
     if( items )
@@ -248,6 +285,9 @@ static void* freqtopolar_new( t_symbol* symbol, t_int items, t_atom* list )
 //------------------------------------------------------------------------------
 static void freqtopolar_free( t_freqtopolar* object )
 {
+    // unregister from the dsp profiler
+    PROFILE_UNREGISTER( object );
+
     // if memory is allocated
     if( object->phase_accum )
     {
@@ -277,6 +317,9 @@ void freqtopolar_tilde_setup( void )
 
     // associate a method with the "overlap" symbol for subsequent overlap inlet handling
     class_addmethod( freqtopolar_class, ( t_method )freqtopolar_overlap, gensym( "overlap" ), A_FLOAT, 0 );
+
+    // installs freqtopolar_reset to respond to "reset" message
+    class_addmethod( freqtopolar_class, ( t_method )freqtopolar_reset, gensym( "reset" ), 0 );
 }
 
 
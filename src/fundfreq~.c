@@ -84,6 +84,12 @@ typedef struct fundfreq
     t_int min_freq;
     t_int max_freq;
 
+    // the detected frequency mirrored on a control outlet
+    t_control control;
+
+    // dsp timing record read by spectprof ( empty unless profiling is compiled in )
+    PROFILE_MEMBER
+
 } t_fundfreq;
 
 
@@ -92,6 +98,7 @@ typedef struct fundfreq
 //------------------------------------------------------------------------------
 static t_int* fundfreq_perform     ( t_int* io );
 static void   fundfreq_dsp         ( t_fundfreq* object, t_signal **sig );
+static void   fundfreq_reset       ( t_fundfreq* object );
 static void   fundfreq_overlap     ( t_fundfreq* object, t_floatarg overlap );
 static void   fundfreq_min_freq    ( t_fundfreq* object, t_floatarg frequency );
 static void   fundfreq_max_freq    ( t_fundfreq* object, t_floatarg frequency );
@@ -299,14 +306,11 @@ static t_int* fundfreq_perform( t_int* io )
     // output the detected pitch
     //--------------------------------------------------------------------------
 
-    // reset vector iterator
-    n = -1;
-
     // set all outlet values to the pitch's frequency
-    while( ++n < frames )
-    {
-        out[ n ] = frequency;
-    }
+    FillVector( out, frequency, frames );
+
+    // send the frequency out the control outlet when it changes
+    ControlSet( &object->control, &frequency );
 
 
     // return the dsp input/output array address plus one more than its size
@@ -323,23 +327,31 @@ static void fundfreq_dsp( t_fundfreq* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate enough memory to hold signal vector data
-    object->in1_trim   = realloc( object->in1_trim,   memory_size );
-    object->product    = realloc( object->product,    memory_size );
-    object->downsample = realloc( object->downsample, memory_size );
-    object->delta_temp = realloc( object->delta_temp, memory_size );
-    object->delta_old  = realloc( object->delta_old,  memory_size );
-    object->bin_freqs  = realloc( object->bin_freqs,  memory_size );
-
-    // set allocated memory values to 0
-    memset( object->delta_temp, 0, memory_size );
-    memset( object->delta_old,  0, memory_size );
-    memset( object->bin_freqs,  0, memory_size );
-
-    // save memory size for use in dsp loop
-    object->memory_size = memory_size;
+    // only reallocate and clear memory when the vector size or sample rate has changed
+    if( ( memory_size != object->memory_size ) || ( sig[ 0 ]->s_sr != object->sample_rate ) )
+    {
+        // allocate enough memory to hold signal vector data
+        object->in1_trim   = realloc( object->in1_trim,   memory_size );
+        object->product    = realloc( object->product,    memory_size );
+        object->downsample = realloc( object->downsample, memory_size );
+        object->delta_temp = realloc( object->delta_temp, memory_size );
+        object->delta_old  = realloc( object->delta_old,  memory_size );
+        object->bin_freqs  = realloc( object->bin_freqs,  memory_size );
+
+        // set allocated memory values to 0
+        memset( object->delta_temp, 0, memory_size );
+        memset( object->delta_old,  0, memory_size );
+        memset( object->bin_freqs,  0, memory_size );
+
+        // save memory size for use in dsp loop
+        object->memory_size = memory_size;
+
+        // save sample rate for use in dsp loop
+        object->sample_rate = sig[ 0 ]->s_sr;
+    }
 
-    object->sample_rate = sig[ 0 ]->s_sr;
+    // start timing this object ( when profiling is compiled in )
+    PROFILE_DSP_BEGIN( object );
 
     // dsp_add arguments
     //--------------------------------------------------------------------------
@@ -351,6 +363,24 @@ static void fundfreq_dsp( t_fundfreq* object, t_signal **sig )
     // sample frames to process (vector size)
     // pointer to this object's data structure
     dsp_add( fundfreq_perform, 5, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 0 ]->s_n, object );
+
+    // stop timing this object
+    PROFILE_DSP_END( object );
+}
+
+
+//------------------------------------------------------------------------------
+// fundfreq_reset - clears the phase deviation and bin frequency history
+//------------------------------------------------------------------------------
+static void fundfreq_reset( t_fundfreq* object )
+{
+    // only clear memory that has been allocated
+    if( object->delta_old )
+    {
+        memset( object->delta_temp, 0, object->memory_size );
+        memset( object->delta_old,  0, object->memory_size );
+        memset( object->bin_freqs,  0, object->memory_size );
+    }
 }
 
 
@@ -412,6 +442,9 @@ static void* fundfreq_new( t_symbol* selector, t_int items, t_atom* list )
     // create a pointer to this object
     t_fundfreq* object = ( t_fundfreq* )pd_new( fundfreq_class );
 
+    // register with the dsp profiler
+    PROFILE_REGISTER( object, "fundfreq~" );
+
     // create a second signal inlet
     signalinlet_new( &object->object, object->inlet_2 );
 
@@ -427,6 +460,9 @@ static void* fundfreq_new( t_symbol* selector, t_int items, t_atom* list )
     // create a new signal outlet for this object
     outlet_new( &object->object, gensym( "signal" ) );
 
+    // create a control outlet for the detected frequency
+    ControlNew( &object->control, &object->object, 1 );
+
     // initialize memory pointers
     object->in1_trim   = NULL;
     object->product    = NULL;
@@ -493,6 +529,12 @@ static void* fundfreq_new( t_symbol* selector, t_int items, t_atom* list )
 //------------------------------------------------------------------------------
 static void fundfreq_free( t_fundfreq* object )
 {
+    // unregister from the dsp profiler
+    PROFILE_UNREGISTER( object );
+
+    // free the control outlet's clock
+    ControlFree( &object->control );
+
     // if memory is allocated
     if( object->product )
     {
@@ -559,6 +601,9 @@ void fundfreq_tilde_setup( void )
 
     // associate a method with the "freq_max" symbol for max freq inlet handling
     class_addmethod( fundfreq_class, ( t_method )fundfreq_max_freq, gensym( "max_freq" ), A_FLOAT, 0 );
+
+    // installs fundfreq_reset to respond to "reset" message
+    class_addmethod( fundfreq_class, ( t_method )fundfreq_reset, gensym( "reset" ), 0 );
 }
 
 
@@ -148,12 +148,16 @@ static void harmprod_dsp( t_harmprod* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate enough memory to hold signal vector data
-    object->product    = realloc( object->product,    memory_size );
-    object->downsample = realloc( object->downsample, memory_size );
+    // only reallocate memory when the vector size has changed
+    if( memory_size != object->memory_size )
+    {
+        // allocate enough memory to hold signal vector data
+        object->product    = realloc( object->product,    memory_size );
+        object->downsample = realloc( object->downsample, memory_size );
 
-    // save memory size for use in dsp loop
-    object->memory_size = memory_size;
+        // save memory size for use in dsp loop
+        object->memory_size = memory_size;
+    }
 
     // dsp_add arguments
     //--------------------------------------------------------------------------
@@ -0,0 +1,303 @@
+//------------------------------------------------------------------------------
+//  Pd Spectral Toolkit
+//
+//  magscale~.c
+//
+//  Scales the magnitude of cartesian bins without converting to polar
+//
+//  Copyright (C) 2019 Cooper Baker. All Rights Reserved.
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// headers
+//------------------------------------------------------------------------------
+
+// main header for pd
+#include "m_pd.h"
+
+// utility header for Pd Spectral Toolkit project
+#include "utility.h"
+
+// disable compiler warnings on windows
+#ifdef NT
+#pragma warning( disable : 4244 )
+#pragma warning( disable : 4305 )
+#endif
+
+
+//------------------------------------------------------------------------------
+// magscale_class - pointer to this object's definition
+//------------------------------------------------------------------------------
+static t_class* magscale_class;
+
+
+//------------------------------------------------------------------------------
+// magscale - data structure holding this object's data
+//------------------------------------------------------------------------------
+typedef struct magscale
+{
+    // this object - must always be first variable in struct
+    t_object object;
+
+    // needed for CLASS_MAINSIGNALIN macro call in magscale_tilde_setup
+    t_float inlet_1;
+
+    // needed for signalinlet_new calls in magscale_new
+    t_float inlet_2;
+    t_float inlet_3;
+
+    // nonzero when created with a magnitude range
+    t_int gate;
+
+    // min / max magnitudes
+    t_float mag_min;
+    t_float mag_max;
+
+} t_magscale;
+
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+static t_int* magscale_perform      ( t_int* io );
+static t_int* magscale_gate_perform ( t_int* io );
+static void   magscale_dsp          ( t_magscale* object, t_signal **sig );
+static void*  magscale_new          ( t_symbol* selector, t_int items, t_atom* list );
+void          magscale_tilde_setup  ( void );
+
+
+//------------------------------------------------------------------------------
+// magscale_perform - the signal processing function of this object
+//------------------------------------------------------------------------------
+static t_int* magscale_perform( t_int* io )
+{
+    // store variables from dsp input/output array
+    t_float* in1    = ( t_float* )( io[ 1 ] );
+    t_float* in2    = ( t_float* )( io[ 2 ] );
+    t_float* in3    = ( t_float* )( io[ 3 ] );
+    t_float* out1   = ( t_float* )( io[ 4 ] );
+    t_float* out2   = ( t_float* )( io[ 5 ] );
+    t_int    frames = ( t_int    )( io[ 6 ] );
+
+    // signal vector iterator variable
+    t_int n = -1;
+
+    // allocate calculation variable
+    t_float gain;
+
+    // the dsp loop - scaling both parts of a bin scales its magnitude and
+    // leaves its phase alone, so no polar conversion is needed
+    while( ++n < frames )
+    {
+        // store gain sample
+        gain = in3[ n ];
+
+        // store output samples
+        out1[ n ] = in1[ n ] * gain;
+        out2[ n ] = in2[ n ] * gain;
+    }
+
+    // return the dsp input/output array address plus one more than its size
+    // to provide a pointer to the next perform function in pd's call list
+    return &( io[ 7 ] );
+}
+
+
+//------------------------------------------------------------------------------
+// magscale_gate_perform - the signal processing function of this object
+//------------------------------------------------------------------------------
+// bins are compared by squared magnitude against the squared range, so the
+// gate needs no square root
+//------------------------------------------------------------------------------
+static t_int* magscale_gate_perform( t_int* io )
+{
+    // store variables from dsp input/output array
+    t_float*    in1    = ( t_float*    )( io[ 1 ] );
+    t_float*    in2    = ( t_float*    )( io[ 2 ] );
+    t_float*    in3    = ( t_float*    )( io[ 3 ] );
+    t_float*    out1   = ( t_float*    )( io[ 4 ] );
+    t_float*    out2   = ( t_float*    )( io[ 5 ] );
+    t_int       frames = ( t_int       )( io[ 6 ] );
+    t_magscale* object = ( t_magscale* )( io[ 7 ] );
+
+    // constrain magnitudes to positive values
+    t_float mag_min = ClipMin( object->mag_min, 0 );
+    t_float mag_max = ClipMin( object->mag_max, 0 );
+
+    // the range may be given in either order
+    t_float lower = mag_min < mag_max ? mag_min : mag_max;
+    t_float upper = mag_min < mag_max ? mag_max : mag_min;
+
+    // square the range, keeping the upper bound finite
+    lower = lower * lower;
+    upper = upper < SquareRoot( C_FLOAT_MAX ) ? upper * upper : C_FLOAT_MAX;
+
+    // signal vector iterator variable
+    t_int n = -1;
+
+    // allocate calculation variables
+    t_float real;
+    t_float imag;
+    t_float power;
+    t_float gain;
+
+    // the dsp loop
+    while( ++n < frames )
+    {
+        // store input samples
+        real = in1[ n ];
+        imag = in2[ n ];
+
+        // squared magnitude of the bin
+        power = real * real + imag * imag;
+
+        // zero the gain of bins outside the range
+        gain = in3[ n ] * ( ( power >= lower ) & ( power <= upper ) );
+
+        // store output samples
+        out1[ n ] = real * gain;
+        out2[ n ] = imag * gain;
+    }
+
+    // return the dsp input/output array address plus one more than its size
+    // to provide a pointer to the next perform function in pd's call list
+    return &( io[ 8 ] );
+}
+
+
+//------------------------------------------------------------------------------
+// magscale_dsp - installs this object's dsp function in pd's callback list
+//------------------------------------------------------------------------------
+static void magscale_dsp( t_magscale* object, t_signal **sig )
+{
+    // the left inlet sets the channel count and the other inlets' channels
+    // repeat across it when they have fewer
+    t_int frames     = sig[ 0 ]->s_n;
+    t_int channels   = SignalChannels( sig[ 0 ] );
+    t_int channels_2 = SignalChannels( sig[ 1 ] );
+    t_int channels_3 = SignalChannels( sig[ 2 ] );
+    t_int channel;
+
+    // give the outlets as many channels as the left inlet
+    SignalSetChannels( &sig[ 3 ], channels );
+    SignalSetChannels( &sig[ 4 ], channels );
+
+    // matching inlets scale every channel in one pass
+    if( channels_2 == channels && channels_3 == channels )
+    {
+        frames  *= channels;
+        channels = 1;
+    }
+
+    // dsp_add arguments
+    //--------------------------------------------------------------------------
+    // perform routine
+    // number of passed parameters
+    // inlet 1 sample vector
+    // inlet 2 sample vector
+    // inlet 3 sample vector
+    // outlet 1 sample vector
+    // outlet 2 sample vector
+    // sample frames to process (vector size times channels when inlets match)
+    // pointer to this object ( gate only )
+    for( channel = 0 ; channel < channels ; ++channel )
+    {
+        if( object->gate )
+        {
+            dsp_add( magscale_gate_perform, 7, sig[ 0 ]->s_vec + channel * frames, sig[ 1 ]->s_vec + ( channel % channels_2 ) * frames, sig[ 2 ]->s_vec + ( channel % channels_3 ) * frames, sig[ 3 ]->s_vec + channel * frames, sig[ 4 ]->s_vec + channel * frames, frames, object );
+        }
+        else
+        {
+            dsp_add( magscale_perform, 6, sig[ 0 ]->s_vec + channel * frames, sig[ 1 ]->s_vec + ( channel % channels_2 ) * frames, sig[ 2 ]->s_vec + ( channel % channels_3 ) * frames, sig[ 3 ]->s_vec + channel * frames, sig[ 4 ]->s_vec + channel * frames, frames );
+        }
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// magscale_new - instantiates a copy of this object in pd
+//------------------------------------------------------------------------------
+static void* magscale_new( t_symbol* selector, t_int items, t_atom* list )
+{
+    // create a pointer to this object
+    t_magscale* object = ( t_magscale* )pd_new( magscale_class );
+
+    // create two additional signal inlets
+    signalinlet_new( &object->object, object->inlet_2 );
+    signalinlet_new( &object->object, object->inlet_3 );
+
+    // initialize variables
+    object->inlet_1 = 0;
+    object->inlet_2 = 0;
+    object->inlet_3 = 0;
+    object->gate    = items > 0;
+    object->mag_min = 0;
+    object->mag_max = C_FLOAT_MAX;
+
+    // a magnitude range adds min / max float inlets
+    if( object->gate )
+    {
+        floatinlet_new( &object->object, &object->mag_min );
+        floatinlet_new( &object->object, &object->mag_max );
+    }
+
+    // create two signal outlets
+    outlet_new( &object->object, gensym( "signal" ) );
+    outlet_new( &object->object, gensym( "signal" ) );
+
+    // parse initialization arguments
+    //--------------------------------------------------------------------------
+    if( items > 0 )
+    {
+        if( list[ 0 ].a_type == A_FLOAT )
+        {
+            object->mag_min = atom_getfloatarg( 0, ( int )items, list );
+        }
+        else
+        {
+            pd_error( object, "magscale~: invalid argument 1 type" );
+        }
+    }
+
+    if( items > 1 )
+    {
+        if( list[ 1 ].a_type == A_FLOAT )
+        {
+            object->mag_max = atom_getfloatarg( 1, ( int )items, list );
+        }
+        else
+        {
+            pd_error( object, "magscale~: invalid argument 2 type" );
+        }
+    }
+
+    if( items > 2 )
+    {
+        pd_error( object, "magscale~: extra arguments ignored" );
+    }
+
+    return object;
+}
+
+
+//------------------------------------------------------------------------------
+// magscale_tilde_setup - describes the attributes of this object to pd so it may be properly instantiated
+// (must always be named with _tilde replacing ~ in the object name)
+//------------------------------------------------------------------------------
+void magscale_tilde_setup( void )
+{
+    // creates an instance of this object and describes it to pd
+    magscale_class = class_new( gensym( "magscale~" ), ( t_newmethod )magscale_new, 0, sizeof( t_magscale ), MULTICHANNEL, A_GIMME, 0 );
+
+    // declares leftmost inlet as a signal inlet
+    CLASS_MAINSIGNALIN( magscale_class, t_magscale, inlet_1 );
+
+    // installs magscale_dsp so that it will be called when dsp is turned on
+    class_addmethod( magscale_class, ( t_method )magscale_dsp, gensym( "dsp" ), 0 );
+}
+
+
+//------------------------------------------------------------------------------
+// EOF
+//------------------------------------------------------------------------------
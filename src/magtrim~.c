@@ -49,16 +49,10 @@ typedef struct magtrim
     // needed for signalinlet_new call in magtrim_new
     t_float inlet_2;
 
-    // min / max bin numbers
+    // min / max magnitudes
     t_float mag_min;
     t_float mag_max;
 
-    // memory size of a signal vector block
-    t_int memory_size;
-
-    // temporary outlet array
-    t_float* out_temp;
-
 } t_magtrim;
 
 
@@ -69,60 +63,48 @@ static t_int* magtrim_perform     ( t_int* io );
 static t_int* magtrim_arg_perform ( t_int* io );
 static void   magtrim_dsp         ( t_magtrim* object, t_signal** sig );
 static void   magtrim_arg_dsp     ( t_magtrim* object, t_signal** sig );
+static void   magtrim_gate        ( t_float* in1, t_float* in2, t_float* out1, t_float* out2, t_float mag_min, t_float mag_max, t_int frames );
 static void*  magtrim_new         ( t_symbol* selector, t_int items, t_atom* list );
-static void   magtrim_free        ( t_magtrim* object );
 void          magtrim_tilde_setup ( void );
 
 
 //------------------------------------------------------------------------------
-// magtrim_perform - the signal processing function of this object
+// magtrim_gate - zeroes bins outside of the clipped magnitude range in one pass
 //------------------------------------------------------------------------------
-static t_int* magtrim_perform( t_int* io )
+static void magtrim_gate( t_float* in1, t_float* in2, t_float* out1, t_float* out2, t_float mag_min, t_float mag_max, t_int frames )
 {
-    // store variables from dsp input/output array
-    t_float*   in1    = ( t_float*   )( io[ 1 ] );
-    t_float*   in2    = ( t_float*   )( io[ 2 ] );
-    t_float*   in3    = ( t_float*   )( io[ 3 ] );
-    t_float*   in4    = ( t_float*   )( io[ 4 ] );
-    t_float*   out1   = ( t_float*   )( io[ 5 ] );
-    t_float*   out2   = ( t_float*   )( io[ 6 ] );
-    t_int      frames = ( t_int      )( io[ 7 ] );
-
-    // store local copies of min/max magnitude
-    t_float mag_min = in3[ 0 ];
-    t_float mag_max = in4[ 0 ];
-    t_float mag_temp;
-
-    // constrain and store object clip parameters
+    // constrain magnitudes to positive values
     mag_min = ClipMin( mag_min, 0 );
     mag_max = ClipMin( mag_max, 0 );
 
-    // swap min/max if necessary
-    if( mag_min > mag_max )
+    // the range may be given in either order
+    if( mag_max < mag_min )
     {
-        mag_temp = mag_min;
-        mag_min  = mag_max;
-        mag_max  = mag_min;
+        GateRange( in1, in2, out1, out2, mag_max, mag_min, FALSE, frames );
     }
-
-    // spectral data iterator
-    t_int n = -1;
-
-    // iterate through the spectral data
-    while( ++n < frames )
+    else
     {
-        // only copy bin data within min/max range
-        if( ( in1[ n ] >= mag_min ) && ( in1[ n ] <= mag_max ) )
-        {
-            out1[ n ] = in1[ n ];
-            out2[ n ] = in2[ n ];
-        }
-        else
-        {
-            out1[ n ] = 0;
-            out2[ n ] = 0;
-        }
+        GateRange( in1, in2, out1, out2, mag_min, mag_max, FALSE, frames );
     }
+}
+
+
+//------------------------------------------------------------------------------
+// magtrim_perform - the signal processing function of this object
+//------------------------------------------------------------------------------
+static t_int* magtrim_perform( t_int* io )
+{
+    // store variables from dsp input/output array
+    t_float* in1    = ( t_float* )( io[ 1 ] );
+    t_float* in2    = ( t_float* )( io[ 2 ] );
+    t_float* in3    = ( t_float* )( io[ 3 ] );
+    t_float* in4    = ( t_float* )( io[ 4 ] );
+    t_float* out1   = ( t_float* )( io[ 5 ] );
+    t_float* out2   = ( t_float* )( io[ 6 ] );
+    t_int    frames = ( t_int    )( io[ 7 ] );
+
+    // min/max magnitudes are read once per block
+    magtrim_gate( in1, in2, out1, out2, in3[ 0 ], in4[ 0 ], frames );
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
@@ -131,7 +113,7 @@ static t_int* magtrim_perform( t_int* io )
 
 
 //------------------------------------------------------------------------------
-// magtrim_perform - the signal processing function of this object
+// magtrim_arg_perform - the signal processing function of this object
 //------------------------------------------------------------------------------
 static t_int* magtrim_arg_perform( t_int* io )
 {
@@ -143,51 +125,7 @@ static t_int* magtrim_arg_perform( t_int* io )
     t_int      frames = ( t_int      )( io[ 5 ] );
     t_magtrim* object = ( t_magtrim* )( io[ 6 ] );
 
-    // store local pointer to temporary array
-    t_float* out_temp = object->out_temp;
-
-    // store local copies of min/max magnitude
-    t_float mag_min = object->mag_min;
-    t_float mag_max = object->mag_max;
-    t_float mag_temp;
-
-    // constrain and store object clip parameters
-    mag_min = ClipMin( mag_min, 0 );
-    mag_max = ClipMin( mag_max, 0 );
-
-    // swap min/max if necessary
-    if( mag_min > mag_max )
-    {
-        mag_temp = mag_min;
-        mag_min  = mag_max;
-        mag_max  = mag_min;
-    }
-
-    // zero out the temporary array
-    memset( out_temp, 0, object->memory_size );
-
-    // spectral data iterator
-    t_int n = -1;
-
-    // iterate through the spectral data
-    while( ++n < frames )
-    {
-        // only copy bin data within min/max range
-        if( ( in1[ n ] >= mag_min ) && ( in1[ n ] <= mag_max ) )
-        {
-            //out1[ n ] = in1[ n ];
-            out_temp[ n ] = in1[ n ];
-            out2[ n ] = in2[ n ];
-        }
-        else
-        {
-            //out1[ n ] = 0;
-            out_temp[ n ] = 0;
-            out2[ n ] = 0;
-        }
-    }
-
-    memcpy( out1, out_temp, object->memory_size );
+    magtrim_gate( in1, in2, out1, out2, object->mag_min, object->mag_max, frames );
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
@@ -200,12 +138,6 @@ static t_int* magtrim_arg_perform( t_int* io )
 //------------------------------------------------------------------------------
 static void magtrim_dsp( t_magtrim* object, t_signal** sig )
 {
-    // calculate memory size of signal vector for memset and realloc
-    t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
-
-    // save memory_size for use in dsp loop
-    object->memory_size = memory_size;
-
     // dsp_add arguments
     //--------------------------------------------------------------------------
     // perform routine
@@ -217,7 +149,7 @@ static void magtrim_dsp( t_magtrim* object, t_signal** sig )
     // outlet 1 sample vector
     // outlet 2 sample vector
     // sample frames to process (vector size)
-    dsp_add( magtrim_perform, 7, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 4 ]->s_vec, sig[ 5 ]->s_vec, sig[ 0 ]->s_n, object );
+    dsp_add( magtrim_perform, 7, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 4 ]->s_vec, sig[ 5 ]->s_vec, sig[ 0 ]->s_n );
 }
 
 
@@ -226,18 +158,6 @@ static void magtrim_dsp( t_magtrim* object, t_signal** sig )
 //------------------------------------------------------------------------------
 static void magtrim_arg_dsp( t_magtrim* object, t_signal** sig )
 {
-    // calculate memory size of signal vector for memset and realloc
-    t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
-
-    // save memory_size for use in dsp loop
-    object->memory_size = memory_size;
-
-    // allocate enough memory to hold signal vector data
-    object->out_temp = realloc( object->out_temp, memory_size );
-
-    // set allocated memory values to 0
-    memset( object->out_temp, 0, memory_size );
-
     // dsp_add arguments
     //--------------------------------------------------------------------------
     // perform routine
@@ -277,9 +197,6 @@ static void* magtrim_new( t_symbol* selector, t_int items, t_atom* list )
         object->inlet_1 = 0;
         object->inlet_2 = 0;
 
-        // initialize memory pointer
-        object->out_temp = NULL;
-
         // parse initialization arguments
         //----------------------------------------------------------------------
         if( items > 0 )
@@ -340,23 +257,6 @@ static void* magtrim_new( t_symbol* selector, t_int items, t_atom* list )
 }
 
 
-//------------------------------------------------------------------------------
-// magtrim_free - cleans up memory allocated by this object
-//------------------------------------------------------------------------------
-void magtrim_free( t_magtrim* object )
-{
-    // if memory is allocated
-    if( object->out_temp )
-    {
-        // deallocate the memory
-        free( object->out_temp );
-
-        // set the pointer to null
-        object->out_temp = NULL;
-    }
-}
-
-
 //------------------------------------------------------------------------------
 // magtrim_tilde_setup - describes the attributes of this object to pd so it may be properly instantiated
 // (must always be named with _tilde replacing ~ in the object name)
@@ -367,7 +267,7 @@ void magtrim_tilde_setup( void )
     //--------------------------------------------------------------------------
 
     // creates an instance of this object and describes it to pd
-    magtrim_class = class_new( gensym( "magtrim~" ), ( t_newmethod )magtrim_new, ( t_method )magtrim_free, sizeof( t_magtrim ), 0, A_GIMME, 0 );
+    magtrim_class = class_new( gensym( "magtrim~" ), ( t_newmethod )magtrim_new, 0, sizeof( t_magtrim ), 0, A_GIMME, 0 );
 
     // declares leftmost inlet as a signal inlet
     CLASS_MAINSIGNALIN( magtrim_class, t_magtrim, inlet_1 );
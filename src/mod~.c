@@ -14,93 +14,45 @@
 
 
 //------------------------------------------------------------------------------
-// headers
-//------------------------------------------------------------------------------
-
-// main header for pd
-#include "m_pd.h"
-
-// utility header for Pd Spectral Toolkit project
-#include "utility.h"
-
-// disable compiler warnings on windows
-#ifdef NT
-#pragma warning( disable : 4244 )
-#pragma warning( disable : 4305 )
-#endif
-
-
-//------------------------------------------------------------------------------
-// mod_class - pointer to this object's definition
+// operator definition - expanded into this object's functions by operator.h
 //------------------------------------------------------------------------------
-static t_class* mod_class;
-static t_class* mod_arg_class;
+#define OPERATOR_PREFIX   mod
+#define OPERATOR_SYMBOL   "%~"
+#define OPERATOR_HELP     "mod~"
+#define OPERATOR_SETUP    setup_0x25_tilde
+#define OPERATOR_ARG
+#define OPERATION( a, b ) FixNan( Modulo( ( a ), ( b ) ) )
 
 
 //------------------------------------------------------------------------------
-// mod - data structure holding this object's data
+// headers
 //------------------------------------------------------------------------------
-typedef struct mod
-{
-    // this object - must always be first variable in struct
-    t_object object;
 
-    // needed for CLASS_MAINSIGNALIN macro call in mod_tilde_setup
-    t_float inlet_1;
-
-    // inlet 2 value
-    t_float inlet_2;
-
-} t_mod;
-
-
-//------------------------------------------------------------------------------
-// function prototypes
-//------------------------------------------------------------------------------
-static t_int* mod_perform      ( t_int* io );
-static t_int* mod_arg_perform  ( t_int* io );
-static void   mod_dsp          ( t_mod* object, t_signal **sig );
-static void   mod_arg_dsp      ( t_mod* object, t_signal **sig );
-static void*  mod_new          ( t_symbol *s, t_int argc, t_atom *argv );
-void          setup_0x25_tilde ( void );
+// shared operator kernel for Pd Spectral Toolkit project
+#include "operator.h"
 
 
 //------------------------------------------------------------------------------
-// mod_perform - the signal processing function of this object
+// constant definitions
 //------------------------------------------------------------------------------
-static t_int* mod_perform( t_int* io )
-{
-    // store variables from dsp input/output array
-    t_float* in1    = ( t_float* )( io[ 1 ] );
-    t_float* in2    = ( t_float* )( io[ 2 ] );
-    t_float* out    = ( t_float* )( io[ 3 ] );
-    t_int    frames = ( t_int    )( io[ 4 ] );
-
-    // signal vector iterator variable
-    t_int n = -1;
 
-    // allocate temporary remainder variable
-    t_float remainder;
-
-    // the dsp loop
-    while( ++n < frames )
-    {
-        // perform operation
-        remainder = Modulo( in1[ n ], in2[ n ] );
-
-        // fix not-a-number and store result in output array
-        out[ n ] = FixNan( remainder );
-    }
-
-    // return the dsp input/output array address plus one more than its size
-    // to provide a pointer to the next perform function in pd's call list
-    return &( io[ 5 ] );
-}
+// largest quotient the reciprocal path handles - its bits plus the divisor's
+// 24 mantissa bits fill a double's 53, so quotient * divisor stays exact
+#define MOD_QUOTIENT_LIMIT 536870912
 
 
 //------------------------------------------------------------------------------
 // mod_arg_perform - the signal processing function of this object with argument
 //------------------------------------------------------------------------------
+// the divisor is constant for the block, so its reciprocal replaces fmodf's
+// division with a multiply, and an integer conversion truncates the quotient
+// in a loop the compiler vectorizes
+//
+// the remainder is taken in double precision, where it is exact, and a
+// quotient rounded across an integer is corrected by one divisor, so results
+// match fmodf - blocks holding nan, infinity, or quotients past
+// MOD_QUOTIENT_LIMIT fall back to fmodf
+//------------------------------------------------------------------------------
 static t_int* mod_arg_perform( t_int* io )
 {
     // store variables from dsp input/output array
@@ -109,146 +61,71 @@ static t_int* mod_arg_perform( t_int* io )
     t_float* out    =  ( t_float* )( io[ 3 ] );
     t_int    frames =  ( t_int    )( io[ 4 ] );
 
+    // the remainder takes the sign of the input, so only the divisor's size matters
+    t_float     divisor = Absolute( arg );
+    t_floatbits bits    = FloatBits( divisor );
+    t_floatbits limit;
+
     // signal vector iterator variable
-    t_int n = -1;
+    t_int n;
 
-    // allocate temporary remainder variable
-    t_float remainder;
+    // allocate calculation variables
+    double reciprocal;
+    double quotient;
+    double remainder;
+    double toward;
+    t_int  large = 0;
 
-    // the dsp loop
-    while( ++n < frames )
+    // zero, subnormal, infinite, and nan divisors keep fmodf's handling
+    if( ( bits & FLOAT_EXPONENT_BITS ) == 0 || ( bits & FLOAT_EXPONENT_BITS ) == FLOAT_EXPONENT_BITS )
     {
-        // perform operation
-        remainder = Modulo( in[ n ], arg );
-
-        // fix not-a-number and store result in output array
-        out[ n ] = FixNan( remainder );
+        large = TRUE;
     }
-
-    // return the dsp input/output array address plus one more than its size
-    // to provide a pointer to the next perform function in pd's call list
-    return &( io[ 5 ] );
-}
-
-
-//------------------------------------------------------------------------------
-// mod_dsp - installs this object's dsp function in pd's callback list
-//------------------------------------------------------------------------------
-static void mod_dsp( t_mod* object, t_signal **sig )
-{
-    // dsp_add arguments
-    //--------------------------------------------------------------------------
-    // perform routine
-    // number of passed parameters
-    // inlet 1 sample vector
-    // inlet 2 sample vector
-    // outlet sample vector
-    // sample frames to process (vector size)
-    dsp_add( mod_perform, 4, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 0 ]->s_n );
-}
-
-
-//------------------------------------------------------------------------------
-// mod_arg_dsp - installs this object's dsp function in pd's callback list
-//------------------------------------------------------------------------------
-static void mod_arg_dsp( t_mod* object, t_signal **sig )
-{
-    // dsp_add arguments
-    //--------------------------------------------------------------------------
-    // perform routine
-    // number of passed parameters
-    // inlet 1 sample vector
-    // object's argument value
-    // outlet sample vector
-    // sample frames to process (vector size)
-    dsp_add( mod_arg_perform, 4, sig[ 0 ]->s_vec, &object->inlet_2, sig[ 1 ]->s_vec, sig[ 0 ]->s_n );
-}
-
-
-//------------------------------------------------------------------------------
-// mod_new - instantiates a copy of this object in pd
-//------------------------------------------------------------------------------
-static void* mod_new( t_symbol *s, t_int argc, t_atom *argv )
-{
-    if( argc > 1 )
+    else
     {
-        poststring( "%~: extra arguments ignored\n" );
+        // look for quotients too large for the reciprocal path - comparing the
+        // sign-masked bits also sends nan and infinite inputs to fmodf
+        limit = FloatBits( divisor * MOD_QUOTIENT_LIMIT );
+
+        for( n = 0 ; n < frames ; ++n )
+        {
+            large |= ( FloatBits( in[ n ] ) & ( FLOAT_EXPONENT_BITS | FLOAT_MANTISSA_BITS ) ) >= limit;
+        }
     }
 
-    if( argc )
+    if( large )
     {
-        // create a pointer to this object
-        t_mod* object = ( t_mod* )pd_new( mod_arg_class );
-
-        // create a second float inlet
-        floatinlet_new( &object->object, &object->inlet_2 );
-
-        // assign an argument value to inlet_2 variable
-        object->inlet_2 = atom_getfloatarg( 0, ( int )argc, argv );
-
-        // create a signal outlet for this object
-        outlet_new( &object->object, gensym( "signal" ) );
-
-        // initialize the value of inlet_1 variable
-        object->inlet_1 = 0;
-
-        return object;
+        for( n = 0 ; n < frames ; ++n )
+        {
+            // perform operation, fix not-a-number, and store result in output array
+            out[ n ] = FixNan( Modulo( in[ n ], arg ) );
+        }
     }
     else
     {
-        // create a pointer to this object
-        t_mod* object = ( t_mod* )pd_new( mod_class );
+        reciprocal = 1.0 / divisor;
 
-        // create a second signal inlet
-        signalinlet_new( &object->object, object->inlet_2 );
+        for( n = 0 ; n < frames ; ++n )
+        {
+            quotient  = ( double )( int )( in[ n ] * reciprocal );
+            remainder = in[ n ] - quotient * divisor;
 
-        // create a signal outlet for this object
-        outlet_new( &object->object, gensym( "signal" ) );
+            // the divisor signed like the input
+            toward = in[ n ] < 0 ? -divisor : divisor;
 
-        // initialize the value of inlet_1 variable
-        object->inlet_1 = 0;
+            // a quotient rounded across an integer leaves the remainder one
+            // divisor out of range, on one side or the other
+            remainder = remainder * toward < 0           ? remainder + toward : remainder;
+            remainder = Absolute( remainder ) >= divisor ? remainder - toward : remainder;
 
-        return object;
+            // store result in output array
+            out[ n ] = ( t_float )remainder;
+        }
     }
-}
-
-
-//------------------------------------------------------------------------------
-// setup_0x25_tilde - describes the attributes of this object to pd so it may be properly instantiated
-// (object names starting with hex codes use setup_xxxx_tilde naming convention)
-//------------------------------------------------------------------------------
-void setup_0x25_tilde( void )
-{
-    // mod class
-    //--------------------------------------------------------------------------
-
-    // creates an instance of this object and describes it to pd
-    mod_class = class_new( gensym( "%~" ), ( t_newmethod )mod_new, 0, sizeof( t_mod ), 0, A_GIMME, 0 );
-
-    // declares leftmost inlet as a signal inlet
-    CLASS_MAINSIGNALIN( mod_class, t_mod, inlet_1 );
-
-    // installs mod_dsp so that it will be called when dsp is turned on
-    class_addmethod( mod_class, ( t_method )mod_dsp, gensym( "dsp" ), 0 );
 
-    // sets a filesystem-safe help patch name
-    class_sethelpsymbol( mod_class, gensym( "mod~" ) );
-
-
-    // mod_arg class
-    //--------------------------------------------------------------------------
-
-    // creates an instance of this object with an argument and describes it to pd
-    mod_arg_class = class_new( gensym( "%~" ), 0, 0, sizeof( t_mod ), 0, 0 );
-
-    // declares leftmost inlet as a signal inlet
-    CLASS_MAINSIGNALIN( mod_arg_class, t_mod, inlet_1 );
-
-    // installs mod_arg_dsp so that it will be called when dsp is turned on
-    class_addmethod( mod_arg_class, ( t_method )mod_arg_dsp, gensym( "dsp" ), 0 );
-
-    // sets a filesystem-safe help patch name
-    class_sethelpsymbol( mod_arg_class, gensym( "mod~" ) );
+    // return the dsp input/output array address plus one more than its size
+    // to provide a pointer to the next perform function in pd's call list
+    return &( io[ 5 ] );
 }
 
 
@@ -51,6 +51,25 @@ typedef struct monitor
     t_float sample_count;
     t_float count_max;
 
+    // sampled values queued by the perform routine for output by the clock
+    t_ring queue;
+
+    // newest value while an interval is set - only the newest is output then,
+    // so values arriving faster than the clock drains cannot go stale
+    t_float latest;
+
+    // TRUE while latest holds a value not yet output
+    t_int latest_fresh;
+
+    // clock that drains the queue on the scheduler side
+    t_clock* clock;
+
+    // TRUE while the clock is waiting to fire
+    t_int clock_pending;
+
+    // milliseconds between outputs ( 0 outputs every sampled value )
+    t_float interval;
+
     // pointer to the outlet
     t_outlet* outlet_1;
 
@@ -62,7 +81,10 @@ typedef struct monitor
 //------------------------------------------------------------------------------
 static t_int* monitor_perform     ( t_int* io );
 static void   monitor_dsp         ( t_monitor* object, t_signal **sig );
+static void   monitor_tick        ( t_monitor* object );
+static void   monitor_rate        ( t_monitor* object, t_floatarg interval );
 static void*  monitor_new         ( void );
+static void   monitor_free        ( t_monitor* object );
 void          monitor_tilde_setup ( void );
 void          monitor_bang        ( t_monitor* object );
 
@@ -76,6 +98,54 @@ void monitor_bang( t_monitor* object )
 }
 
 
+//------------------------------------------------------------------------------
+// monitor_tick - drains queued signal values to the outlet
+//------------------------------------------------------------------------------
+static void monitor_tick( t_monitor* object )
+{
+    t_float value;
+    t_int   fresh = FALSE;
+
+    object->clock_pending = FALSE;
+
+    while( RingRead( &object->queue, &value ) )
+    {
+        object->signal_value = value;
+
+        // with no interval every value is output, otherwise only the newest
+        if( object->interval <= 0 )
+        {
+            monitor_bang( object );
+        }
+        else
+        {
+            fresh = TRUE;
+        }
+    }
+
+    if( object->latest_fresh )
+    {
+        object->latest_fresh = FALSE;
+        object->signal_value = object->latest;
+        fresh                = TRUE;
+    }
+
+    if( fresh )
+    {
+        monitor_bang( object );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// monitor_rate - sets the milliseconds between outputs
+//------------------------------------------------------------------------------
+static void monitor_rate( t_monitor* object, t_floatarg interval )
+{
+    object->interval = Clip( interval, 0, 1000 );
+}
+
+
 //------------------------------------------------------------------------------
 // monitor_perform - the signal processing function of this object
 //------------------------------------------------------------------------------
@@ -101,14 +171,27 @@ static t_int* monitor_perform( t_int* io )
         // output a sample if enough samples have elapsed
         if( object->sample_count >= count_max )
         {
-            // store current input sample value
-            object->signal_value = in[ n ];
+            // with an interval only the newest value is output, so keep just that one
+            if( object->interval > 0 )
+            {
+                object->latest       = in[ n ];
+                object->latest_fresh = TRUE;
+            }
+            else
+            {
+                // queue current input sample value, dropping it if the queue is full
+                RingWrite( &object->queue, in[ n ] );
+            }
 
             // reset sample count
             object->sample_count = 0;
 
-            // bang this object to cause float output
-            monitor_bang( object );
+            // schedule output on the scheduler side unless already pending
+            if( !object->clock_pending )
+            {
+                object->clock_pending = TRUE;
+                clock_delay( object->clock, object->interval );
+            }
         }
     }
 
@@ -148,10 +231,27 @@ static void* monitor_new( void )
     // create a new float outlet for this object
     object->outlet_1 = outlet_new( &object->object, gensym( "float" ) );
 
+    // create a clock to output queued values
+    object->clock = clock_new( object, ( t_method )monitor_tick );
+
+    // initialize variables
+    object->latest_fresh  = FALSE;
+    object->clock_pending = FALSE;
+    object->interval      = 0;
+
     return object;
 }
 
 
+//------------------------------------------------------------------------------
+// monitor_free - cleans up memory allocated by this object
+//------------------------------------------------------------------------------
+static void monitor_free( t_monitor* object )
+{
+    clock_free( object->clock );
+}
+
+
 //------------------------------------------------------------------------------
 // monitor_tilde_setup - describes the attributes of this object to pd so it may be properly instantiated
 // (must always be named with _tilde replacing ~ in the object name)
@@ -159,7 +259,7 @@ static void* monitor_new( void )
 void monitor_tilde_setup( void )
 {
     // creates an instance of this object and describes it to pd
-    monitor_class = class_new( gensym( "monitor~" ), ( t_newmethod )monitor_new, 0, sizeof( t_monitor ), 0, 0, 0 );
+    monitor_class = class_new( gensym( "monitor~" ), ( t_newmethod )monitor_new, ( t_method )monitor_free, sizeof( t_monitor ), 0, 0, 0 );
 
     // declares leftmost inlet as a signal inlet
     CLASS_MAINSIGNALIN( monitor_class, t_monitor, inlet_1 );
@@ -169,6 +269,9 @@ void monitor_tilde_setup( void )
 
     // add a bang handler to this class
     class_addbang( monitor_class, monitor_bang );
+
+    // installs monitor_rate to respond to "rate" message
+    class_addmethod( monitor_class, ( t_method )monitor_rate, gensym( "rate" ), A_FLOAT, 0 );
 }
 
 
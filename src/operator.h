@@ -0,0 +1,433 @@
+//------------------------------------------------------------------------------
+//  Pd Spectral Toolkit
+//
+//  operator.h
+//
+//  Shared kernel for the comparison, logic, and modulo operator objects
+//
+//  Included once by each operator file after it defines:
+//
+//      OPERATOR_PREFIX     name prefix of the generated functions ( greater )
+//      OPERATOR_SYMBOL     object name in pd ( ">~" )
+//      OPERATOR_HELP       filesystem-safe help patch name ( "gt~" )
+//      OPERATOR_SETUP      setup function name ( setup_0x3e_tilde )
+//      OPERATION( a, b )   the operation on two samples
+//
+//  and optionally:
+//
+//      OPERATOR_UNARY      single inlet operator ignoring b, with no argument
+//      OPERATOR_MASK       also define packed bitmask kernels for bin selection
+//      OPERATOR_ARG        the operator file defines its own arg_perform
+//
+//  Comparisons and logic operations wrap their test in OperatorTruth, a
+//  branchless select of 1.0 or 0.0 that the compiler turns into a packed
+//  compare and mask ( sse, avx, or neon, whichever the target provides )
+//
+//  Copyright (C) 2019 Cooper Baker. All Rights Reserved.
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// headers
+//------------------------------------------------------------------------------
+
+// main header for pd
+#include "m_pd.h"
+
+// utility header for Pd Spectral Toolkit project
+#include "utility.h"
+
+// disable compiler warnings on windows
+#ifdef NT
+#pragma warning( disable : 4244 )
+#pragma warning( disable : 4305 )
+#endif
+
+
+//------------------------------------------------------------------------------
+// definitions
+//------------------------------------------------------------------------------
+
+// pastes the operator prefix onto a function name suffix
+#define OPERATOR_PASTE( prefix, suffix ) prefix ## _ ## suffix
+#define OPERATOR_NAME( prefix, suffix )  OPERATOR_PASTE( prefix, suffix )
+#define OPERATOR( suffix )               OPERATOR_NAME( OPERATOR_PREFIX, suffix )
+
+// 1.0 when a test holds, 0.0 otherwise
+#define OperatorTruth( test ) ( ( test ) ? ( t_float )1 : ( t_float )0 )
+
+// bins per packed mask word
+#define OPERATOR_MASK_BITS 32
+
+
+//------------------------------------------------------------------------------
+// class pointers to this object's definitions
+//------------------------------------------------------------------------------
+static t_class* OPERATOR( class );
+#ifndef OPERATOR_UNARY
+static t_class* OPERATOR( arg_class );
+#endif
+
+
+//------------------------------------------------------------------------------
+// data structure holding this object's data
+//------------------------------------------------------------------------------
+typedef struct OPERATOR_PREFIX
+{
+    // this object - must always be first variable in struct
+    t_object object;
+
+    // needed for CLASS_MAINSIGNALIN macro call in the setup function
+    t_float inlet_1;
+
+    // inlet 2 value
+    t_float inlet_2;
+
+} t_operator;
+
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+static t_int* OPERATOR( perform     ) ( t_int* io );
+static void   OPERATOR( dsp         ) ( t_operator* object, t_signal **sig );
+#ifdef OPERATOR_UNARY
+static void*  OPERATOR( new         ) ( void );
+#else
+static t_int* OPERATOR( arg_perform ) ( t_int* io );
+static void   OPERATOR( arg_dsp     ) ( t_operator* object, t_signal **sig );
+static void*  OPERATOR( new         ) ( t_symbol *s, t_int argc, t_atom *argv );
+#endif
+#ifdef OPERATOR_MASK
+static inline unsigned int OPERATOR( mask_bit ) ( t_int bin );
+static inline void         OPERATOR( mask     ) ( const t_float* in1, const t_float* in2, unsigned int* bits, t_int frames );
+static inline void         OPERATOR( arg_mask ) ( const t_float* in, t_float arg, unsigned int* bits, t_int frames );
+#endif
+void          OPERATOR_SETUP          ( void );
+
+
+//------------------------------------------------------------------------------
+// perform - the signal processing function of this object
+//------------------------------------------------------------------------------
+static t_int* OPERATOR( perform )( t_int* io )
+{
+    // store variables from dsp input/output array
+#ifdef OPERATOR_UNARY
+    t_float* in1    = ( t_float* )( io[ 1 ] );
+    t_float* out    = ( t_float* )( io[ 2 ] );
+    t_int    frames = ( t_int    )( io[ 3 ] );
+#else
+    t_float* in1    = ( t_float* )( io[ 1 ] );
+    t_float* in2    = ( t_float* )( io[ 2 ] );
+    t_float* out    = ( t_float* )( io[ 3 ] );
+    t_int    frames = ( t_int    )( io[ 4 ] );
+#endif
+
+    // signal vector iterator variable
+    t_int n;
+
+    // the dsp loop - branchless, so the compiler vectorizes it
+    for( n = 0 ; n < frames ; ++n )
+    {
+        // perform operation and store result to output array
+#ifdef OPERATOR_UNARY
+        out[ n ] = OPERATION( in1[ n ], 0 );
+#else
+        out[ n ] = OPERATION( in1[ n ], in2[ n ] );
+#endif
+    }
+
+    // return the dsp input/output array address plus one more than its size
+    // to provide a pointer to the next perform function in pd's call list
+#ifdef OPERATOR_UNARY
+    return &( io[ 4 ] );
+#else
+    return &( io[ 5 ] );
+#endif
+}
+
+
+#if !defined( OPERATOR_UNARY ) && !defined( OPERATOR_ARG )
+//------------------------------------------------------------------------------
+// arg_perform - the signal processing function of this object with argument
+//------------------------------------------------------------------------------
+static t_int* OPERATOR( arg_perform )( t_int* io )
+{
+    // store variables from dsp input/output array
+    t_float* in     =  ( t_float* )( io[ 1 ] );
+    t_float  arg    = *( t_float* )( io[ 2 ] );
+    t_float* out    =  ( t_float* )( io[ 3 ] );
+    t_int    frames =  ( t_int    )( io[ 4 ] );
+
+    // signal vector iterator variable
+    t_int n;
+
+    // the dsp loop - branchless, so the compiler vectorizes it
+    for( n = 0 ; n < frames ; ++n )
+    {
+        // perform operation and store result to output array
+        out[ n ] = OPERATION( in[ n ], arg );
+    }
+
+    // return the dsp input/output array address plus one more than its size
+    // to provide a pointer to the next perform function in pd's call list
+    return &( io[ 5 ] );
+}
+#endif
+
+
+#ifdef OPERATOR_MASK
+//------------------------------------------------------------------------------
+// mask_bit - the bit of a bin in its mask word
+//------------------------------------------------------------------------------
+// selecting bits from a table rather than shifting by the bin index keeps
+// the packing loops vectorizable
+//------------------------------------------------------------------------------
+static inline unsigned int OPERATOR( mask_bit )( t_int bin )
+{
+    static const unsigned int bits[ OPERATOR_MASK_BITS ] =
+    {
+        1u <<  0, 1u <<  1, 1u <<  2, 1u <<  3, 1u <<  4, 1u <<  5, 1u <<  6, 1u <<  7,
+        1u <<  8, 1u <<  9, 1u << 10, 1u << 11, 1u << 12, 1u << 13, 1u << 14, 1u << 15,
+        1u << 16, 1u << 17, 1u << 18, 1u << 19, 1u << 20, 1u << 21, 1u << 22, 1u << 23,
+        1u << 24, 1u << 25, 1u << 26, 1u << 27, 1u << 28, 1u << 29, 1u << 30, 1u << 31
+    };
+
+    return bits[ bin ];
+}
+
+
+//------------------------------------------------------------------------------
+// mask - packs the operation's results into bits, one per bin
+//------------------------------------------------------------------------------
+// bin n lands in bit n % 32 of word n / 32, letting bin selection code test
+// or combine 32 bins per integer operation
+//------------------------------------------------------------------------------
+static inline void OPERATOR( mask )( const t_float* in1, const t_float* in2, unsigned int* bits, t_int frames )
+{
+    unsigned int word;
+    t_int        n;
+    t_int        k;
+
+    // whole words, with a fixed trip count the compiler vectorizes
+    for( n = 0 ; n + OPERATOR_MASK_BITS <= frames ; n += OPERATOR_MASK_BITS )
+    {
+        word = 0;
+
+        for( k = 0 ; k < OPERATOR_MASK_BITS ; ++k )
+        {
+            word |= OPERATION( in1[ n + k ], in2[ n + k ] ) != 0 ? OPERATOR( mask_bit )( k ) : 0;
+        }
+
+        bits[ n / OPERATOR_MASK_BITS ] = word;
+    }
+
+    // a partial last word when frames is not a multiple of the word size
+    if( n < frames )
+    {
+        word = 0;
+
+        for( k = 0 ; n + k < frames ; ++k )
+        {
+            word |= OPERATION( in1[ n + k ], in2[ n + k ] ) != 0 ? OPERATOR( mask_bit )( k ) : 0;
+        }
+
+        bits[ n / OPERATOR_MASK_BITS ] = word;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// arg_mask - packs the operation's results against a constant into bits
+//------------------------------------------------------------------------------
+static inline void OPERATOR( arg_mask )( const t_float* in, t_float arg, unsigned int* bits, t_int frames )
+{
+    unsigned int word;
+    t_int        n;
+    t_int        k;
+
+    // whole words, with a fixed trip count the compiler vectorizes
+    for( n = 0 ; n + OPERATOR_MASK_BITS <= frames ; n += OPERATOR_MASK_BITS )
+    {
+        word = 0;
+
+        for( k = 0 ; k < OPERATOR_MASK_BITS ; ++k )
+        {
+            word |= OPERATION( in[ n + k ], arg ) != 0 ? OPERATOR( mask_bit )( k ) : 0;
+        }
+
+        bits[ n / OPERATOR_MASK_BITS ] = word;
+    }
+
+    // a partial last word when frames is not a multiple of the word size
+    if( n < frames )
+    {
+        word = 0;
+
+        for( k = 0 ; n + k < frames ; ++k )
+        {
+            word |= OPERATION( in[ n + k ], arg ) != 0 ? OPERATOR( mask_bit )( k ) : 0;
+        }
+
+        bits[ n / OPERATOR_MASK_BITS ] = word;
+    }
+}
+#endif
+
+
+//------------------------------------------------------------------------------
+// dsp - installs this object's dsp function in pd's callback list
+//------------------------------------------------------------------------------
+static void OPERATOR( dsp )( t_operator* object, t_signal **sig )
+{
+    // dsp_add arguments
+    //--------------------------------------------------------------------------
+    // perform routine
+    // number of passed parameters
+    // inlet 1 sample vector
+    // inlet 2 sample vector ( binary operators )
+    // outlet sample vector
+    // sample frames to process (vector size)
+#ifdef OPERATOR_UNARY
+    dsp_add( OPERATOR( perform ), 3, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 0 ]->s_n );
+#else
+    dsp_add( OPERATOR( perform ), 4, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 0 ]->s_n );
+#endif
+}
+
+
+#ifndef OPERATOR_UNARY
+//------------------------------------------------------------------------------
+// arg_dsp - installs this object's dsp function in pd's callback list
+//------------------------------------------------------------------------------
+static void OPERATOR( arg_dsp )( t_operator* object, t_signal **sig )
+{
+    // dsp_add arguments
+    //--------------------------------------------------------------------------
+    // perform routine
+    // number of passed parameters
+    // inlet 1 sample vector
+    // object's argument value
+    // outlet sample vector
+    // sample frames to process (vector size)
+    dsp_add( OPERATOR( arg_perform ), 4, sig[ 0 ]->s_vec, &object->inlet_2, sig[ 1 ]->s_vec, sig[ 0 ]->s_n );
+}
+#endif
+
+
+#ifdef OPERATOR_UNARY
+//------------------------------------------------------------------------------
+// new - instantiates a copy of this object in pd
+//------------------------------------------------------------------------------
+static void* OPERATOR( new )( void )
+{
+    // create a pointer to this object
+    t_operator* object = ( t_operator* )pd_new( OPERATOR( class ) );
+
+    // create a new signal outlet for this object
+    outlet_new( &object->object, gensym( "signal" ) );
+
+    // initialize the value of inlet variables
+    object->inlet_1 = 0;
+    object->inlet_2 = 0;
+
+    return object;
+}
+#else
+//------------------------------------------------------------------------------
+// new - instantiates a copy of this object in pd
+//------------------------------------------------------------------------------
+static void* OPERATOR( new )( t_symbol *s, t_int argc, t_atom *argv )
+{
+    if( argc > 1 )
+    {
+        post( OPERATOR_SYMBOL ": extra arguments ignored" );
+    }
+
+    if( argc )
+    {
+        // create a pointer to this object
+        t_operator* object = ( t_operator* )pd_new( OPERATOR( arg_class ) );
+
+        // create a second float inlet
+        floatinlet_new( &object->object, &object->inlet_2 );
+
+        // assign an argument value to inlet_2 variable
+        object->inlet_2 = atom_getfloatarg( 0, ( int )argc, argv );
+
+        // create a signal outlet for this object
+        outlet_new( &object->object, gensym( "signal" ) );
+
+        // initialize the value of inlet_1 variable
+        object->inlet_1 = 0;
+
+        return object;
+    }
+    else
+    {
+        // create a pointer to this object
+        t_operator* object = ( t_operator* )pd_new( OPERATOR( class ) );
+
+        // create a second signal inlet
+        signalinlet_new( &object->object, object->inlet_2 );
+
+        // create a signal outlet for this object
+        outlet_new( &object->object, gensym( "signal" ) );
+
+        // initialize the value of inlet_1 variable
+        object->inlet_1 = 0;
+
+        return object;
+    }
+}
+#endif
+
+
+//------------------------------------------------------------------------------
+// setup - describes the attributes of this object to pd so it may be properly instantiated
+// (object names starting with hex codes use setup_xxxx_tilde naming convention)
+//------------------------------------------------------------------------------
+void OPERATOR_SETUP( void )
+{
+    // operator class
+    //--------------------------------------------------------------------------
+
+    // creates an instance of this object and describes it to pd
+#ifdef OPERATOR_UNARY
+    OPERATOR( class ) = class_new( gensym( OPERATOR_SYMBOL ), ( t_newmethod )OPERATOR( new ), 0, sizeof( t_operator ), 0, 0, 0 );
+#else
+    OPERATOR( class ) = class_new( gensym( OPERATOR_SYMBOL ), ( t_newmethod )OPERATOR( new ), 0, sizeof( t_operator ), 0, A_GIMME, 0 );
+#endif
+
+    // declares leftmost inlet as a signal inlet
+    CLASS_MAINSIGNALIN( OPERATOR( class ), t_operator, inlet_1 );
+
+    // installs dsp so that it will be called when dsp is turned on
+    class_addmethod( OPERATOR( class ), ( t_method )OPERATOR( dsp ), gensym( "dsp" ), 0 );
+
+    // sets a filesystem-safe help patch name
+    class_sethelpsymbol( OPERATOR( class ), gensym( OPERATOR_HELP ) );
+
+#ifndef OPERATOR_UNARY
+
+    // operator_arg class
+    //--------------------------------------------------------------------------
+
+    // creates an instance of this object with an argument and describes it to pd
+    OPERATOR( arg_class ) = class_new( gensym( OPERATOR_SYMBOL ), 0, 0, sizeof( t_operator ), 0, 0 );
+
+    // declares leftmost inlet as a signal inlet
+    CLASS_MAINSIGNALIN( OPERATOR( arg_class ), t_operator, inlet_1 );
+
+    // installs arg_dsp so that it will be called when dsp is turned on
+    class_addmethod( OPERATOR( arg_class ), ( t_method )OPERATOR( arg_dsp ), gensym( "dsp" ), 0 );
+
+    // sets a filesystem-safe help patch name
+    class_sethelpsymbol( OPERATOR( arg_class ), gensym( OPERATOR_HELP ) );
+#endif
+}
+
+
+//------------------------------------------------------------------------------
+// EOF
+//------------------------------------------------------------------------------
@@ -33,6 +33,18 @@
 #pragma warning( disable : 4305 )
 #endif
 
+// worker threads share the oscillators where pthreads are available
+#ifndef NT
+#define OSCBANK_THREADS
+#endif
+
+#ifdef OSCBANK_THREADS
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
 // 2^24 point wavetable
 // #define WAVETABLE_SIZE 16777216
 // #define WAVETABLE_MASK 16777215
@@ -60,6 +72,100 @@
 // synthesis threshold in dBFS
 #define SYNTH_THRESHOLD -96
 
+// inverse fft synthesis draws each partial into the spectrum of a frame four
+// hops long as the main lobe of a minimum 4-term blackman-harris window, whose
+// frames sum to a constant when overlapped every hop
+#define IFFT_OVERLAP   4
+#define IFFT_WINDOW_A0 0.35875
+#define IFFT_WINDOW_A1 0.48829
+#define IFFT_WINDOW_A2 0.14128
+#define IFFT_WINDOW_A3 0.01168
+
+// smallest hop the inverse fft synthesis will run with
+#define IFFT_MIN_HOP 4
+
+// half width of the window's main lobe in bins, and kernel points per bin
+#define KERNEL_WIDTH      4
+#define KERNEL_OVERSAMPLE 64
+#define KERNEL_SIZE       ( KERNEL_WIDTH * KERNEL_OVERSAMPLE + 2 )
+
+// most worker threads one oscillator bank may start
+#define MAX_THREADS 16
+
+// dsp polls for a worker still finishing an abandoned job this often
+#define WORKER_NAP_MICROSECONDS 100
+
+
+//------------------------------------------------------------------------------
+// worker job states - the perform routine posts a job, a worker takes it and
+// marks it done, or the perform routine takes back a job no worker has taken,
+// or abandons one a worker is late with and discards its result
+//------------------------------------------------------------------------------
+enum OSCBANK_JOB
+{
+    JOB_IDLE,
+    JOB_POSTED,
+    JOB_TAKEN,
+    JOB_DONE,
+    JOB_ABANDONED
+};
+
+
+//------------------------------------------------------------------------------
+// oscbank_slice - a range of one channel's oscillators and the inputs and
+// coefficients to synthesize a hop of them
+//------------------------------------------------------------------------------
+typedef struct oscbank_slice
+{
+    // the channel's magnitude and frequency inputs
+    t_float* in;
+    t_float* freq;
+
+    // oscillator range within the channel, and the channel's first oscillator
+    t_int first;
+    t_int last;
+    t_int offset;
+
+    // hop size and coefficients from the perform routine
+    t_int   hop_size;
+    t_float smoothing_coeff;
+    t_float amp_coeff;
+    t_float phase_inc_coeff;
+
+} t_oscbank_slice;
+
+
+//------------------------------------------------------------------------------
+// oscbank_worker - a worker thread and its job
+//------------------------------------------------------------------------------
+typedef struct oscbank_worker
+{
+    // the oscillator bank this worker renders for
+    struct oscbank* object;
+
+    // a private bank sharing the object's wavetable, whose oscillators hold
+    // copies of the worker's share, so a late worker never writes the object
+    struct oscbank* bank;
+
+    // the slice to render, private copies of its inputs, and its hop buffer
+    t_oscbank_slice slice;
+    t_float*        in;
+    t_float*        freq;
+    t_float*        buffer;
+
+    // one of the OSCBANK_JOB states above, and set to end the thread
+    int state;
+    int stop;
+
+#ifdef OSCBANK_THREADS
+    // the thread, and the lock and condition it sleeps on between jobs
+    pthread_t       thread;
+    pthread_mutex_t lock;
+    pthread_cond_t  wake;
+#endif
+
+} t_oscbank_worker;
+
 
 //------------------------------------------------------------------------------
 // oscbank_class - pointer to this object's definition
@@ -110,6 +216,9 @@ typedef struct oscbank
     // frame size divided by two
     t_int half_frames;
 
+    // number of channels, each with half_frames oscillators
+    t_int channels;
+
     // number of samples per hop
     t_int hop_size;
 
@@ -119,32 +228,75 @@ typedef struct oscbank
     // threshold of resynthesis
     t_float threshold;
 
+    // nonzero when inlet 1 carries a sparse partial list
+    t_int sparse;
+
+    // per channel lists of the bins whose oscillators are sounding in sparse
+    // mode, their lengths, and a flag per oscillator marking it as listed
+    t_int* active;
+    t_int* active_count;
+    t_int* listed;
+
+    // nonzero when partials are synthesized by inverse fft
+    t_int ifft;
+
+    // inverse fft frame size, zero until the kernel is made for it
+    t_int fft_size;
+
+    // inverse fft frame and per channel overlap-add buffers
+    t_float* frame;
+    t_float* overlap_add;
+
+    // the window's main lobe, scaled to synthesize unit amplitude partials
+    t_float kernel[ KERNEL_SIZE ];
+
+    // worker threads sharing the dense oscillators
+    t_oscbank_worker* workers;
+    t_int             worker_count;
+
+    // dsp timing record read by spectprof ( empty unless profiling is compiled in )
+    PROFILE_MEMBER
+
 } t_oscbank;
 
 
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
-static t_int* oscbank_perform     ( t_int* io );
-static void   oscbank_dsp         ( t_oscbank* object, t_signal **sig );
-static void   oscbank_overlap     ( t_oscbank* object, t_floatarg overlap );
-static void*  oscbank_new         ( t_symbol* selector, t_int items, t_atom* list );
-static void   oscbank_free        ( t_oscbank* object );
-void          oscbank_tilde_setup ( void );
+static inline void  oscbank_oscillator      ( t_oscbank* object, t_int o, t_float* synthesis, t_int hop_size, t_float smoothing_coeff );
+static t_int        oscbank_ifft_size       ( t_int hop_size );
+static void         oscbank_kernel          ( t_oscbank* object, t_int fft_size );
+static inline void  oscbank_partial         ( t_oscbank* object, t_int o, t_float* frame, t_int fft_size, t_int hop_size );
+static void         oscbank_ifft_hop        ( t_oscbank* object, t_int channel, t_float* out, t_int frames, t_int hop_size );
+static void         oscbank_render          ( t_oscbank* object, const t_oscbank_slice* slice, t_float* synthesis, t_int fft_size );
+static void         oscbank_render_threads  ( t_oscbank* object, const t_oscbank_slice* slice, t_float* synthesis );
+static void         oscbank_size_workers    ( t_oscbank* object );
+#ifdef OSCBANK_THREADS
+static void         oscbank_post            ( t_oscbank* object, t_oscbank_worker* worker, const t_oscbank_slice* slice );
+static void         oscbank_accept          ( t_oscbank* object, t_oscbank_worker* worker, t_float* synthesis );
+static double       oscbank_seconds         ( void );
+static void*        oscbank_worker_thread   ( void* pointer );
+static void         oscbank_stop_workers    ( t_oscbank* object );
+#endif
+static void         oscbank_perform_sparse  ( t_oscbank* object, t_float* in1, t_float* out, t_int frames, t_int channels );
+static t_int*       oscbank_perform         ( t_int* io );
+static void         oscbank_dsp             ( t_oscbank* object, t_signal **sig );
+static void         oscbank_reset           ( t_oscbank* object );
+static void         oscbank_overlap         ( t_oscbank* object, t_floatarg overlap );
+static void         oscbank_sparse          ( t_oscbank* object, t_floatarg sparse );
+static void         oscbank_ifft            ( t_oscbank* object, t_floatarg ifft );
+static void         oscbank_threads         ( t_oscbank* object, t_floatarg threads );
+static void*        oscbank_new             ( t_symbol* selector, t_int items, t_atom* list );
+static void         oscbank_free            ( t_oscbank* object );
+void                oscbank_tilde_setup     ( void );
 
 
 //------------------------------------------------------------------------------
-// oscbank_perform - the signal processing function of this object
+// oscbank_oscillator - synthesizes one hop of oscillator o, gliding from its
+// previous amplitude and frequency to the targets in amp and phase_inc
 //------------------------------------------------------------------------------
-static t_int* oscbank_perform( t_int* io )
+static inline void oscbank_oscillator( t_oscbank* object, t_int o, t_float* synthesis, t_int hop_size, t_float smoothing_coeff )
 {
-    // store variables from dsp input/output array
-    t_float*   in1    = ( t_float*   )( io[ 1 ] );
-    t_float*   in2    = ( t_float*   )( io[ 2 ] );
-    t_float*   out    = ( t_float*   )( io[ 3 ] );
-    t_int      frames = ( t_int      )( io[ 4 ] );
-    t_oscbank* object = ( t_oscbank* )( io[ 5 ] );
-
     // store pointer copies for local use
     t_float* phase                = object->phase;
     t_float* phase_inc            = object->phase_inc;
@@ -153,83 +305,915 @@ static t_int* oscbank_perform( t_int* io )
     t_float* amp                  = object->amp;
     t_float* amp_smooth           = object->amp_smooth;
     t_float* amp_smooth_inc       = object->amp_smooth_inc;
-    t_float* synthesis            = object->synthesis;
     t_float* wavetable            = object->wavetable;
 
     // store variable copies for local use
-    t_int   overlap   = object->overlap;
     t_float threshold = object->threshold;
 
     // wavetable & mask value
     long wavetable_mask = WAVETABLE_MASK;
 
+    // signal vector iterator variable
+    t_int n = -1;
+
+    // calculate amplitude smoothing increment
+    amp_smooth_inc[ o ] = ( amp[ o ] - amp_smooth[ o ] ) * smoothing_coeff;
+
+    // calculate phase increment smoothing increment
+    phase_inc_smooth_inc[ o ] = ( phase_inc[ o ] - phase_inc_smooth[ o ] ) * smoothing_coeff;
+
+    while( ++n < hop_size )
+    {
+        // if amp is below threshold, reset phase and do not calculate waveform
+        if( amp_smooth[ o ] < threshold )
+        {
+            phase[ o ] = 0.0;
+        }
+        // otherwise calculate waveform
+        else
+        {
+            // accumulate waveform into synthesis array
+            synthesis[ n ] += wavetable[ ( unsigned long )phase[ o ] ] * amp_smooth[ o ];
+
+            // increment phase
+            phase[ o ] += phase_inc_smooth[ o ];
+
+            // & wrap phase while preserving decimal values
+            phase[ o ] = ( ( long )phase[ o ] & wavetable_mask ) + ( phase[ o ] - ( long )phase[ o ] );
+        }
+
+        // increment phase and amplitude with smoothing increments
+        amp_smooth      [ o ] += amp_smooth_inc      [ o ];
+        phase_inc_smooth[ o ] += phase_inc_smooth_inc[ o ];
+    }
+
+    // set phase and amplitude to target values for next dsp loop
+    amp_smooth      [ o ] = amp      [ o ];
+    phase_inc_smooth[ o ] = phase_inc[ o ];
+}
+
+
+//------------------------------------------------------------------------------
+// oscbank_ifft_size - returns the inverse fft frame size for a hop, or zero
+// when the hop cannot be synthesized by inverse fft
+//------------------------------------------------------------------------------
+static t_int oscbank_ifft_size( t_int hop_size )
+{
+    t_int fft_size = hop_size * IFFT_OVERLAP;
+
+    // the fft needs a power of two, and the kernel needs room to fold
+    if( ( hop_size < IFFT_MIN_HOP ) || ( fft_size & ( fft_size - 1 ) ) )
+    {
+        return 0;
+    }
+
+    return fft_size;
+}
+
+
+//------------------------------------------------------------------------------
+// oscbank_kernel - samples the window's main lobe for a frame size and clears
+// the overlap-add buffers, whose frames were made at the old size
+//------------------------------------------------------------------------------
+// the periodic window centered in the frame is a sum of cosines, so its
+// spectrum is a sum of shifted dirichlet kernels; the overlapped frames sum to
+// IFFT_OVERLAP * a0, and a sinusoid's positive frequency half carries half of
+// its amplitude, which the scale folds into the table
+//------------------------------------------------------------------------------
+static void oscbank_kernel( t_oscbank* object, t_int fft_size )
+{
+    double coeffs[ 4 ] = { IFFT_WINDOW_A0, IFFT_WINDOW_A1, IFFT_WINDOW_A2, IFFT_WINDOW_A3 };
+    double scale       = 1.0 / ( 2.0 * fft_size * IFFT_OVERLAP * IFFT_WINDOW_A0 );
+    double x;
+    double y;
+    double sum;
+
+    // kernel point, window term, and side iterator variables
+    t_int point;
+    t_int term;
+    t_int side;
+
+    for( point = 0 ; point < KERNEL_SIZE ; ++point )
+    {
+        x   = ( double )point / KERNEL_OVERSAMPLE;
+        sum = 0;
+
+        // the table ends at the main lobe
+        if( point < KERNEL_WIDTH * KERNEL_OVERSAMPLE )
+        {
+            for( term = 0 ; term < 4 ; ++term )
+            {
+                for( side = -1 ; side <= 1 ; side += 2 )
+                {
+                    y = x + side * term;
+
+                    // real part of the dirichlet kernel of the frame
+                    if( Absolute( y ) < 1e-9 )
+                    {
+                        sum += coeffs[ term ] * 0.5 * fft_size;
+                    }
+                    else
+                    {
+                        sum += coeffs[ term ] * 0.5 * sin( C_PI * y ) * cos( C_PI * y / fft_size ) / sin( C_PI * y / fft_size );
+                    }
+                }
+            }
+        }
+
+        object->kernel[ point ] = sum * scale;
+    }
+
+    memset( object->overlap_add, 0, object->half_frames * 2 * IFFT_OVERLAP * object->channels * sizeof( t_float ) );
+
+    object->fft_size = fft_size;
+}
+
+
+//------------------------------------------------------------------------------
+// oscbank_partial - advances oscillator o to the center of this hop's frame
+// and draws it into the frame's spectrum
+//------------------------------------------------------------------------------
+// a frame holds one amplitude and frequency, so the phase at its center moves
+// by about the mean of the old and new frequencies over a hop, which keeps
+// adjacent frames in phase where they cross - a frame starts with its hop and
+// centers on the end of the next, one hop later than the oscillators reach a
+// target, but with the phase they reach it with
+//------------------------------------------------------------------------------
+static inline void oscbank_partial( t_oscbank* object, t_int o, t_float* frame, t_int fft_size, t_int hop_size )
+{
+    // store pointer copies for local use
+    t_float* phase            = object->phase;
+    t_float* phase_inc        = object->phase_inc;
+    t_float* phase_inc_smooth = object->phase_inc_smooth;
+    t_float* amp              = object->amp;
+    t_float* amp_smooth       = object->amp_smooth;
+    t_float* wavetable        = object->wavetable;
+    t_float* kernel           = object->kernel;
+
+    // store variable copies for local use
+    t_float threshold = object->threshold;
+    t_int   half_size = fft_size / 2;
+
+    // phase, spectrum, and kernel variables
+    double  position;
+    long    index;
+    t_float real;
+    t_float imag;
+    t_float center;
+    t_float offset;
+    t_float weight;
+    t_float conjugate;
+    t_int   point;
+    t_int   bin;
+    t_int   first;
+    t_int   last;
+    t_int   target;
+
+    // a partial starting from silence starts at phase zero, as an oscillator does
+    if( amp_smooth[ o ] < threshold )
+    {
+        phase[ o ] = 0.0;
+    }
+
+    // advance as an oscillator gliding over the hop does
+    position   = phase[ o ] + ( phase_inc_smooth[ o ] * ( hop_size + 1 ) + phase_inc[ o ] * ( hop_size - 1 ) ) * 0.5;
+    phase[ o ] = position - WAVETABLE_SIZE * floor( position / WAVETABLE_SIZE );
+
+    amp_smooth      [ o ] = amp      [ o ];
+    phase_inc_smooth[ o ] = phase_inc[ o ];
+
+    // silent partials rest at phase zero
+    if( amp[ o ] < threshold )
+    {
+        phase[ o ] = 0.0;
+        return;
+    }
+
+    // partial frequency in bins of the frame
+    center = phase_inc[ o ] * fft_size / WAVETABLE_SIZE;
+
+    // skip partials outside of zero to nyquist
+    if( ( center <= 0 ) || ( center >= half_size ) )
+    {
+        return;
+    }
+
+    // the oscillators synthesize sin( phase ), whose positive frequency half
+    // has the phase of cos( phase - pi / 2 )
+    index = ( long )phase[ o ];
+    real  =  amp[ o ] * wavetable[ index ];
+    imag  = -amp[ o ] * wavetable[ ( index + WAVETABLE_SIZE / 4 ) & WAVETABLE_MASK ];
+
+    // bins under the main lobe
+    first = ( t_int )floor( center - KERNEL_WIDTH ) + 1;
+    last  = ( t_int )( center + KERNEL_WIDTH );
+
+    for( bin = first ; bin <= last ; ++bin )
+    {
+        // interpolate the kernel at the bin's distance from the partial
+        offset = Absolute( bin - center ) * KERNEL_OVERSAMPLE;
+        point  = ( t_int )offset;
+        weight = kernel[ point ] + ( kernel[ point + 1 ] - kernel[ point ] ) * ( offset - point );
+
+        // the frame centers on its middle sample, flipping every other bin
+        if( bin & 1 )
+        {
+            weight = -weight;
+        }
+
+        // bins past zero or nyquist fold back as the conjugate
+        target    = bin;
+        conjugate = 1;
+
+        if( bin < 0 )
+        {
+            target    = -bin;
+            conjugate = -1;
+        }
+        else if( bin > half_size )
+        {
+            target    = fft_size - bin;
+            conjugate = -1;
+        }
+
+        // zero and nyquist are real, and meet their own conjugates
+        if( ( target == 0 ) || ( target == half_size ) )
+        {
+            frame[ target ] += 2 * real * weight;
+        }
+        else
+        {
+            frame[ target ]            += real * weight;
+            frame[ fft_size - target ] -= imag * weight * conjugate;
+        }
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// oscbank_ifft_hop - transforms a channel's frame, overlap-adds it, and sends
+// out the hop it completes
+//------------------------------------------------------------------------------
+static void oscbank_ifft_hop( t_oscbank* object, t_int channel, t_float* out, t_int frames, t_int hop_size )
+{
+    // store pointer copies for local use
+    t_float* frame       = object->frame;
+    t_float* overlap_add = &( object->overlap_add[ channel * object->half_frames * 2 * IFFT_OVERLAP ] );
+
+    // store variable copies for local use
+    t_int fft_size = object->fft_size;
+
+    // signal vector iterator variable
+    t_int n;
+
+    // mayer real inverse fft of the packed spectrum
+    mayer_realifft( ( int )fft_size, frame );
+
+    for( n = 0 ; n < fft_size ; ++n )
+    {
+        overlap_add[ n ] += frame[ n ];
+    }
+
+    // send out the completed hop, followed by silence as the oscillators do
+    memcpy( out, overlap_add, hop_size * sizeof( t_float ) );
+    memset( out + hop_size, 0, ( frames - hop_size ) * sizeof( t_float ) );
+
+    // slide the frames still sounding down by a hop
+    memmove( overlap_add, overlap_add + hop_size, ( fft_size - hop_size ) * sizeof( t_float ) );
+    memset( overlap_add + fft_size - hop_size, 0, hop_size * sizeof( t_float ) );
+}
+
+
+//------------------------------------------------------------------------------
+// oscbank_render - sets the targets of a slice's oscillators from their inputs
+// and synthesizes their hop, or draws them into an inverse fft frame
+//------------------------------------------------------------------------------
+static void oscbank_render( t_oscbank* object, const t_oscbank_slice* slice, t_float* synthesis, t_int fft_size )
+{
+    // store pointer copies for local use, starting at the channel's oscillators
+    t_float* phase_inc = &( object->phase_inc[ slice->offset ] );
+    t_float* amp       = &( object->amp      [ slice->offset ] );
+    t_float* in        = slice->in;
+    t_float* freq      = slice->freq;
+
+    // store variable copies for local use
+    t_int   hop_size        = slice->hop_size;
+    t_float smoothing_coeff = slice->smoothing_coeff;
+    t_float amp_coeff       = slice->amp_coeff;
+    t_float phase_inc_coeff = slice->phase_inc_coeff;
+
+    // oscillator iterator variable
+    t_int o;
+
+    for( o = slice->first ; o < slice->last ; ++o )
+    {
+        // calculate amplitude based on input magnitude, flushing decayed
+        // amplitudes so the smoothed state never goes subnormal
+        amp[ o ] = FlushDenormal( in[ o ] * amp_coeff );
+
+        // calculate phase increment based on input frequency
+        phase_inc[ o ] = FlushDenormal( freq[ o ] * phase_inc_coeff );
+
+        // synthesize the oscillator's hop, or draw it into the frame
+        if( fft_size )
+        {
+            oscbank_partial( object, slice->offset + o, synthesis, fft_size, hop_size );
+        }
+        else
+        {
+            oscbank_oscillator( object, slice->offset + o, synthesis, hop_size, smoothing_coeff );
+        }
+    }
+}
+
+
+#ifdef OSCBANK_THREADS
+
+//------------------------------------------------------------------------------
+// oscbank_render_threads - splits a slice between this thread and the workers
+//------------------------------------------------------------------------------
+// each idle worker gets an equal share posted to it, while this thread renders
+// the first; a share no worker has taken by the time this thread is done is
+// taken back and rendered inline, and a worker still rendering once twice the
+// time this thread took has passed is late - its job is abandoned, its result
+// discarded when it finishes, and the share rendered inline, so dsp never
+// waits on a worker for long
+//------------------------------------------------------------------------------
+static void oscbank_render_threads( t_oscbank* object, const t_oscbank_slice* slice, t_float* synthesis )
+{
+    // store pointer copies for local use
+    t_oscbank_worker* workers = object->workers;
+
+    // store variable copies for local use
+    t_int worker_count = object->worker_count;
+    t_int share        = ( slice->last - slice->first ) / ( worker_count + 1 );
+
+    // this thread's share, the workers' shares, and which were posted
+    t_oscbank_slice own = *slice;
+    t_oscbank_slice shares[ MAX_THREADS ];
+    int             posted[ MAX_THREADS ];
+
+    // time the shares were posted, and the latest a worker may finish
+    double start = oscbank_seconds();
+    double deadline;
+
+    // worker iterator variable
+    t_int w;
+
+    // job state expected by a compare and swap
+    int expected;
+
+    // post the later shares, the last one taking the remainder, to the workers
+    // not still finishing an abandoned job
+    for( w = 0 ; w < worker_count ; ++w )
+    {
+        shares[ w ]       = *slice;
+        shares[ w ].first = slice->first + share * ( w + 1 );
+        shares[ w ].last  = ( w == worker_count - 1 ) ? slice->last : shares[ w ].first + share;
+
+        posted[ w ] = ( __atomic_load_n( &workers[ w ].state, __ATOMIC_ACQUIRE ) == JOB_IDLE );
+
+        if( posted[ w ] )
+        {
+            oscbank_post( object, &workers[ w ], &shares[ w ] );
+        }
+    }
+
+    own.last = slice->first + share;
+
+    oscbank_render( object, &own, synthesis, 0 );
+
+    deadline = 2 * oscbank_seconds() - start;
+
+    // collect the shares
+    for( w = 0 ; w < worker_count ; ++w )
+    {
+        expected = JOB_POSTED;
+
+        // render a share no worker could be given, or none has started
+        if( !posted[ w ] || __atomic_compare_exchange_n( &workers[ w ].state, &expected, JOB_IDLE, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE ) )
+        {
+            oscbank_render( object, &shares[ w ], synthesis, 0 );
+            continue;
+        }
+
+        // otherwise wait for the worker until the deadline
+        while( ( __atomic_load_n( &workers[ w ].state, __ATOMIC_ACQUIRE ) != JOB_DONE ) && ( oscbank_seconds() < deadline ) )
+        {
+            sched_yield();
+        }
+
+        expected = JOB_TAKEN;
+
+        // abandon the job of a worker that is still rendering
+        if( __atomic_compare_exchange_n( &workers[ w ].state, &expected, JOB_ABANDONED, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE ) )
+        {
+            oscbank_render( object, &shares[ w ], synthesis, 0 );
+            continue;
+        }
+
+        oscbank_accept( object, &workers[ w ], synthesis );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// oscbank_post - copies a share's oscillators and inputs to an idle worker and
+// wakes it
+//------------------------------------------------------------------------------
+// the wake never blocks the perform routine - if the worker holds its lock, it
+// is either about to see the job or about to sleep through it, and a share
+// it sleeps through is taken back at collection
+//------------------------------------------------------------------------------
+static void oscbank_post( t_oscbank* object, t_oscbank_worker* worker, const t_oscbank_slice* slice )
+{
+    // store pointer copies for local use
+    t_oscbank* bank = worker->bank;
+
+    // the share's first oscillator, and its size in bytes
+    t_int first = slice->offset + slice->first;
+    t_int size  = ( slice->last - slice->first ) * sizeof( t_float );
+
+    // the oscillator state a hop starts from, the targets being set from the inputs
+    memcpy( &( bank->phase           [ first ] ), &( object->phase           [ first ] ), size );
+    memcpy( &( bank->phase_inc_smooth[ first ] ), &( object->phase_inc_smooth[ first ] ), size );
+    memcpy( &( bank->amp_smooth      [ first ] ), &( object->amp_smooth      [ first ] ), size );
+
+    // pd reuses the input vectors once dsp moves on, which a late worker may not
+    memcpy( &( worker->in  [ slice->first ] ), &( slice->in  [ slice->first ] ), size );
+    memcpy( &( worker->freq[ slice->first ] ), &( slice->freq[ slice->first ] ), size );
+
+    bank->threshold = object->threshold;
+
+    worker->slice      = *slice;
+    worker->slice.in   = worker->in;
+    worker->slice.freq = worker->freq;
+
+    __atomic_store_n( &worker->state, JOB_POSTED, __ATOMIC_RELEASE );
+
+    if( pthread_mutex_trylock( &worker->lock ) == 0 )
+    {
+        pthread_cond_signal( &worker->wake );
+        pthread_mutex_unlock( &worker->lock );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// oscbank_accept - adds a finished worker's hop and copies back its oscillators
+//------------------------------------------------------------------------------
+static void oscbank_accept( t_oscbank* object, t_oscbank_worker* worker, t_float* synthesis )
+{
+    // store pointer copies for local use
+    t_oscbank* bank = worker->bank;
+    t_float*   hop  = worker->buffer;
+
+    // the share's first oscillator, and its size in bytes
+    t_int first = worker->slice.offset + worker->slice.first;
+    t_int size  = ( worker->slice.last - worker->slice.first ) * sizeof( t_float );
+
+    // sample iterator variable
+    t_int n;
+
+    for( n = 0 ; n < worker->slice.hop_size ; ++n )
+    {
+        synthesis[ n ] += hop[ n ];
+    }
+
+    memcpy( &( object->phase           [ first ] ), &( bank->phase           [ first ] ), size );
+    memcpy( &( object->phase_inc       [ first ] ), &( bank->phase_inc       [ first ] ), size );
+    memcpy( &( object->phase_inc_smooth[ first ] ), &( bank->phase_inc_smooth[ first ] ), size );
+    memcpy( &( object->amp             [ first ] ), &( bank->amp             [ first ] ), size );
+    memcpy( &( object->amp_smooth      [ first ] ), &( bank->amp_smooth      [ first ] ), size );
+
+    __atomic_store_n( &worker->state, JOB_IDLE, __ATOMIC_RELEASE );
+}
+
+
+//------------------------------------------------------------------------------
+// oscbank_seconds - returns a monotonic time in seconds
+//------------------------------------------------------------------------------
+static double oscbank_seconds( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+
+//------------------------------------------------------------------------------
+// oscbank_worker_thread - sleeps until a job is posted and renders it into its
+// buffer with its private bank
+//------------------------------------------------------------------------------
+static void* oscbank_worker_thread( void* pointer )
+{
+    t_oscbank_worker* worker = ( t_oscbank_worker* )pointer;
+
+    // job state expected by a compare and swap
+    int expected;
+
+    while( TRUE )
+    {
+        pthread_mutex_lock( &worker->lock );
+
+        while( ( __atomic_load_n( &worker->state, __ATOMIC_ACQUIRE ) != JOB_POSTED ) && !__atomic_load_n( &worker->stop, __ATOMIC_ACQUIRE ) )
+        {
+            pthread_cond_wait( &worker->wake, &worker->lock );
+        }
+
+        pthread_mutex_unlock( &worker->lock );
+
+        if( __atomic_load_n( &worker->stop, __ATOMIC_ACQUIRE ) )
+        {
+            break;
+        }
+
+        expected = JOB_POSTED;
+
+        // the perform routine may have taken the job back already
+        if( __atomic_compare_exchange_n( &worker->state, &expected, JOB_TAKEN, FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+        {
+            memset( worker->buffer, 0, worker->slice.hop_size * sizeof( t_float ) );
+
+            oscbank_render( worker->bank, &( worker->slice ), worker->buffer, 0 );
+
+            expected = JOB_TAKEN;
+
+            // an abandoned job's result is discarded
+            if( !__atomic_compare_exchange_n( &worker->state, &expected, JOB_DONE, FALSE, __ATOMIC_RELEASE, __ATOMIC_RELAXED ) )
+            {
+                __atomic_store_n( &worker->state, JOB_IDLE, __ATOMIC_RELEASE );
+            }
+        }
+    }
+
+    return NULL;
+}
+
+
+//------------------------------------------------------------------------------
+// oscbank_stop_workers - ends and joins the worker threads
+//------------------------------------------------------------------------------
+static void oscbank_stop_workers( t_oscbank* object )
+{
+    t_oscbank_worker* worker;
+    t_int             w;
+
+    for( w = 0 ; w < object->worker_count ; ++w )
+    {
+        worker = &( object->workers[ w ] );
+
+        pthread_mutex_lock( &worker->lock );
+        __atomic_store_n( &worker->stop, TRUE, __ATOMIC_RELEASE );
+        pthread_cond_signal( &worker->wake );
+        pthread_mutex_unlock( &worker->lock );
+    }
+
+    for( w = 0 ; w < object->worker_count ; ++w )
+    {
+        worker = &( object->workers[ w ] );
+
+        pthread_join( worker->thread, NULL );
+
+        pthread_mutex_destroy( &worker->lock );
+        pthread_cond_destroy( &worker->wake );
+
+        free( worker->bank->phase );
+        free( worker->bank->phase_inc );
+        free( worker->bank->phase_inc_smooth );
+        free( worker->bank->phase_inc_smooth_inc );
+        free( worker->bank->amp );
+        free( worker->bank->amp_smooth );
+        free( worker->bank->amp_smooth_inc );
+        free( worker->bank );
+        free( worker->in );
+        free( worker->freq );
+        free( worker->buffer );
+    }
+
+    if( object->workers )
+    {
+        free( object->workers );
+        object->workers = NULL;
+    }
+
+    object->worker_count = 0;
+}
+
+#else
+
+//------------------------------------------------------------------------------
+// oscbank_render_threads - without threads, renders the slice inline
+//------------------------------------------------------------------------------
+static void oscbank_render_threads( t_oscbank* object, const t_oscbank_slice* slice, t_float* synthesis )
+{
+    oscbank_render( object, slice, synthesis, 0 );
+}
+
+#endif
+
+
+//------------------------------------------------------------------------------
+// oscbank_size_workers - sizes the workers' banks, inputs, and hop buffers to
+// the object's, once any worker finishing an abandoned job is done with them
+//------------------------------------------------------------------------------
+static void oscbank_size_workers( t_oscbank* object )
+{
+    // sizes of the state, input, and hop arrays, never zero before dsp starts
+    t_int state_size  = ClipMin( object->half_frames * object->channels * sizeof( t_float ), 1 );
+    t_int input_size  = ClipMin( object->half_frames * sizeof( t_float ), 1 );
+    t_int memory_size = ClipMin( object->memory_size, 1 );
+
+    t_oscbank_worker* worker;
+    t_oscbank*        bank;
+    t_int             w;
+
+    for( w = 0 ; w < object->worker_count ; ++w )
+    {
+        worker = &( object->workers[ w ] );
+        bank   = worker->bank;
+
+#ifdef OSCBANK_THREADS
+        while( __atomic_load_n( &worker->state, __ATOMIC_ACQUIRE ) != JOB_IDLE )
+        {
+            usleep( WORKER_NAP_MICROSECONDS );
+        }
+#endif
+
+        bank->phase                = ( t_float* )realloc( bank->phase,                state_size );
+        bank->phase_inc            = ( t_float* )realloc( bank->phase_inc,            state_size );
+        bank->phase_inc_smooth     = ( t_float* )realloc( bank->phase_inc_smooth,     state_size );
+        bank->phase_inc_smooth_inc = ( t_float* )realloc( bank->phase_inc_smooth_inc, state_size );
+        bank->amp                  = ( t_float* )realloc( bank->amp,                  state_size );
+        bank->amp_smooth           = ( t_float* )realloc( bank->amp_smooth,           state_size );
+        bank->amp_smooth_inc       = ( t_float* )realloc( bank->amp_smooth_inc,       state_size );
+        worker->in                 = ( t_float* )realloc( worker->in,                 input_size );
+        worker->freq               = ( t_float* )realloc( worker->freq,               input_size );
+        worker->buffer             = ( t_float* )realloc( worker->buffer,             memory_size );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// oscbank_perform_sparse - synthesizes the partials of sparse partial lists
+//------------------------------------------------------------------------------
+// only listed oscillators run: those named by this hop's list, plus those of
+// the previous hop, which glide to silence when dropped and stay listed until
+// their amplitude, frequency, and phase are all back at rest - a newly listed
+// oscillator starts at its partial's frequency and fades in, so the partials
+// of a track begin in tune rather than gliding up from zero
+//------------------------------------------------------------------------------
+static void oscbank_perform_sparse( t_oscbank* object, t_float* in1, t_float* out, t_int frames, t_int channels )
+{
+    // store pointer copies for local use
+    t_float* phase        = object->phase;
+    t_float* phase_inc    = object->phase_inc;
+    t_float* amp          = object->amp;
+    t_float* synthesis    = object->synthesis;
+    t_float* frame        = object->frame;
+    t_int*   listed       = object->listed;
+
+    // store variable copies for local use
+    t_int overlap     = object->overlap;
+    t_int half_frames = object->half_frames;
+
     // pre-calculate intermediate values to save cpu cycles
     t_float phase_inc_coeff = ( 1.0 / ( object->sample_rate / overlap ) ) * WAVETABLE_SIZE;
     t_float amp_coeff       = ( 1.0 / frames ) * overlap;
     t_int   hop_size        = frames / overlap;
     t_float smoothing_coeff =  1.0 / hop_size;
 
-    // signal vector iterator variables
-    t_int n = -1;
-    t_int o = -1;
+    // inverse fft frame size, or zero to run the oscillators
+    t_int fft_size = object->ifft ? oscbank_ifft_size( hop_size ) : 0;
+
+    // partial, channel, and list iterator variables
+    t_int partial;
+    t_int channel;
+    t_int index;
+
+    // partial list of the current channel
+    t_int    count;
+    t_float* bins;
+    t_float* mags;
+    t_float* freqs;
+
+    // listed oscillators of the current channel
+    t_int* active;
+    t_int  active_count;
+    t_int  kept;
 
-    // clear output array
-    memset( synthesis, 0, frames * sizeof( t_float ) );
+    // oscillator and bin variables
+    t_int   o;
+    t_float bin;
 
-    // iterate through oscillator indices
-    while( ++o < object->half_frames )
+    for( channel = 0 ; channel < channels ; ++channel )
     {
-        // calculate amplitude based on input magnitude
-        amp[ o ] = in1[ o ] * amp_coeff;
+        // locate this channel's partial list
+        count = PartialsCount( in1, frames );
+        bins  = PARTIALS_BINS ( in1, frames );
+        mags  = PARTIALS_MAGS ( in1, frames );
+        freqs = PARTIALS_FREQS( in1, frames );
+
+        // locate this channel's listed oscillators
+        active       = &( object->active[ channel * half_frames ] );
+        active_count = object->active_count[ channel ];
+
+        // oscillators sounding last hop fade out unless listed again
+        for( index = 0 ; index < active_count ; ++index )
+        {
+            o = channel * half_frames + active[ index ];
 
-        // calculate phase increment based on input frequency
-        phase_inc[ o ] = in2[ o ] * phase_inc_coeff;
+            amp      [ o ] = 0;
+            phase_inc[ o ] = 0;
+        }
+
+        // set the targets of this hop's partials, listing new oscillators
+        for( partial = 0 ; partial < count ; ++partial )
+        {
+            bin = FixNan( bins[ partial ] );
 
-        // calculate amplitude smoothing increment
-        amp_smooth_inc[ o ] = ( amp[ o ] - amp_smooth[ o ] ) * smoothing_coeff;
+            // skip bins outside the oscillator bank
+            if( ( bin < 0 ) || ( bin >= half_frames ) )
+            {
+                continue;
+            }
 
-        // calculate phase increment smoothing increment
-        phase_inc_smooth_inc[ o ] = ( phase_inc[ o ] - phase_inc_smooth[ o ] ) * smoothing_coeff;
+            o = channel * half_frames + ( t_int )bin;
 
-        // reset vector iterator
-        n = -1;
+            // calculate amplitude and phase increment as in dense mode
+            amp      [ o ] = FlushDenormal( mags [ partial ] * amp_coeff );
+            phase_inc[ o ] = FlushDenormal( freqs[ partial ] * phase_inc_coeff );
 
-        while( ++n < hop_size )
+            if( !listed[ o ] )
+            {
+                object->phase_inc_smooth[ o ] = phase_inc[ o ];
+
+                listed[ o ] = TRUE;
+                active[ active_count++ ] = ( t_int )bin;
+            }
+        }
+
+        // clear output array or frame
+        if( fft_size )
+        {
+            memset( frame, 0, fft_size * sizeof( t_float ) );
+        }
+        else
         {
-            // if amp is below threshold, reset phase and do not calculate waveform
-            if( amp_smooth[ o ] < threshold )
+            memset( synthesis, 0, frames * sizeof( t_float ) );
+        }
+
+        // run the listed oscillators, keeping those not yet at rest
+        for( index = 0, kept = 0 ; index < active_count ; ++index )
+        {
+            o = channel * half_frames + active[ index ];
+
+            if( fft_size )
             {
-                phase[ o ] = 0.0;
+                oscbank_partial( object, o, frame, fft_size, hop_size );
             }
-            // otherwise calculate waveform
             else
             {
-                // accumulate waveform into synthesis array
-                synthesis[ n ] += wavetable[ ( unsigned long )phase[ o ] ] * amp_smooth[ o ];
-
-                // increment phase
-                phase[ o ] += phase_inc_smooth[ o ];
+                oscbank_oscillator( object, o, synthesis, hop_size, smoothing_coeff );
+            }
 
-                // & wrap phase while preserving decimal values
-                phase[ o ] = ( ( long )phase[ o ] & wavetable_mask ) + ( phase[ o ] - ( long )phase[ o ] );
+            if( ( amp[ o ] != 0 ) || ( phase_inc[ o ] != 0 ) || ( phase[ o ] != 0 ) )
+            {
+                active[ kept++ ] = active[ index ];
             }
+            else
+            {
+                listed[ o ] = FALSE;
+            }
+        }
+
+        object->active_count[ channel ] = kept;
 
-            // increment phase and amplitude with smoothing increments
-            amp_smooth      [ o ] += amp_smooth_inc      [ o ];
-            phase_inc_smooth[ o ] += phase_inc_smooth_inc[ o ];
+        // copy synthesized waveform to output
+        if( fft_size )
+        {
+            oscbank_ifft_hop( object, channel, out, frames, hop_size );
+        }
+        else
+        {
+            memcpy( out, synthesis, object->memory_size );
         }
 
-        // set phase and amplitude to target values for next dsp loop
-        amp_smooth      [ o ] = amp      [ o ];
-        phase_inc_smooth[ o ] = phase_inc[ o ];
+        // move on to the next channel's signals
+        in1 += frames;
+        out += frames;
     }
+}
 
-    // copy synthesized waveform to output
-    memcpy( out, synthesis, object->memory_size );
+
+//------------------------------------------------------------------------------
+// oscbank_perform - the signal processing function of this object
+//------------------------------------------------------------------------------
+static t_int* oscbank_perform( t_int* io )
+{
+    // store variables from dsp input/output array
+    t_float*   in1        = ( t_float*   )( io[ 1 ] );
+    t_float*   in2        = ( t_float*   )( io[ 2 ] );
+    t_float*   out        = ( t_float*   )( io[ 3 ] );
+    t_int      frames     = ( t_int      )( io[ 4 ] );
+    t_int      channels   = ( t_int      )( io[ 5 ] );
+    t_int      channels_2 = ( t_int      )( io[ 6 ] );
+    t_oscbank* object     = ( t_oscbank* )( io[ 7 ] );
+
+    // store pointer copies for local use
+    t_float* synthesis = object->synthesis;
+    t_float* frame     = object->frame;
+
+    // store variable copies for local use
+    t_int overlap     = object->overlap;
+    t_int half_frames = object->half_frames;
+
+    // pre-calculate intermediate values to save cpu cycles
+    t_float phase_inc_coeff = ( 1.0 / ( object->sample_rate / overlap ) ) * WAVETABLE_SIZE;
+    t_float amp_coeff       = ( 1.0 / frames ) * overlap;
+    t_int   hop_size        = frames / overlap;
+    t_float smoothing_coeff =  1.0 / hop_size;
+
+    // inverse fft frame size, or zero to run the oscillators
+    t_int fft_size = object->ifft ? oscbank_ifft_size( hop_size ) : 0;
+
+    // channel iterator variable
+    t_int channel;
+
+    // the oscillators of the current channel
+    t_oscbank_slice slice;
+
+    slice.first           = 0;
+    slice.last            = half_frames;
+    slice.hop_size        = hop_size;
+    slice.smoothing_coeff = smoothing_coeff;
+    slice.amp_coeff       = amp_coeff;
+    slice.phase_inc_coeff = phase_inc_coeff;
+
+    // make the kernel when the frame size changes
+    if( fft_size && ( fft_size != object->fft_size ) )
+    {
+        oscbank_kernel( object, fft_size );
+    }
+
+    // sparse partial lists carry their own frequencies
+    if( object->sparse )
+    {
+        oscbank_perform_sparse( object, in1, out, frames, channels );
+
+        // return the dsp input/output array address plus one more than its size
+        // to provide a pointer to the next perform function in pd's call list
+        return &( io[ 8 ] );
+    }
+
+    // the channel loop - each channel is a block of frames after the last and
+    // owns the next half_frames oscillators, while the frequency inlet's
+    // channels repeat when it has fewer than the amplitude inlet
+    for( channel = 0 ; channel < channels ; ++channel )
+    {
+        // locate this channel's inputs and oscillators
+        slice.in     = in1;
+        slice.freq   = &( in2[ ( channel % channels_2 ) * frames ] );
+        slice.offset = channel * half_frames;
+
+        if( fft_size )
+        {
+            // draw the partials into a cleared frame and transform it
+            memset( frame, 0, fft_size * sizeof( t_float ) );
+
+            oscbank_render( object, &slice, frame, fft_size );
+
+            oscbank_ifft_hop( object, channel, out, frames, hop_size );
+        }
+        else
+        {
+            // clear output array
+            memset( synthesis, 0, frames * sizeof( t_float ) );
+
+            // share the oscillators with the worker threads when there are any
+            if( object->worker_count )
+            {
+                oscbank_render_threads( object, &slice, synthesis );
+            }
+            else
+            {
+                oscbank_render( object, &slice, synthesis, 0 );
+            }
+
+            // copy synthesized waveform to output
+            memcpy( out, synthesis, object->memory_size );
+        }
+
+        // move on to the next channel's signals
+        in1 += frames;
+        out += frames;
+    }
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
-    return &( io[ 6 ] );
+    return &( io[ 8 ] );
 }
 
 
@@ -238,36 +1222,79 @@ static t_int* oscbank_perform( t_int* io )
 //------------------------------------------------------------------------------
 static void oscbank_dsp( t_oscbank* object, t_signal **sig )
 {
-    object->sample_rate       = sig[ 0 ]->s_sr;
-
     // calculate memory size for realloc and memset
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // save memory size for use in dsp loop
-    object->memory_size = memory_size;
-
-    t_int half_frames = sig[ 0 ]->s_n / 2;
-    object->half_frames = half_frames;
-
-    // reallocate memory
-    object->synthesis            = ( t_float* )realloc( object->synthesis,            memory_size );
-    object->phase                = ( t_float* )realloc( object->phase,                half_frames * sizeof( t_float ) );
-    object->phase_inc            = ( t_float* )realloc( object->phase_inc,            half_frames * sizeof( t_float ) );
-    object->phase_inc_smooth     = ( t_float* )realloc( object->phase_inc_smooth,     half_frames * sizeof( t_float ) );
-    object->phase_inc_smooth_inc = ( t_float* )realloc( object->phase_inc_smooth_inc, half_frames * sizeof( t_float ) );
-    object->amp                  = ( t_float* )realloc( object->amp,                  half_frames * sizeof( t_float ) );
-    object->amp_smooth           = ( t_float* )realloc( object->amp_smooth,           half_frames * sizeof( t_float ) );
-    object->amp_smooth_inc       = ( t_float* )realloc( object->amp_smooth_inc,       half_frames * sizeof( t_float ) );
-
-    // clear memory
-    memset( object->synthesis,            0, half_frames * sizeof( t_float ) );
-    memset( object->phase,                0, half_frames * sizeof( t_float ) );
-    memset( object->phase_inc,            0, half_frames * sizeof( t_float ) );
-    memset( object->phase_inc_smooth,     0, half_frames * sizeof( t_float ) );
-    memset( object->phase_inc_smooth_inc, 0, half_frames * sizeof( t_float ) );
-    memset( object->amp,                  0, half_frames * sizeof( t_float ) );
-    memset( object->amp_smooth,           0, half_frames * sizeof( t_float ) );
-    memset( object->amp_smooth_inc,       0, half_frames * sizeof( t_float ) );
+    // number of channels in the amplitude inlet, which the outlet shares
+    t_int channels = SignalChannels( sig[ 0 ] );
+
+    // give the outlet as many channels as the amplitude inlet
+    SignalSetChannels( &sig[ 2 ], channels );
+
+    // only reallocate and clear memory when the vector size, channel count, or sample rate has changed
+    if( ( memory_size != object->memory_size ) || ( channels != object->channels ) || ( sig[ 0 ]->s_sr != object->sample_rate ) )
+    {
+        object->sample_rate = sig[ 0 ]->s_sr;
+
+        // save memory size for use in dsp loop
+        object->memory_size = memory_size;
+
+        // save channel count for use in oscbank_reset
+        object->channels = channels;
+
+        t_int half_frames = sig[ 0 ]->s_n / 2;
+        object->half_frames = half_frames;
+
+        // oscillator state of every channel
+        t_int state_size = half_frames * channels * sizeof( t_float );
+        t_int list_size  = half_frames * channels * sizeof( t_int );
+
+        // inverse fft frames are at most IFFT_OVERLAP vectors long
+        t_int frame_size = sig[ 0 ]->s_n * IFFT_OVERLAP * sizeof( t_float );
+
+        // reallocate memory
+        object->synthesis            = ( t_float* )realloc( object->synthesis,            memory_size );
+        object->phase                = ( t_float* )realloc( object->phase,                state_size );
+        object->phase_inc            = ( t_float* )realloc( object->phase_inc,            state_size );
+        object->phase_inc_smooth     = ( t_float* )realloc( object->phase_inc_smooth,     state_size );
+        object->phase_inc_smooth_inc = ( t_float* )realloc( object->phase_inc_smooth_inc, state_size );
+        object->amp                  = ( t_float* )realloc( object->amp,                  state_size );
+        object->amp_smooth           = ( t_float* )realloc( object->amp_smooth,           state_size );
+        object->amp_smooth_inc       = ( t_float* )realloc( object->amp_smooth_inc,       state_size );
+        object->active               = ( t_int*   )realloc( object->active,               list_size );
+        object->active_count         = ( t_int*   )realloc( object->active_count,         channels * sizeof( t_int ) );
+        object->listed               = ( t_int*   )realloc( object->listed,               list_size );
+        object->frame                = ( t_float* )realloc( object->frame,                frame_size );
+        object->overlap_add          = ( t_float* )realloc( object->overlap_add,          frame_size * channels );
+
+        // clear memory
+        memset( object->synthesis,            0, memory_size );
+        memset( object->phase,                0, state_size );
+        memset( object->phase_inc,            0, state_size );
+        memset( object->phase_inc_smooth,     0, state_size );
+        memset( object->phase_inc_smooth_inc, 0, state_size );
+        memset( object->amp,                  0, state_size );
+        memset( object->amp_smooth,           0, state_size );
+        memset( object->amp_smooth_inc,       0, state_size );
+        memset( object->active_count,         0, channels * sizeof( t_int ) );
+        memset( object->listed,               0, list_size );
+        memset( object->overlap_add,          0, frame_size * channels );
+
+        // make the kernel again on the next hop
+        object->fft_size = 0;
+
+        // the workers' private copies follow the object's sizes
+        oscbank_size_workers( object );
+    }
+
+    // warn when the hop cannot be synthesized by inverse fft
+    if( object->ifft && !oscbank_ifft_size( sig[ 0 ]->s_n / object->overlap ) )
+    {
+        pd_error( object, "oscbank~: ifft needs a power of two hop of at least %d samples, using oscillators", IFFT_MIN_HOP );
+    }
+
+    // start timing this object ( when profiling is compiled in )
+    PROFILE_DSP_BEGIN( object );
 
     // dsp_add arguments
     //--------------------------------------------------------------------------
@@ -277,8 +1304,38 @@ static void oscbank_dsp( t_oscbank* object, t_signal **sig )
     // inlet 2 sample vector
     // outlet sample vector
     // sample frames to process (vector size)
+    // number of amplitude inlet channels
+    // number of frequency inlet channels
     // pointer to this object
-    dsp_add( oscbank_perform, 5, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 0 ]->s_n, object );
+    dsp_add( oscbank_perform, 7, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 0 ]->s_n, channels, SignalChannels( sig[ 1 ] ), object );
+
+    // stop timing this object
+    PROFILE_DSP_END( object );
+}
+
+
+//------------------------------------------------------------------------------
+// oscbank_reset - clears the oscillator phase and amplitude state
+//------------------------------------------------------------------------------
+static void oscbank_reset( t_oscbank* object )
+{
+    // memory size of the oscillator state arrays ( all channels )
+    t_int state_size = object->half_frames * object->channels * sizeof( t_float );
+
+    // only clear memory that has been allocated
+    if( object->phase )
+    {
+        memset( object->phase,                0, state_size );
+        memset( object->phase_inc,            0, state_size );
+        memset( object->phase_inc_smooth,     0, state_size );
+        memset( object->phase_inc_smooth_inc, 0, state_size );
+        memset( object->amp,                  0, state_size );
+        memset( object->amp_smooth,           0, state_size );
+        memset( object->amp_smooth_inc,       0, state_size );
+        memset( object->active_count,         0, object->channels * sizeof( t_int ) );
+        memset( object->listed,               0, object->half_frames * object->channels * sizeof( t_int ) );
+        memset( object->overlap_add,          0, object->half_frames * 2 * IFFT_OVERLAP * object->channels * sizeof( t_float ) );
+    }
 }
 
 
@@ -291,6 +1348,108 @@ static void oscbank_overlap( t_oscbank* object, t_floatarg overlap )
 }
 
 
+//------------------------------------------------------------------------------
+// oscbank_sparse - switches inlet 1 between dense magnitudes and a sparse
+// partial list, resetting the oscillators
+//------------------------------------------------------------------------------
+static void oscbank_sparse( t_oscbank* object, t_floatarg sparse )
+{
+    object->sparse = ( sparse != 0 );
+
+    // dense mode keeps no oscillator lists, so start both modes from rest
+    oscbank_reset( object );
+}
+
+
+//------------------------------------------------------------------------------
+// oscbank_ifft - switches between oscillator and inverse fft synthesis,
+// resetting the oscillators
+//------------------------------------------------------------------------------
+static void oscbank_ifft( t_oscbank* object, t_floatarg ifft )
+{
+    object->ifft = ( ifft != 0 );
+
+    // the modes keep phase at different points in a hop
+    oscbank_reset( object );
+}
+
+
+//------------------------------------------------------------------------------
+// oscbank_threads - starts worker threads to share the dense oscillators,
+// replacing any running ones ( zero renders everything on pd's thread )
+//------------------------------------------------------------------------------
+// pd handles this message on its dsp thread, so the workers take that thread's
+// scheduling, realtime when pd runs with -rt, or start with the defaults where
+// the system refuses it
+//------------------------------------------------------------------------------
+static void oscbank_threads( t_oscbank* object, t_floatarg threads )
+{
+#ifdef OSCBANK_THREADS
+    t_int count = Clip( threads, 0, MAX_THREADS );
+    t_int w;
+
+    // scheduling of this thread, and thread attributes carrying it
+    pthread_attr_t     attributes;
+    struct sched_param parameters;
+    int                policy;
+
+    t_oscbank_worker* worker;
+
+    oscbank_stop_workers( object );
+
+    if( count == 0 )
+    {
+        return;
+    }
+
+    pthread_attr_init( &attributes );
+
+    if( pthread_getschedparam( pthread_self(), &policy, &parameters ) == 0 )
+    {
+        pthread_attr_setinheritsched( &attributes, PTHREAD_EXPLICIT_SCHED );
+        pthread_attr_setschedpolicy ( &attributes, policy );
+        pthread_attr_setschedparam  ( &attributes, &parameters );
+    }
+
+    object->workers = ( t_oscbank_worker* )calloc( count, sizeof( t_oscbank_worker ) );
+
+    for( w = 0 ; w < count ; ++w )
+    {
+        worker = &( object->workers[ w ] );
+
+        worker->object          = object;
+        worker->bank            = ( t_oscbank* )calloc( 1, sizeof( t_oscbank ) );
+        worker->bank->wavetable = object->wavetable;
+        worker->state           = JOB_IDLE;
+        worker->stop            = FALSE;
+
+        pthread_mutex_init( &worker->lock, NULL );
+        pthread_cond_init( &worker->wake, NULL );
+
+        if( ( pthread_create( &worker->thread, &attributes, oscbank_worker_thread, worker ) != 0 ) &&
+            ( pthread_create( &worker->thread, NULL,        oscbank_worker_thread, worker ) != 0 ) )
+        {
+            pd_error( object, "oscbank~: could only start %d of %d worker threads", ( int )w, ( int )count );
+
+            pthread_mutex_destroy( &worker->lock );
+            pthread_cond_destroy( &worker->wake );
+            free( worker->bank );
+            break;
+        }
+    }
+
+    pthread_attr_destroy( &attributes );
+
+    // perform only posts jobs to the workers that started
+    object->worker_count = w;
+
+    oscbank_size_workers( object );
+#else
+    pd_error( object, "oscbank~: worker threads are not available on this platform" );
+#endif
+}
+
+
 //------------------------------------------------------------------------------
 // oscbank_new - instantiates a copy of this object in pd
 //------------------------------------------------------------------------------
@@ -299,6 +1458,9 @@ static void* oscbank_new( t_symbol* selector, t_int items, t_atom* list )
     // create a pointer to this object
     t_oscbank* object = ( t_oscbank* )pd_new( oscbank_class );
 
+    // register with the dsp profiler
+    PROFILE_REGISTER( object, "oscbank~" );
+
     // create two new signal inlets
     signalinlet_new( &object->object, object->inlet_2 );
 
@@ -318,10 +1480,23 @@ static void* oscbank_new( t_symbol* selector, t_int items, t_atom* list )
     object->amp                  = NULL;
     object->amp_smooth           = NULL;
     object->amp_smooth_inc       = NULL;
+    object->active               = NULL;
+    object->active_count         = NULL;
+    object->listed               = NULL;
+    object->frame                = NULL;
+    object->overlap_add          = NULL;
+    object->workers              = NULL;
 
     // initialize variables
-    object->overlap   = 1;
-    object->threshold = DbToA( SYNTH_THRESHOLD );
+    object->memory_size  = 0;
+    object->half_frames  = 0;
+    object->channels     = 0;
+    object->overlap      = 1;
+    object->threshold    = DbToA( SYNTH_THRESHOLD );
+    object->sparse       = FALSE;
+    object->ifft         = FALSE;
+    object->fft_size     = 0;
+    object->worker_count = 0;
 
     // allocate wavetable memory
     object->wavetable = ( t_float* )calloc( WAVETABLE_SIZE, sizeof( t_float ) );
@@ -366,6 +1541,14 @@ static void* oscbank_new( t_symbol* selector, t_int items, t_atom* list )
 //------------------------------------------------------------------------------
 static void oscbank_free( t_oscbank* object )
 {
+    // unregister from the dsp profiler
+    PROFILE_UNREGISTER( object );
+
+#ifdef OSCBANK_THREADS
+    // end the worker threads before the memory they render into
+    oscbank_stop_workers( object );
+#endif
+
     // if memory is allocated
     if( object->phase )
     {
@@ -413,6 +1596,36 @@ static void oscbank_free( t_oscbank* object )
         object->amp_smooth_inc = NULL;
     }
 
+    if( object->active )
+    {
+        free( object->active );
+        object->active = NULL;
+    }
+
+    if( object->active_count )
+    {
+        free( object->active_count );
+        object->active_count = NULL;
+    }
+
+    if( object->listed )
+    {
+        free( object->listed );
+        object->listed = NULL;
+    }
+
+    if( object->frame )
+    {
+        free( object->frame );
+        object->frame = NULL;
+    }
+
+    if( object->overlap_add )
+    {
+        free( object->overlap_add );
+        object->overlap_add = NULL;
+    }
+
     if( object->wavetable )
     {
         free( object->wavetable );
@@ -434,7 +1647,7 @@ static void oscbank_free( t_oscbank* object )
 void oscbank_tilde_setup( void )
 {
     // creates an instance of this object and describes it to pd
-    oscbank_class = class_new( gensym( "oscbank~" ), ( t_newmethod )oscbank_new, ( t_method )oscbank_free, sizeof( t_oscbank ), 0, A_GIMME, 0 );
+    oscbank_class = class_new( gensym( "oscbank~" ), ( t_newmethod )oscbank_new, ( t_method )oscbank_free, sizeof( t_oscbank ), MULTICHANNEL, A_GIMME, 0 );
 
     // declares leftmost inlet as a signal inlet
     CLASS_MAINSIGNALIN( oscbank_class, t_oscbank, inlet_1 );
@@ -444,6 +1657,18 @@ void oscbank_tilde_setup( void )
 
     // associate a method with the "overlap" symbol for subsequent overlap inlet handling
     class_addmethod( oscbank_class, ( t_method )oscbank_overlap, gensym( "overlap" ), A_FLOAT, 0 );
+
+    // installs oscbank_reset to respond to "reset" message
+    class_addmethod( oscbank_class, ( t_method )oscbank_reset, gensym( "reset" ), 0 );
+
+    // installs oscbank_sparse to respond to "sparse" message
+    class_addmethod( oscbank_class, ( t_method )oscbank_sparse, gensym( "sparse" ), A_FLOAT, 0 );
+
+    // installs oscbank_ifft to respond to "ifft" message
+    class_addmethod( oscbank_class, ( t_method )oscbank_ifft, gensym( "ifft" ), A_FLOAT, 0 );
+
+    // installs oscbank_threads to respond to "threads" message
+    class_addmethod( oscbank_class, ( t_method )oscbank_threads, gensym( "threads" ), A_FLOAT, 0 );
 }
 
 
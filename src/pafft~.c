@@ -84,6 +84,9 @@ typedef struct pafft
     // rotation amount
     t_float shift;
 
+    // dsp timing record read by spectprof ( empty unless profiling is compiled in )
+    PROFILE_MEMBER
+
 } t_pafft;
 
 
@@ -105,12 +108,14 @@ void          pafft_tilde_setup     ( void );
 static t_int* pafft_perform( t_int* io )
 {
     // store variables from dsp input/output array
-    t_float* in1    = ( t_float* )( io[ 1 ] );
-    t_float* in2    = ( t_float* )( io[ 2 ] );
-    t_float* out1   = ( t_float* )( io[ 3 ] );
-    t_float* out2   = ( t_float* )( io[ 4 ] );
-    t_int    frames = ( t_int    )( io[ 5 ] );
-    t_pafft* object = ( t_pafft* )( io[ 6 ] );
+    t_float* in1        = ( t_float* )( io[ 1 ] );
+    t_float* in2        = ( t_float* )( io[ 2 ] );
+    t_float* out1       = ( t_float* )( io[ 3 ] );
+    t_float* out2       = ( t_float* )( io[ 4 ] );
+    t_int    frames     = ( t_int    )( io[ 5 ] );
+    t_int    channels   = ( t_int    )( io[ 6 ] );
+    t_int    channels_2 = ( t_int    )( io[ 7 ] );
+    t_pafft* object     = ( t_pafft* )( io[ 8 ] );
 
     // store values from object's data structure
     t_float* rfft_array   = object->rfft_array;
@@ -121,43 +126,60 @@ static t_int* pafft_perform( t_int* io )
     t_int    window_size  = object->window_array_size;
     t_int    memory_size  = object->memory_size;
 
-    // signal vector iterator variable
-    t_int n = -1;
+    // signal vector and channel iterator variables
+    t_int n;
+    t_int channel;
 
-    // store shift amount
-    t_int shift = ( t_int )in2[ 0 ];
+    // shift amount
+    t_int shift;
 
-    // make sure window array exists and can be used
-    if( ( window_array != NULL ) && ( window_size == frames ) )
+    // the channel loop - each channel is a block of frames after the last, and
+    // the shift inlet's channels repeat when it has fewer than the signal inlet
+    for( channel = 0 ; channel < channels ; ++channel )
     {
-        // window input into rfft_array
-        while( ++n < frames )
+        // store shift amount
+        shift = ( t_int )in2[ ( channel % channels_2 ) * frames ];
+
+        // reset signal vector iterator
+        n = -1;
+
+        // make sure window array exists and can be used
+        if( ( window_array != NULL ) && ( window_size == frames ) )
         {
-            rfft_array[ n ] = in1[ n ] * window_array[ n ].w_float;
+            // window input into rfft_array
+            while( ++n < frames )
+            {
+                rfft_array[ n ] = in1[ n ] * window_array[ n ].w_float;
+            }
+        }
+        else
+        {
+            // copy input directly into rfft_array
+            memcpy( rfft_array, in1, memory_size );
         }
-    }
-    else
-    {
-        // copy input directly into rfft_array
-        memcpy( rfft_array, in1, memory_size );
-    }
 
-    // rotate rfft_array data
-    RotateArray( rfft_array, temp_array, shift, frames );
+        // rotate rfft_array data
+        RotateArray( rfft_array, temp_array, shift, frames );
 
-    // do the real fft
-    mayer_realfft( ( int )frames, rfft_array );
+        // do the real fft
+        mayer_realfft( ( int )frames, rfft_array );
 
-    // copy fft data into real and imaginary arrays
-    MayerRealFFTUnpack( rfft_array, real_array, imag_array, frames );
+        // copy fft data into real and imaginary arrays
+        MayerRealFFTUnpack( rfft_array, real_array, imag_array, frames );
 
-    // copy data to outlets
-    memcpy( out1, real_array, memory_size );
-    memcpy( out2, imag_array, memory_size );
+        // copy data to outlets
+        memcpy( out1, real_array, memory_size );
+        memcpy( out2, imag_array, memory_size );
+
+        // move on to the next channel
+        in1  += frames;
+        out1 += frames;
+        out2 += frames;
+    }
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
-    return &( io[ 7 ] );
+    return &( io[ 9 ] );
 }
 
 
@@ -173,25 +195,39 @@ static void pafft_dsp( t_pafft* object, t_signal **sig )
         return;
     }
 
-    // calculate memory size for realloc and memset
-    t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
+    // number of channels in the signal inlet, which the outlets share
+    t_int channels = SignalChannels( sig[ 0 ] );
 
-    // allocate enough memory to hold signal vector data
-    object->rfft_array = realloc( object->rfft_array, memory_size );
-    object->real_array = realloc( object->real_array, memory_size );
-    object->imag_array = realloc( object->imag_array, memory_size );
-    object->temp_array = realloc( object->temp_array, memory_size );
+    // calculate memory size for realloc and memset ( one channel )
+    t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // set real and imaginary memory to zero
-    memset( object->real_array,  0, memory_size );
-    memset( object->imag_array,  0, memory_size );
+    // give the outlets as many channels as the signal inlet
+    SignalSetChannels( &sig[ 2 ], channels );
+    SignalSetChannels( &sig[ 3 ], channels );
 
-    // save memory size for use in dsp loop
-    object->memory_size = memory_size;
+    // only reallocate memory when the vector size has changed
+    if( memory_size != object->memory_size )
+    {
+        // allocate enough memory to hold signal vector data
+        object->rfft_array = realloc( object->rfft_array, memory_size );
+        object->real_array = realloc( object->real_array, memory_size );
+        object->imag_array = realloc( object->imag_array, memory_size );
+        object->temp_array = realloc( object->temp_array, memory_size );
+
+        // set real and imaginary memory to zero
+        memset( object->real_array,  0, memory_size );
+        memset( object->imag_array,  0, memory_size );
+
+        // save memory size for use in dsp loop
+        object->memory_size = memory_size;
+    }
 
     // set the window array associated with this object
     pafft_set_window_array( object );
 
+    // start timing this object ( when profiling is compiled in )
+    PROFILE_DSP_BEGIN( object );
+
     // dsp_add arguments
     //--------------------------------------------------------------------------
     // perform routine
@@ -201,8 +237,13 @@ static void pafft_dsp( t_pafft* object, t_signal **sig )
     // outlet 1 sample vector
     // outlet 2 sample vector
     // sample frames to process (vector size)
+    // number of signal inlet channels
+    // number of shift inlet channels
     // pointer to this object
-    dsp_add( pafft_perform, 6, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 0 ]->s_n, object );
+    dsp_add( pafft_perform, 8, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 0 ]->s_n, channels, SignalChannels( sig[ 1 ] ), object );
+
+    // stop timing this object
+    PROFILE_DSP_END( object );
 }
 
 
@@ -269,6 +310,9 @@ static void* pafft_new( t_symbol* selector, t_int items, t_atom* list )
     // create a pointer to this object
     t_pafft* object = ( t_pafft* )pd_new( pafft_class );
 
+    // register with the dsp profiler
+    PROFILE_REGISTER( object, "pafft~" );
+
     // create a second signal inlet
     signalinlet_new( &object->object, object->inlet_2 );
 
@@ -313,6 +357,9 @@ static void* pafft_new( t_symbol* selector, t_int items, t_atom* list )
 //------------------------------------------------------------------------------
 static void pafft_free( t_pafft* object )
 {
+    // unregister from the dsp profiler
+    PROFILE_UNREGISTER( object );
+
     // if memory is allocated
     if( object->rfft_array )
     {
@@ -345,7 +392,7 @@ static void pafft_free( t_pafft* object )
 void pafft_tilde_setup( void )
 {
     // creates an instance of this object and describes it to pd
-    pafft_class = class_new( gensym( "pafft~" ), ( t_newmethod )pafft_new, ( t_method )pafft_free, sizeof( t_pafft ), 0, A_GIMME, 0 );
+    pafft_class = class_new( gensym( "pafft~" ), ( t_newmethod )pafft_new, ( t_method )pafft_free, sizeof( t_pafft ), MULTICHANNEL, A_GIMME, 0 );
 
     // declares leftmost inlet as a signal inlet
     CLASS_MAINSIGNALIN( pafft_class, t_pafft, inlet_1 );
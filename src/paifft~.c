@@ -81,6 +81,9 @@ typedef struct paifft
     // pointer to temp_array for rotation
     t_float* temp_array;
 
+    // dsp timing record read by spectprof ( empty unless profiling is compiled in )
+    PROFILE_MEMBER
+
 } t_paifft;
 
 
@@ -102,12 +105,15 @@ void          paifft_tilde_setup     ( void );
 static t_int* paifft_perform( t_int* io )
 {
     // store variables from dsp input/output array
-    t_float*  in1    = ( t_float*  )( io[ 1 ] );
-    t_float*  in2    = ( t_float*  )( io[ 2 ] );
-    t_float*  in3    = ( t_float*  )( io[ 3 ] );
-    t_float*  out    = ( t_float*  )( io[ 4 ] );
-    t_int     frames = ( t_int     )( io[ 5 ] );
-    t_paifft* object = ( t_paifft* )( io[ 6 ] );
+    t_float*  in1        = ( t_float*  )( io[ 1 ] );
+    t_float*  in2        = ( t_float*  )( io[ 2 ] );
+    t_float*  in3        = ( t_float*  )( io[ 3 ] );
+    t_float*  out        = ( t_float*  )( io[ 4 ] );
+    t_int     frames     = ( t_int     )( io[ 5 ] );
+    t_int     channels   = ( t_int     )( io[ 6 ] );
+    t_int     channels_2 = ( t_int     )( io[ 7 ] );
+    t_int     channels_3 = ( t_int     )( io[ 8 ] );
+    t_paifft* object     = ( t_paifft* )( io[ 9 ] );
 
     // store values from object's data structure
     t_float* rifft_array  = object->rifft_array;
@@ -117,45 +123,62 @@ static t_int* paifft_perform( t_int* io )
     t_float  size_recip   = object->size_recip;
     t_float* temp_array   = object->temp_array;
 
-    // signal vector iterator variable
-    t_int n = -1;
+    // signal vector and channel iterator variables
+    t_int n;
+    t_int channel;
 
-    // store shift amount
-    t_int shift = ( t_int )in3[ 0 ];
+    // shift amount
+    t_int shift;
 
-    // clear last dsp loop's data from the rifft_array
-    memset( rifft_array, 0, memory_size );
+    // the channel loop - each channel is a block of frames after the last, and
+    // the imaginary and shift inlets' channels repeat when they have fewer
+    // than the real inlet
+    for( channel = 0 ; channel < channels ; ++channel )
+    {
+        // store shift amount
+        shift = ( t_int )in3[ ( channel % channels_3 ) * frames ];
 
-    // pack real and imaginary data into rifft_array
-    MayerRealIFFTPack( rifft_array, in1, in2, frames );
+        // reset signal vector iterator
+        n = -1;
 
-    // perform the real inverse fft
-    mayer_realifft( ( int )frames, rifft_array );
+        // clear last dsp loop's data from the rifft_array
+        memset( rifft_array, 0, memory_size );
 
-    // rotate signal vector
-    RotateArray( rifft_array, temp_array, shift, frames );
+        // pack real and imaginary data into rifft_array
+        MayerRealIFFTPack( rifft_array, in1, &( in2[ ( channel % channels_2 ) * frames ] ), frames );
 
-    // make sure window array exists and can be used
-    if( ( window_array != NULL ) && ( window_size == frames ) )
-    {
-        // window and normalize rifft_array into out array
-        while( ++n < frames )
+        // perform the real inverse fft
+        mayer_realifft( ( int )frames, rifft_array );
+
+        // rotate signal vector
+        RotateArray( rifft_array, temp_array, shift, frames );
+
+        // make sure window array exists and can be used
+        if( ( window_array != NULL ) && ( window_size == frames ) )
         {
-            out[ n ] = rifft_array[ n ] * window_array[ n ].w_float * size_recip;
+            // window and normalize rifft_array into out array
+            while( ++n < frames )
+            {
+                out[ n ] = rifft_array[ n ] * window_array[ n ].w_float * size_recip;
+            }
         }
-    }
-    else
-    {
-        // normalize rifft array into out array
-        while( ++n < frames )
+        else
         {
-            out[ n ] = rifft_array[ n ] * size_recip;
+            // normalize rifft array into out array
+            while( ++n < frames )
+            {
+                out[ n ] = rifft_array[ n ] * size_recip;
+            }
         }
+
+        // move on to the next channel
+        in1 += frames;
+        out += frames;
     }
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
-    return &( io[ 7 ] );
+    return &( io[ 10 ] );
 }
 
 
@@ -171,15 +194,25 @@ static void paifft_dsp( t_paifft* object, t_signal **sig )
         return;
     }
 
-    // calculate memory size for realloc and memset
+    // number of channels in the real inlet, which the outlet shares
+    t_int channels = SignalChannels( sig[ 0 ] );
+
+    // calculate memory size for realloc and memset ( one channel )
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate enough memory to hold signal vector data
-    object->rifft_array = realloc( object->rifft_array, memory_size );
-    object->temp_array  = realloc( object->temp_array,  memory_size );
+    // give the outlet as many channels as the real inlet
+    SignalSetChannels( &sig[ 3 ], channels );
+
+    // only reallocate memory when the vector size has changed
+    if( memory_size != object->memory_size )
+    {
+        // allocate enough memory to hold signal vector data
+        object->rifft_array = realloc( object->rifft_array, memory_size );
+        object->temp_array  = realloc( object->temp_array,  memory_size );
 
-    // save memory size for use in dsp loop
-    object->memory_size = memory_size;
+        // save memory size for use in dsp loop
+        object->memory_size = memory_size;
+    }
 
     // reciprocal of ifft size for normalization
     object->size_recip = 1.0 / sig[ 0 ]->s_n;
@@ -187,6 +220,9 @@ static void paifft_dsp( t_paifft* object, t_signal **sig )
     // set the window array associated with this object
     paifft_set_window_array( object );
 
+    // start timing this object ( when profiling is compiled in )
+    PROFILE_DSP_BEGIN( object );
+
     // dsp_add arguments
     //--------------------------------------------------------------------------
     // perform routine
@@ -196,8 +232,14 @@ static void paifft_dsp( t_paifft* object, t_signal **sig )
     // inlet 3 sample vector
     // outlet sample vector
     // sample frames to process (vector size)
+    // number of real inlet channels
+    // number of imaginary inlet channels
+    // number of shift inlet channels
     // pointer to this object
-    dsp_add( paifft_perform, 6, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 0 ]->s_n, object );
+    dsp_add( paifft_perform, 9, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 0 ]->s_n, channels, SignalChannels( sig[ 1 ] ), SignalChannels( sig[ 2 ] ), object );
+
+    // stop timing this object
+    PROFILE_DSP_END( object );
 }
 
 
@@ -264,6 +306,9 @@ static void* paifft_new( t_symbol* selector, t_int items, t_atom* list )
     // create a pointer to this object
     t_paifft* object = ( t_paifft* )pd_new( paifft_class );
 
+    // register with the dsp profiler
+    PROFILE_REGISTER( object, "paifft~" );
+
     // create two new signal inlets
     signalinlet_new( &object->object, object->inlet_2 );
     signalinlet_new( &object->object, object->inlet_3 );
@@ -307,6 +352,9 @@ static void* paifft_new( t_symbol* selector, t_int items, t_atom* list )
 //------------------------------------------------------------------------------
 static void paifft_free( t_paifft* object )
 {
+    // unregister from the dsp profiler
+    PROFILE_UNREGISTER( object );
+
     // if memory is allocated
     if( object->rifft_array )
     {
@@ -333,7 +381,7 @@ static void paifft_free( t_paifft* object )
 void paifft_tilde_setup( void )
 {
     // creates an instance of this object and describes it to pd
-    paifft_class = class_new( gensym( "paifft~" ), ( t_newmethod )paifft_new, ( t_method )paifft_free, sizeof( t_paifft ), 0, A_GIMME, 0 );
+    paifft_class = class_new( gensym( "paifft~" ), ( t_newmethod )paifft_new, ( t_method )paifft_free, sizeof( t_paifft ), MULTICHANNEL, A_GIMME, 0 );
 
     // declares leftmost inlet as a signal inlet
     CLASS_MAINSIGNALIN( paifft_class, t_paifft, inlet_1 );
@@ -66,6 +66,9 @@ typedef struct partconv
     // number of frames in the previous signal vector
     t_int last_frames;
 
+    // number of channels, each with its own input spectra history
+    t_int channels;
+
     // pointer to temporary signal vector block
     t_float* output_real;
     t_float* output_imag;
@@ -105,6 +108,9 @@ typedef struct partconv
     // flag to check if impulse has been analyzed
     t_int analyzed_flag;
 
+    // dsp timing record read by spectprof ( empty unless profiling is compiled in )
+    PROFILE_MEMBER
+
 } t_partconv;
 
 
@@ -118,6 +124,7 @@ static void         partconv_set_impulse_array   ( t_partconv* object );
 static inline void  partconv_check_impulse_array ( t_partconv* object );
 static void         partconv_set                 ( t_partconv* object, t_symbol* symbol );
 void                partconv_bang                ( t_partconv* object );
+static void         partconv_reset               ( t_partconv* object );
 static void*        partconv_new                 ( t_symbol* selector, t_int items, t_atom* list );
 static void         partconv_free                ( t_partconv* object );
 void                partconv_tilde_setup         ( void );
@@ -129,12 +136,14 @@ void                partconv_tilde_setup         ( void );
 static t_int* partconv_perform( t_int* io )
 {
     // store variables from dsp input/output array
-    t_float*    in1    = ( t_float*    )( io[ 1 ] );
-    t_float*    in2    = ( t_float*    )( io[ 2 ] );
-    t_float*    out1   = ( t_float*    )( io[ 3 ] );
-    t_float*    out2   = ( t_float*    )( io[ 4 ] );
-    t_int       frames = ( t_int       )( io[ 5 ] );
-    t_partconv* object = ( t_partconv* )( io[ 6 ] );
+    t_float*    in1        = ( t_float*    )( io[ 1 ] );
+    t_float*    in2        = ( t_float*    )( io[ 2 ] );
+    t_float*    out1       = ( t_float*    )( io[ 3 ] );
+    t_float*    out2       = ( t_float*    )( io[ 4 ] );
+    t_int       frames     = ( t_int       )( io[ 5 ] );
+    t_int       channels   = ( t_int       )( io[ 6 ] );
+    t_int       channels_2 = ( t_int       )( io[ 7 ] );
+    t_partconv* object     = ( t_partconv* )( io[ 8 ] );
 
     // check to see if impulse array needs to be analyzed
     partconv_check_impulse_array( object );
@@ -156,98 +165,122 @@ static t_int* partconv_perform( t_int* io )
     t_float conv_real;
     t_float conv_imag;
 
-    // signal vector iterator
+    // signal vector and channel iterators
     t_int n;
+    t_int channel;
+
+    // imaginary input of the current channel
+    t_float* imag;
 
     // spectral data normalization coefficient
     t_float normalize_coeff = 1.0 / parts;
 
-    // if there are partitions to process
-    if( parts )
+    // the channel loop - each channel is a block of frames after the last and
+    // keeps its own input spectra history, while the imaginary inlet's
+    // channels repeat when it has fewer than the real inlet
+    for( channel = 0 ; channel < channels ; ++channel )
     {
-        // shift input spectra along to make room for new input spectrum
-        memcpy( &( input_real[ frames ]), input_real, spectra_memcpy_size );
-        memcpy( &( input_imag[ frames ]), input_imag, spectra_memcpy_size );
+        // locate this channel's imaginary input
+        imag = &( in2[ ( channel % channels_2 ) * frames ] );
 
-        // clear new input spectrum storage location
-        memset( input_real, 0, memory_size );
-        memset( input_imag, 0, memory_size );
+        // if there are partitions to process
+        if( parts )
+        {
+            // shift input spectra along to make room for new input spectrum
+            memcpy( &( input_real[ frames ]), input_real, spectra_memcpy_size );
+            memcpy( &( input_imag[ frames ]), input_imag, spectra_memcpy_size );
 
-        // copy new input spectrum into front of input spectra arrays
-        memcpy( input_real, in1, memory_size );
-        memcpy( input_imag, in2, memory_size );
+            // reset signal vector iterator
+            n = -1;
 
-        // clear output spectrum accumulation arrays
-        memset( output_real, 0, memory_size );
-        memset( output_imag, 0, memory_size );
+            // copy new input spectrum into front of input spectra arrays,
+            // flushing a decaying input before it goes subnormal in the history
+            while( ++n < frames )
+            {
+                input_real[ n ] = FlushDenormal( in1 [ n ] );
+                input_imag[ n ] = FlushDenormal( imag[ n ] );
+            }
 
-        // the partition iterator
-        t_int part_iter = -1;
+            // clear output spectrum accumulation arrays
+            memset( output_real, 0, memory_size );
+            memset( output_imag, 0, memory_size );
 
-        // the partition sample index offset
-        t_int part_offset;
+            // the partition iterator
+            t_int part_iter = -1;
 
-        // index for complex convolution in each partition
-        t_int conv_index;
+            // the partition sample index offset
+            t_int part_offset;
 
-        // iterate through the partitions
-        while( ++part_iter < parts )
-        {
-            // calculate partition sample index offset
-            part_offset = part_iter * frames;
+            // index for complex convolution in each partition
+            t_int conv_index;
+
+            // iterate through the partitions
+            while( ++part_iter < parts )
+            {
+                // calculate partition sample index offset
+                part_offset = part_iter * frames;
+
+                // reset signal vector iterator
+                n = -1;
+
+                // perform complex multiplication and accumulate into output arrays
+                while( ++n < frames )
+                {
+                    // calculate multiplication location within the spectra
+                    conv_index = n + part_offset;
+
+                    // complex multiplication
+                    conv_real = ( input_real[ conv_index ] * impulse_real[ conv_index ] ) - ( input_imag[ conv_index ] * impulse_imag[ conv_index ] );
+                    conv_imag = ( input_imag[ conv_index ] * impulse_real[ conv_index ] ) + ( input_real[ conv_index ] * impulse_imag[ conv_index ] );
+
+                    // accumulate convolved spectra into output spectrum
+                    output_real[ n ] += conv_real;
+                    output_imag[ n ] += conv_imag;
+                }
+            }
 
             // reset signal vector iterator
             n = -1;
 
-            // perform complex multiplication and accumulate into output arrays
+            // normalize the output spectrum, flushing what the decayed tail
+            // of the accumulation leaves behind
             while( ++n < frames )
             {
-                // calculate multiplication location within the spectra
-                conv_index = n + part_offset;
-
-                // complex multiplication
-                conv_real = ( input_real[ conv_index ] * impulse_real[ conv_index ] ) - ( input_imag[ conv_index ] * impulse_imag[ conv_index ] );
-                conv_imag = ( input_imag[ conv_index ] * impulse_real[ conv_index ] ) + ( input_real[ conv_index ] * impulse_imag[ conv_index ] );
-
-                // accumulate convolved spectra into output spectrum
-                output_real[ n ] += conv_real;
-                output_imag[ n ] += conv_imag;
+                output_real[ n ] = FlushDenormal( output_real[ n ] * normalize_coeff );
+                output_imag[ n ] = FlushDenormal( output_imag[ n ] * normalize_coeff );
             }
-        }
-
-        // reset signal vector iterator
-        n = -1;
 
-        // normalize the output spectrum
-        while( ++n < frames )
-        {
-            output_real[ n ] *= normalize_coeff;
-            output_imag[ n ] *= normalize_coeff;
+            // copy output spectrum to outlets
+            memcpy( out1, output_real, memory_size );
+            memcpy( out2, output_imag, memory_size );
         }
+        // if there are no partitions, copy input to output
+        else
+        {
+            // in this object, out1 is duplicated as out2 unless a temporary
+            // buffer is used to make copies of the input data
+            // ( pd is re-using signal vectors somehow to conserve memory )
 
-        // copy output spectrum to outlets
-        memcpy( out1, output_real, memory_size );
-        memcpy( out2, output_imag, memory_size );
-    }
-    // if there are no partitions, copy input to output
-    else
-    {
-        // in this object, out1 is duplicated as out2 unless a temporary
-        // buffer is used to make copies of the input data
-        // ( pd is re-using signal vectors somehow to conserve memory )
+            // make temp copies of input data
+            memcpy( output_real, in1, memory_size );
+            memcpy( output_imag, imag, memory_size );
 
-        // make temp copies of input data
-        memcpy( output_real, in1, memory_size );
-        memcpy( output_imag, in2, memory_size );
+            // copy temp input data to outputs
+            memcpy( out1, output_real, memory_size );
+            memcpy( out2, output_imag, memory_size );
+        }
 
-        // copy temp input data to outputs
-        memcpy( out1, output_real, memory_size );
-        memcpy( out2, output_imag, memory_size );
+        // move on to the next channel's signals and input spectra
+        in1        += frames;
+        out1       += frames;
+        out2       += frames;
+        input_real += parts * frames;
+        input_imag += parts * frames;
     }
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
-    return &( io[ 7 ] );
+    return &( io[ 9 ] );
 }
 
 
@@ -266,19 +299,40 @@ static void partconv_dsp( t_partconv* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate enough memory to hold signal vector data
-    object->output_real = realloc( object->output_real, memory_size );
-    object->output_imag = realloc( object->output_imag, memory_size );
+    // only reallocate memory when the vector size has changed
+    if( memory_size != object->memory_size )
+    {
+        // allocate enough memory to hold signal vector data
+        object->output_real = realloc( object->output_real, memory_size );
+        object->output_imag = realloc( object->output_imag, memory_size );
 
-    // save memory size for use in dsp loop
-    object->memory_size = memory_size;
+        // save memory size for use in dsp loop
+        object->memory_size = memory_size;
+    }
 
     // save frame size for use in analysis function
     object->frames = sig[ 0 ]->s_n;
 
+    // number of channels in the real inlet, which the outlets share
+    t_int channels = SignalChannels( sig[ 0 ] );
+
+    // give the outlets as many channels as the real inlet
+    SignalSetChannels( &sig[ 2 ], channels );
+    SignalSetChannels( &sig[ 3 ], channels );
+
+    // a new channel count needs new input spectra history
+    if( channels != object->channels )
+    {
+        object->channels      = channels;
+        object->analyzed_flag = FALSE;
+    }
+
     // set the impulse array associated with this object
     // partconv_set_impulse_array( object );
 
+    // start timing this object ( when profiling is compiled in )
+    PROFILE_DSP_BEGIN( object );
+
     // dsp_add arguments
     //--------------------------------------------------------------------------
     // perform routine
@@ -288,8 +342,13 @@ static void partconv_dsp( t_partconv* object, t_signal **sig )
     // outlet 1 sample vector
     // outlet 2 sample vector
     // sample frames to process (vector size)
+    // number of real inlet channels
+    // number of imaginary inlet channels
     // pointer to this object
-    dsp_add( partconv_perform, 6, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 0 ]->s_n, object );
+    dsp_add( partconv_perform, 8, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 0 ]->s_n, channels, SignalChannels( sig[ 1 ] ), object );
+
+    // stop timing this object
+    PROFILE_DSP_END( object );
 }
 
 
@@ -320,11 +379,13 @@ static void partconv_analyze_impulse( t_partconv* object )
     object->impulse_real = realloc( object->impulse_real, spectra_mem_size );
     object->impulse_imag = realloc( object->impulse_imag, spectra_mem_size );
 
-    // allocate enough memory to hold previous partitions of input spectra
-    object->input_real = realloc( object->input_real, spectra_mem_size );
-    object->input_imag = realloc( object->input_imag, spectra_mem_size );
+    // allocate enough memory to hold previous partitions of input spectra ( every channel )
+    object->input_real = realloc( object->input_real, spectra_mem_size * object->channels );
+    object->input_imag = realloc( object->input_imag, spectra_mem_size * object->channels );
 
     // clear the spectra memories
+    memset( object->input_real,   0, spectra_mem_size * object->channels );
+    memset( object->input_imag,   0, spectra_mem_size * object->channels );
     memset( object->impulse_rfft, 0, spectra_mem_size );
     memset( object->impulse_real, 0, spectra_mem_size );
     memset( object->impulse_imag, 0, spectra_mem_size );
@@ -357,6 +418,10 @@ static void partconv_analyze_impulse( t_partconv* object )
         MayerRealFFTUnpack( &( impulse_rfft[ spect_iter ] ), &( impulse_real[ spect_iter ] ), &( impulse_imag[ spect_iter ] ), block_size );
     }
 
+    // flush negligible impulse bins so they never multiply into subnormals
+    FlushDenormals( impulse_real, spectra_size );
+    FlushDenormals( impulse_imag, spectra_size );
+
     // store parts and spectra_mem_size for use in dsp loop
     object->parts            = parts;
     object->spectra_mem_size = spectra_mem_size;
@@ -466,6 +531,20 @@ void partconv_bang( t_partconv* object )
 }
 
 
+//------------------------------------------------------------------------------
+// partconv_reset - clears the input spectra history
+//------------------------------------------------------------------------------
+static void partconv_reset( t_partconv* object )
+{
+    // only clear memory that has been allocated
+    if( object->input_real )
+    {
+        memset( object->input_real, 0, object->spectra_mem_size * object->channels );
+        memset( object->input_imag, 0, object->spectra_mem_size * object->channels );
+    }
+}
+
+
 //------------------------------------------------------------------------------
 // partconv_new - instantiates a copy of this object in pd
 //------------------------------------------------------------------------------
@@ -474,6 +553,9 @@ static void* partconv_new( t_symbol* selector, t_int items, t_atom* list )
     // create a pointer to this object
     t_partconv* object = ( t_partconv* )pd_new( partconv_class );
 
+    // register with the dsp profiler
+    PROFILE_REGISTER( object, "partconv~" );
+
     // create an additional signal inlet
     signalinlet_new( &object->object, object->inlet_2 );
 
@@ -491,6 +573,7 @@ static void* partconv_new( t_symbol* selector, t_int items, t_atom* list )
     object->output_imag       = NULL;
     object->frames            = 0;
     object->last_frames       = 0;
+    object->channels          = 1;
     object->memory_size       = 0;
     object->impulse_size      = 0;
     object->last_impulse_size = 0;
@@ -526,6 +609,9 @@ static void* partconv_new( t_symbol* selector, t_int items, t_atom* list )
 //------------------------------------------------------------------------------
 static void partconv_free( t_partconv* object )
 {
+    // unregister from the dsp profiler
+    PROFILE_UNREGISTER( object );
+
     // if memory is allcoated
     if( object->input_real )
     {
@@ -582,7 +668,7 @@ static void partconv_free( t_partconv* object )
 void partconv_tilde_setup( void )
 {
     // creates an instance of this object and describes it to pd
-    partconv_class = class_new( gensym( "partconv~" ), ( t_newmethod )partconv_new, ( t_method )partconv_free, sizeof( t_partconv ), 0, A_GIMME, 0 );
+    partconv_class = class_new( gensym( "partconv~" ), ( t_newmethod )partconv_new, ( t_method )partconv_free, sizeof( t_partconv ), MULTICHANNEL, A_GIMME, 0 );
 
     // declares leftmost inlet as a signal inlet
     CLASS_MAINSIGNALIN( partconv_class, t_partconv, inlet_1 );
@@ -595,6 +681,9 @@ void partconv_tilde_setup( void )
 
     // installs partconv_set to respond to "set ___" messages
     class_addmethod( partconv_class, ( t_method )partconv_set, gensym( "set" ), A_SYMBOL, 0 );
+
+    // installs partconv_reset to respond to "reset" message
+    class_addmethod( partconv_class, ( t_method )partconv_reset, gensym( "reset" ), 0 );
 }
 
 
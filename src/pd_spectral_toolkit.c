@@ -80,6 +80,7 @@ void dbtomag_tilde_setup      ();
 void degtorad_tilde_setup     ();
 void degtoturn_tilde_setup    ();
 void dspbang_tilde_setup      ();
+void framestore_tilde_setup   ();
 void freqsieve_tilde_setup    ();
 void freqtocar_tilde_setup    ();
 void freqtocar_tilde_setup    ();
@@ -87,6 +88,7 @@ void freqtophase_tilde_setup  ();
 void freqtopolar_tilde_setup  ();
 void fundfreq_tilde_setup     ();
 void harmprod_tilde_setup     ();
+void magscale_tilde_setup     ();
 void magtoamp_tilde_setup     ();
 void magtodb_tilde_setup      ();
 void magtrim_tilde_setup      ();
@@ -97,6 +99,7 @@ void pafft_tilde_setup        ();
 void paifft_tilde_setup       ();
 void partconv_tilde_setup     ();
 void peaks_tilde_setup        ();
+void peaktrack_tilde_setup    ();
 void phaseaccum_tilde_setup   ();
 void phasedelta_tilde_setup   ();
 void phasetofreq_tilde_setup  ();
@@ -112,6 +115,8 @@ void rounder_tilde_setup      ();
 void scale_tilde_setup        ();
 void sigtoctl_tilde_setup     ();
 void softclip_tilde_setup     ();
+void spectprof_setup          ();
+void spectrogram_tilde_setup  ();
 void tabindex_tilde_setup     ();
 void trunc_tilde_setup        ();
 void turntodeg_tilde_setup    ();
@@ -179,6 +184,7 @@ void pd_spectral_toolkit_setup()
     degtorad_tilde_setup     ();
     degtoturn_tilde_setup    ();
     dspbang_tilde_setup      ();
+    framestore_tilde_setup   ();
     freqsieve_tilde_setup    ();
     freqtocar_tilde_setup    ();
     freqtocar_tilde_setup    ();
@@ -186,6 +192,7 @@ void pd_spectral_toolkit_setup()
     freqtopolar_tilde_setup  ();
     fundfreq_tilde_setup     ();
     harmprod_tilde_setup     ();
+    magscale_tilde_setup     ();
     magtoamp_tilde_setup     ();
     magtodb_tilde_setup      ();
     magtrim_tilde_setup      ();
@@ -195,6 +202,7 @@ void pd_spectral_toolkit_setup()
     paifft_tilde_setup       ();
     partconv_tilde_setup     ();
     peaks_tilde_setup        ();
+    peaktrack_tilde_setup    ();
     phaseaccum_tilde_setup   ();
     phasedelta_tilde_setup   ();
     phasetofreq_tilde_setup  ();
@@ -210,6 +218,8 @@ void pd_spectral_toolkit_setup()
     scale_tilde_setup        ();
     sigtoctl_tilde_setup     ();
     softclip_tilde_setup     ();
+    spectprof_setup          ();
+    spectrogram_tilde_setup  ();
     tabindex_tilde_setup     ();
     trunc_tilde_setup        ();
     turntodeg_tilde_setup    ();
@@ -236,13 +246,14 @@ void pd_spectral_toolkit_setup()
     post( "||  cartodb~ cartofreq~ cartomag~ cartophase~ cartopolar~ " );
     post( "||  cmplxabs~ cmplxadd~ cmplxdiv~ cmplxmult~ cmplxsqrt~ " );
     post( "||  cmplxsub~ countwrap ctltosig~ dbtoamp~ dbtomag~ degtorad" );
-    post( "||  degtoturn~ dspbang~ freqsieve~  freqtocar~ freqtophase~" );
-    post( "||  freqtopolar~ fundfreq~ harmprod~ magtoamp~ magtodb~" );
+    post( "||  degtoturn~ dspbang~ framestore~ freqsieve~ freqtocar~ freqtophase~" );
+    post( "||  freqtopolar~ fundfreq~ harmprod~ magscale~ magtoamp~ magtodb~" );
     post( "||  magtrim~ monitor~ oscbank~ pafft~ paifft~ partconv~" );
-    post( "||  peaks~ phaseaccum~ phasedelta~ phasetofreq~ piwrap~" );
+    post( "||  peaks~ peaktrack~ phaseaccum~ phasedelta~ phasetofreq~ piwrap~" );
     post( "||  polartocar~ polartofreq~ radtodeg~ radtoturn~ recip~ rgbtable" );
-    post( "||  rotate~ rounder~ scale~ sigtoctl~ softclip~ tabindex~ terminal" );
-    post( "||  trunc~ turntodeg~ turntorad~ valleys~ windower winfft~ winifft~" );
+    post( "||  rotate~ rounder~ scale~ sigtoctl~ softclip~ spectprof" );
+    post( "||  spectrogram~ tabindex~ terminal trunc~ turntodeg~ turntorad~" );
+    post( "||  valleys~ windower winfft~ winifft~" );
     post( "||  !&&~ !=~ !||~ !~ %%~ &&~ <=~ <~ ==~ >=~ >~ ||~" );
     post( "||" );
     post( "||  (c)2019 Cooper Baker" );
@@ -62,6 +62,9 @@ typedef struct peaks
     // number of peaks to output
     t_float num_peaks;
 
+    // nonzero when peaks are output as a sparse partial list
+    t_int sparse;
+
 } t_peaks;
 
 
@@ -71,6 +74,7 @@ typedef struct peaks
 static inline void  peaks_quicksort_indices ( t_peaks* object, t_int beginning, t_int end );
 static t_int*       peaks_perform           ( t_int* io );
 static void         peaks_dsp               ( t_peaks* object, t_signal **sig );
+static void         peaks_sparse            ( t_peaks* object, t_floatarg sparse );
 static void*        peaks_new               ( t_symbol* selector, t_int items, t_atom* list );
 static void         peaks_free              ( t_peaks* object );
 void                peaks_tilde_setup       ( void );
@@ -206,9 +210,18 @@ static t_int* peaks_perform( t_int* io )
         peaks_select_peaks( object, num_peaks, frames );
     }
 
+    // pack the peaks into a partial list on outlet 1, leaving outlet 2 silent
+    if( object->sparse )
+    {
+        PartialsPack( out1, frames, in1_peaks, in2_peaks, frames );
+        memset( out2, 0, memory_size );
+    }
     // copy peaks arrays to outlet arrays
-    memcpy( out1, in1_peaks, memory_size );
-    memcpy( out2, in2_peaks, memory_size );
+    else
+    {
+        memcpy( out1, in1_peaks, memory_size );
+        memcpy( out2, in2_peaks, memory_size );
+    }
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
@@ -227,25 +240,30 @@ static void peaks_dsp( t_peaks* object, t_signal **sig )
     // calculate memory size of signal vector for memset and realloc
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // save memory_size for use in dsp loop
-    object->memory_size = memory_size;
+    // only reallocate memory when the vector size has changed
+    if( memory_size != object->memory_size )
+    {
 
-    // allocate enough memory to hold signal vector data ( in1 and indices need an extra location for sorting )
-    object->in1_peaks    = realloc( object->in1_peaks,    memory_size + sizeof( t_float ) );
-    object->in2_peaks    = realloc( object->in2_peaks,    memory_size );
-    object->in1_temp     = realloc( object->in1_temp,     memory_size );
-    object->in2_temp     = realloc( object->in2_temp,     memory_size );
-    object->indices      = realloc( object->indices,      memory_size + sizeof( t_float ) );
-    object->vector_index = realloc( object->vector_index, memory_size );
+        // allocate enough memory to hold signal vector data ( in1 and indices need an extra location for sorting )
+        object->in1_peaks    = realloc( object->in1_peaks,    memory_size + sizeof( t_float ) );
+        object->in2_peaks    = realloc( object->in2_peaks,    memory_size );
+        object->in1_temp     = realloc( object->in1_temp,     memory_size );
+        object->in2_temp     = realloc( object->in2_temp,     memory_size );
+        object->indices      = realloc( object->indices,      memory_size + sizeof( t_float ) );
+        object->vector_index = realloc( object->vector_index, memory_size );
 
-    // init extra sorting values
-    object->in1_peaks[ frames ] = C_FLOAT_MIN;
-    object->indices  [ frames ] = 0;
+        // init extra sorting values
+        object->in1_peaks[ frames ] = C_FLOAT_MIN;
+        object->indices  [ frames ] = 0;
 
-    // increment values stored in vector_index
-    for( t_int index = 0 ; index < frames ; ++index )
-    {
-        object->vector_index[ index ] = ( t_float )index;
+        // increment values stored in vector_index
+        for( t_int index = 0 ; index < frames ; ++index )
+        {
+            object->vector_index[ index ] = ( t_float )index;
+        }
+
+        // save memory_size for use in dsp loop
+        object->memory_size = memory_size;
     }
 
     // dsp_add arguments
@@ -262,6 +280,15 @@ static void peaks_dsp( t_peaks* object, t_signal **sig )
 }
 
 
+//------------------------------------------------------------------------------
+// peaks_sparse - switches between dense vectors and a sparse partial list
+//------------------------------------------------------------------------------
+static void peaks_sparse( t_peaks* object, t_floatarg sparse )
+{
+    object->sparse = ( sparse != 0 );
+}
+
+
 //------------------------------------------------------------------------------
 // peaks_new - instantiates a copy of this object in pd
 //------------------------------------------------------------------------------
@@ -291,6 +318,9 @@ static void* peaks_new( t_symbol* selector, t_int items, t_atom* list )
     // init number of peaks: 0 outputs all peaks
     object-> num_peaks = 0;
 
+    // output dense vectors until told otherwise
+    object->sparse = FALSE;
+
     // parse initialization arguments
     //--------------------------------------------------------------------------
     if( items > 0 )
@@ -378,6 +408,9 @@ void peaks_tilde_setup( void )
 
     // installs peaks_dsp so that it will be called when dsp is turned on
     class_addmethod( peaks_class, ( t_method )peaks_dsp, gensym( "dsp" ), 0 );
+
+    // installs peaks_sparse to respond to "sparse" message
+    class_addmethod( peaks_class, ( t_method )peaks_sparse, gensym( "sparse" ), A_FLOAT, 0 );
 }
 
 
@@ -0,0 +1,814 @@
+//------------------------------------------------------------------------------
+//  Pd Spectral Toolkit
+//
+//  peaktrack~.c
+//
+//  Follows spectral peaks from frame to frame as persistent partial tracks
+//
+//  Copyright (C) 2019 Cooper Baker. All Rights Reserved.
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// headers
+//------------------------------------------------------------------------------
+
+// main header for pd
+#include "m_pd.h"
+
+// utility header for Pd Spectral Toolkit project
+#include "utility.h"
+
+// disable compiler warnings on windows
+#ifdef NT
+#pragma warning( disable : 4244 )
+#pragma warning( disable : 4305 )
+#endif
+
+
+//------------------------------------------------------------------------------
+// constant definitions
+//------------------------------------------------------------------------------
+
+// number of track slots when none is given
+#define PEAKTRACK_DEFAULT_TRACKS 64
+
+// largest frequency change in hertz of a track continuing from one hop to the
+// next when none is given
+#define PEAKTRACK_DEFAULT_DEVIATION 50
+
+
+//------------------------------------------------------------------------------
+// track slot states - an unmatched track fades out at its last frequency for
+// one hop, then rests one more while oscbank~ settles before its slot is reused
+//------------------------------------------------------------------------------
+enum PEAKTRACK_STATE
+{
+    TRACK_FREE,
+    TRACK_ACTIVE,
+    TRACK_DYING,
+    TRACK_RESTING
+};
+
+
+//------------------------------------------------------------------------------
+// peaktrack_point - a peak of the current hop, or an active track
+//------------------------------------------------------------------------------
+typedef struct peaktrack_point
+{
+    t_float freq;
+    t_float mag;
+
+    // track slot claiming a peak ( -1 when unclaimed ), or a track's own slot
+    t_int index;
+
+} t_peaktrack_point;
+
+
+//------------------------------------------------------------------------------
+// peaktrack_link - a candidate continuation of a track by a peak
+//------------------------------------------------------------------------------
+typedef struct peaktrack_link
+{
+    t_float distance;
+    t_int   track;
+    t_int   peak;
+
+} t_peaktrack_link;
+
+
+//------------------------------------------------------------------------------
+// peaktrack_class - pointer to this object's definition
+//------------------------------------------------------------------------------
+static t_class* peaktrack_class;
+
+
+//------------------------------------------------------------------------------
+// peaktrack - data structure holding this object's data
+//------------------------------------------------------------------------------
+typedef struct peaktrack
+{
+    // this object - must always be first variable in struct
+    t_object object;
+
+    // needed for CLASS_MAINSIGNALIN macro call in peaktrack_tilde_setup
+    t_float inlet_1;
+
+    // needed for signalinlet_new call in peaktrack_new
+    t_float inlet_2;
+
+    // track slots - frequency, magnitude, state, and the peak matched this hop
+    t_int    tracks;
+    t_float* track_freq;
+    t_float* track_mag;
+    t_int*   track_state;
+    t_int*   track_peak;
+
+    // active tracks and candidate links, sized by the number of tracks
+    t_peaktrack_point* active;
+    t_peaktrack_link*  links;
+
+    // peaks of the current hop and the unclaimed ones, sized by the vector
+    t_peaktrack_point* peaks;
+    t_peaktrack_point* births;
+
+    // memory size of a signal vector
+    t_int memory_size;
+
+    // largest frequency change of a continuing track in hertz
+    t_float deviation;
+
+    // nonzero when inlet 1 carries a sparse partial list
+    t_int sparse;
+
+} t_peaktrack;
+
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+static int    peaktrack_by_freq      ( const t_peaktrack_point* x, const t_peaktrack_point* y );
+static int    peaktrack_by_mag       ( const t_peaktrack_point* x, const t_peaktrack_point* y );
+static int    peaktrack_by_distance  ( const t_peaktrack_link* x, const t_peaktrack_link* y );
+static void   peaktrack_sort_points  ( t_peaktrack_point* points, t_int count, int ( *order )( const t_peaktrack_point*, const t_peaktrack_point* ) );
+static void   peaktrack_heap_points  ( t_peaktrack_point* points, t_int count, int ( *order )( const t_peaktrack_point*, const t_peaktrack_point* ) );
+static void   peaktrack_heap_links   ( t_peaktrack_link* links, t_int count );
+static t_int  peaktrack_gather       ( t_peaktrack* object, t_float* in1, t_float* in2, t_int frames );
+static t_int* peaktrack_perform      ( t_int* io );
+static void   peaktrack_dsp          ( t_peaktrack* object, t_signal **sig );
+static void   peaktrack_tracks       ( t_peaktrack* object, t_floatarg tracks );
+static void   peaktrack_deviation    ( t_peaktrack* object, t_floatarg deviation );
+static void   peaktrack_sparse       ( t_peaktrack* object, t_floatarg sparse );
+static void   peaktrack_reset        ( t_peaktrack* object );
+static void*  peaktrack_new          ( t_symbol* selector, t_int items, t_atom* list );
+static void   peaktrack_free         ( t_peaktrack* object );
+void          peaktrack_tilde_setup  ( void );
+
+
+//------------------------------------------------------------------------------
+// peaktrack_by_freq - orders points by ascending frequency
+//------------------------------------------------------------------------------
+static int peaktrack_by_freq( const t_peaktrack_point* x, const t_peaktrack_point* y )
+{
+    if( x->freq != y->freq )
+    {
+        return x->freq < y->freq ? -1 : 1;
+    }
+
+    return ( x->index > y->index ) - ( x->index < y->index );
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_by_mag - orders points by descending magnitude, then by frequency
+// ( unclaimed peaks all have index -1, and heapsort is not stable )
+//------------------------------------------------------------------------------
+static int peaktrack_by_mag( const t_peaktrack_point* x, const t_peaktrack_point* y )
+{
+    if( x->mag != y->mag )
+    {
+        return x->mag > y->mag ? -1 : 1;
+    }
+
+    if( x->freq != y->freq )
+    {
+        return x->freq < y->freq ? -1 : 1;
+    }
+
+    return ( x->index > y->index ) - ( x->index < y->index );
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_by_distance - orders links by ascending frequency change
+//------------------------------------------------------------------------------
+static int peaktrack_by_distance( const t_peaktrack_link* x, const t_peaktrack_link* y )
+{
+    if( x->distance != y->distance )
+    {
+        return x->distance < y->distance ? -1 : 1;
+    }
+
+    if( x->track != y->track )
+    {
+        return ( x->track > y->track ) - ( x->track < y->track );
+    }
+
+    return ( x->peak > y->peak ) - ( x->peak < y->peak );
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_sort_points - insertion sorts points in place
+//------------------------------------------------------------------------------
+// only for the frequency sorts: peaks are gathered in bin order, so they arrive
+// nearly sorted, and the active list is at most the track count long - qsort
+// is avoided since it may allocate on the audio thread
+//------------------------------------------------------------------------------
+static void peaktrack_sort_points( t_peaktrack_point* points, t_int count, int ( *order )( const t_peaktrack_point*, const t_peaktrack_point* ) )
+{
+    t_peaktrack_point point;
+    t_int             n;
+    t_int             k;
+
+    for( n = 1 ; n < count ; ++n )
+    {
+        point = points[ n ];
+
+        for( k = n ; ( k > 0 ) && ( order( &points[ k - 1 ], &point ) > 0 ) ; --k )
+        {
+            points[ k ] = points[ k - 1 ];
+        }
+
+        points[ k ] = point;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_heap_points - heapsorts points in place
+//------------------------------------------------------------------------------
+// births are gathered in frequency order and sorted by magnitude, which is no
+// order at all, so they take an O( n log n ) sort that needs no memory
+//------------------------------------------------------------------------------
+static void peaktrack_heap_points( t_peaktrack_point* points, t_int count, int ( *order )( const t_peaktrack_point*, const t_peaktrack_point* ) )
+{
+    t_peaktrack_point point;
+    t_int             end;
+    t_int             root;
+    t_int             child;
+
+    // build a heap with the last point in order at its root, then move the
+    // root to the end of the shrinking heap until the heap is empty
+    for( end = count, root = count / 2 - 1 ; end > 1 ; )
+    {
+        if( root >= 0 )
+        {
+            point = points[ root ];
+            child = root--;
+        }
+        else
+        {
+            --end;
+            point         = points[ end ];
+            points[ end ] = points[ 0 ];
+            child         = 0;
+        }
+
+        // sift the point down from the hole at child
+        for( ; 2 * child + 1 < end ; )
+        {
+            t_int next = 2 * child + 1;
+
+            if( ( next + 1 < end ) && ( order( &points[ next + 1 ], &points[ next ] ) > 0 ) )
+            {
+                ++next;
+            }
+
+            if( order( &points[ next ], &point ) <= 0 )
+            {
+                break;
+            }
+
+            points[ child ] = points[ next ];
+            child           = next;
+        }
+
+        points[ child ] = point;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_heap_links - heapsorts links in place by distance
+//------------------------------------------------------------------------------
+// links are built in frequency order and sorted by distance, so like births
+// they take the heapsort
+//------------------------------------------------------------------------------
+static void peaktrack_heap_links( t_peaktrack_link* links, t_int count )
+{
+    t_peaktrack_link link;
+    t_int            end;
+    t_int            root;
+    t_int            child;
+
+    for( end = count, root = count / 2 - 1 ; end > 1 ; )
+    {
+        if( root >= 0 )
+        {
+            link  = links[ root ];
+            child = root--;
+        }
+        else
+        {
+            --end;
+            link         = links[ end ];
+            links[ end ] = links[ 0 ];
+            child        = 0;
+        }
+
+        for( ; 2 * child + 1 < end ; )
+        {
+            t_int next = 2 * child + 1;
+
+            if( ( next + 1 < end ) && ( peaktrack_by_distance( &links[ next + 1 ], &links[ next ] ) > 0 ) )
+            {
+                ++next;
+            }
+
+            if( peaktrack_by_distance( &links[ next ], &link ) <= 0 )
+            {
+                break;
+            }
+
+            links[ child ] = links[ next ];
+            child          = next;
+        }
+
+        links[ child ] = link;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_gather - collects this hop's peaks, sorted by frequency
+//------------------------------------------------------------------------------
+static t_int peaktrack_gather( t_peaktrack* object, t_float* in1, t_float* in2, t_int frames )
+{
+    t_peaktrack_point* peaks = object->peaks;
+    t_int              count = 0;
+    t_int              n;
+
+    // a partial list holds only its peaks
+    if( object->sparse )
+    {
+        t_int    partials = PartialsCount( in1, frames );
+        t_float* mags     = PARTIALS_MAGS ( in1, frames );
+        t_float* freqs    = PARTIALS_FREQS( in1, frames );
+
+        for( n = 0 ; n < partials ; ++n )
+        {
+            if( ( mags[ n ] > 0 ) && ( freqs[ n ] > 0 ) )
+            {
+                peaks[ count ].freq  = freqs[ n ];
+                peaks[ count ].mag   = mags [ n ];
+                peaks[ count ].index = -1;
+                ++count;
+            }
+        }
+    }
+    // dense magnitude and frequency vectors, zero away from the peaks
+    else
+    {
+        for( n = 0 ; n < frames ; ++n )
+        {
+            if( ( in1[ n ] > 0 ) && ( in2[ n ] > 0 ) )
+            {
+                peaks[ count ].freq  = in2[ n ];
+                peaks[ count ].mag   = in1[ n ];
+                peaks[ count ].index = -1;
+                ++count;
+            }
+        }
+    }
+
+    peaktrack_sort_points( peaks, count, peaktrack_by_freq );
+
+    return count;
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_perform - the signal processing function of this object
+//------------------------------------------------------------------------------
+// tracks and peaks are both sorted by frequency, so each track only considers
+// the nearest peak above and below it; those links are taken closest first,
+// which keeps a hop's cost at sorting the peaks plus twice the active tracks
+//------------------------------------------------------------------------------
+static t_int* peaktrack_perform( t_int* io )
+{
+    // store variables from dsp input/output array
+    t_float*     in1    = ( t_float*     )( io[ 1 ] );
+    t_float*     in2    = ( t_float*     )( io[ 2 ] );
+    t_float*     out    = ( t_float*     )( io[ 3 ] );
+    t_int        frames = ( t_int        )( io[ 4 ] );
+    t_peaktrack* object = ( t_peaktrack* )( io[ 5 ] );
+
+    // store pointer copies for local use
+    t_float*           track_freq  = object->track_freq;
+    t_float*           track_mag   = object->track_mag;
+    t_int*             track_state = object->track_state;
+    t_int*             track_peak  = object->track_peak;
+    t_peaktrack_point* active      = object->active;
+    t_peaktrack_link*  links       = object->links;
+    t_peaktrack_point* peaks       = object->peaks;
+    t_peaktrack_point* births      = object->births;
+
+    // store variable copies for local use
+    t_float deviation = object->deviation;
+
+    // every slot must fit in the output list
+    t_int capacity = ClipMin( PARTIALS_CAPACITY( frames ), 0 );
+    t_int slots    = object->tracks < capacity ? object->tracks : capacity;
+
+    // output list sections
+    t_float* bins  = PARTIALS_BINS ( out, frames );
+    t_float* mags  = PARTIALS_MAGS ( out, frames );
+    t_float* freqs = PARTIALS_FREQS( out, frames );
+
+    // counts of peaks, active tracks, links, births, and output partials
+    t_int peak_count;
+    t_int active_count = 0;
+    t_int link_count   = 0;
+    t_int birth_count  = 0;
+    t_int count        = 0;
+
+    // iterator and index variables
+    t_int   slot;
+    t_int   index;
+    t_int   peak;
+    t_int   side;
+    t_float distance;
+
+    // read the inputs before the output, which may share their memory
+    peak_count = peaktrack_gather( object, in1, in2, frames );
+
+    // age the slots of ended tracks and collect the active ones
+    for( slot = 0 ; slot < slots ; ++slot )
+    {
+        track_peak[ slot ] = -1;
+
+        switch( track_state[ slot ] )
+        {
+            case TRACK_RESTING : track_state[ slot ] = TRACK_FREE;    break;
+            case TRACK_DYING   : track_state[ slot ] = TRACK_RESTING; break;
+
+            case TRACK_ACTIVE :
+            {
+                active[ active_count ].freq  = track_freq[ slot ];
+                active[ active_count ].mag   = track_mag [ slot ];
+                active[ active_count ].index = slot;
+                ++active_count;
+                break;
+            }
+
+            default : break;
+        }
+    }
+
+    peaktrack_sort_points( active, active_count, peaktrack_by_freq );
+
+    // link each track to the nearest peak on either side within the deviation
+    for( index = 0, peak = 0 ; index < active_count ; ++index )
+    {
+        while( ( peak < peak_count ) && ( peaks[ peak ].freq < active[ index ].freq ) )
+        {
+            ++peak;
+        }
+
+        for( side = peak - 1 ; side <= peak ; ++side )
+        {
+            if( ( side < 0 ) || ( side >= peak_count ) )
+            {
+                continue;
+            }
+
+            distance = Absolute( peaks[ side ].freq - active[ index ].freq );
+
+            if( distance <= deviation )
+            {
+                links[ link_count ].distance = distance;
+                links[ link_count ].track    = active[ index ].index;
+                links[ link_count ].peak     = side;
+                ++link_count;
+            }
+        }
+    }
+
+    peaktrack_heap_links( links, link_count );
+
+    // take the closest links first, each track and peak once
+    for( index = 0 ; index < link_count ; ++index )
+    {
+        slot = links[ index ].track;
+        peak = links[ index ].peak;
+
+        if( ( track_peak[ slot ] < 0 ) && ( peaks[ peak ].index < 0 ) )
+        {
+            track_peak[ slot ]  = peak;
+            peaks[ peak ].index = slot;
+        }
+    }
+
+    // continue matched tracks and end the rest
+    for( index = 0 ; index < active_count ; ++index )
+    {
+        slot = active[ index ].index;
+        peak = track_peak[ slot ];
+
+        if( peak < 0 )
+        {
+            track_state[ slot ] = TRACK_DYING;
+        }
+        else
+        {
+            track_freq[ slot ] = peaks[ peak ].freq;
+            track_mag [ slot ] = peaks[ peak ].mag;
+        }
+    }
+
+    // start tracks on unclaimed peaks, strongest first, in the lowest free slots
+    for( peak = 0 ; peak < peak_count ; ++peak )
+    {
+        if( peaks[ peak ].index < 0 )
+        {
+            births[ birth_count ] = peaks[ peak ];
+            ++birth_count;
+        }
+    }
+
+    peaktrack_heap_points( births, birth_count, peaktrack_by_mag );
+
+    for( index = 0, slot = 0 ; index < birth_count ; ++index )
+    {
+        while( ( slot < slots ) && ( track_state[ slot ] != TRACK_FREE ) )
+        {
+            ++slot;
+        }
+
+        if( slot == slots )
+        {
+            break;
+        }
+
+        track_state[ slot ] = TRACK_ACTIVE;
+        track_freq [ slot ] = births[ index ].freq;
+        track_mag  [ slot ] = births[ index ].mag;
+    }
+
+    // write the tracks as a partial list indexed by slot, ending tracks
+    // fading out at their last frequency
+    memset( out, 0, frames * sizeof( t_float ) );
+
+    for( slot = 0 ; slot < slots ; ++slot )
+    {
+        if( ( track_state[ slot ] == TRACK_ACTIVE ) || ( track_state[ slot ] == TRACK_DYING ) )
+        {
+            bins [ count ] = slot;
+            mags [ count ] = track_state[ slot ] == TRACK_ACTIVE ? track_mag[ slot ] : 0;
+            freqs[ count ] = track_freq[ slot ];
+            ++count;
+        }
+    }
+
+    out[ 0 ] = count;
+
+    // return the dsp input/output array address plus one more than its size
+    // to provide a pointer to the next perform function in pd's call list
+    return &( io[ 6 ] );
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_dsp - installs this object's dsp function in pd's callback list
+//------------------------------------------------------------------------------
+static void peaktrack_dsp( t_peaktrack* object, t_signal **sig )
+{
+    // calculate memory size of peak arrays for realloc
+    t_int memory_size = sig[ 0 ]->s_n * sizeof( t_peaktrack_point );
+
+    // only reallocate memory when the vector size has changed
+    if( memory_size != object->memory_size )
+    {
+        object->peaks  = ( t_peaktrack_point* )realloc( object->peaks,  memory_size );
+        object->births = ( t_peaktrack_point* )realloc( object->births, memory_size );
+
+        // save memory_size for use in dsp loop
+        object->memory_size = memory_size;
+    }
+
+    // dsp_add arguments
+    //--------------------------------------------------------------------------
+    // perform routine
+    // number of passed parameters
+    // inlet 1 sample vector
+    // inlet 2 sample vector
+    // outlet sample vector
+    // sample frames to process (vector size)
+    // pointer to this object
+    dsp_add( peaktrack_perform, 5, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 0 ]->s_n, object );
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_tracks - sets the number of track slots, ending every track
+//------------------------------------------------------------------------------
+static void peaktrack_tracks( t_peaktrack* object, t_floatarg tracks )
+{
+    t_int count = ClipMin( tracks, 1 );
+
+    object->track_freq  = ( t_float*           )realloc( object->track_freq,  count * sizeof( t_float ) );
+    object->track_mag   = ( t_float*           )realloc( object->track_mag,   count * sizeof( t_float ) );
+    object->track_state = ( t_int*             )realloc( object->track_state, count * sizeof( t_int ) );
+    object->track_peak  = ( t_int*             )realloc( object->track_peak,  count * sizeof( t_int ) );
+    object->active      = ( t_peaktrack_point* )realloc( object->active,      count * sizeof( t_peaktrack_point ) );
+    object->links       = ( t_peaktrack_link*  )realloc( object->links,       count * 2 * sizeof( t_peaktrack_link ) );
+
+    object->tracks = count;
+
+    peaktrack_reset( object );
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_deviation - sets the largest frequency change of a continuing track
+//------------------------------------------------------------------------------
+static void peaktrack_deviation( t_peaktrack* object, t_floatarg deviation )
+{
+    object->deviation = ClipMin( deviation, 0 );
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_sparse - switches inlet 1 between dense magnitudes and a sparse partial list
+//------------------------------------------------------------------------------
+static void peaktrack_sparse( t_peaktrack* object, t_floatarg sparse )
+{
+    object->sparse = ( sparse != 0 );
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_reset - ends every track at once
+//------------------------------------------------------------------------------
+static void peaktrack_reset( t_peaktrack* object )
+{
+    memset( object->track_freq,  0, object->tracks * sizeof( t_float ) );
+    memset( object->track_mag,   0, object->tracks * sizeof( t_float ) );
+    memset( object->track_state, 0, object->tracks * sizeof( t_int ) );
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_new - instantiates a copy of this object in pd
+//------------------------------------------------------------------------------
+static void* peaktrack_new( t_symbol* selector, t_int items, t_atom* list )
+{
+    // create a pointer to this object
+    t_peaktrack* object = ( t_peaktrack* )pd_new( peaktrack_class );
+
+    // create an additional signal inlet
+    signalinlet_new( &object->object, object->inlet_2 );
+
+    // create a signal outlet
+    outlet_new( &object->object, gensym( "signal" ) );
+
+    // initialize memory pointers
+    object->track_freq  = NULL;
+    object->track_mag   = NULL;
+    object->track_state = NULL;
+    object->track_peak  = NULL;
+    object->active      = NULL;
+    object->links       = NULL;
+    object->peaks       = NULL;
+    object->births      = NULL;
+
+    // initialize variables
+    object->inlet_1     = 0;
+    object->inlet_2     = 0;
+    object->memory_size = 0;
+    object->deviation   = PEAKTRACK_DEFAULT_DEVIATION;
+    object->sparse      = FALSE;
+
+    // parse initialization arguments
+    //--------------------------------------------------------------------------
+    t_float tracks = PEAKTRACK_DEFAULT_TRACKS;
+
+    if( items > 0 )
+    {
+        if( list[ 0 ].a_type == A_FLOAT )
+        {
+            tracks = atom_getfloatarg( 0, ( int )items, list );
+        }
+        else
+        {
+            pd_error( object, "peaktrack~: invalid argument 1 type" );
+        }
+    }
+
+    if( items > 1 )
+    {
+        if( list[ 1 ].a_type == A_FLOAT )
+        {
+            peaktrack_deviation( object, atom_getfloatarg( 1, ( int )items, list ) );
+        }
+        else
+        {
+            pd_error( object, "peaktrack~: invalid argument 2 type" );
+        }
+    }
+
+    if( items > 2 )
+    {
+        pd_error( object, "peaktrack~: extra arguments ignored" );
+    }
+
+    // allocate the track slots
+    peaktrack_tracks( object, tracks );
+
+    return object;
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_free - cleans up memory allocated by this object
+//------------------------------------------------------------------------------
+static void peaktrack_free( t_peaktrack* object )
+{
+    // if memory is allocated
+    if( object->track_freq )
+    {
+        // deallocate the memory
+        free( object->track_freq );
+
+        // set the memory pointer to null
+        object->track_freq = NULL;
+    }
+
+    // . . .
+    if( object->track_mag )
+    {
+        free( object->track_mag );
+        object->track_mag = NULL;
+    }
+
+    if( object->track_state )
+    {
+        free( object->track_state );
+        object->track_state = NULL;
+    }
+
+    if( object->track_peak )
+    {
+        free( object->track_peak );
+        object->track_peak = NULL;
+    }
+
+    if( object->active )
+    {
+        free( object->active );
+        object->active = NULL;
+    }
+
+    if( object->links )
+    {
+        free( object->links );
+        object->links = NULL;
+    }
+
+    if( object->peaks )
+    {
+        free( object->peaks );
+        object->peaks = NULL;
+    }
+
+    if( object->births )
+    {
+        free( object->births );
+        object->births = NULL;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// peaktrack_tilde_setup - describes the attributes of this object to pd so it may be properly instantiated
+// (must always be named with _tilde replacing ~ in the object name)
+//------------------------------------------------------------------------------
+void peaktrack_tilde_setup( void )
+{
+    // creates an instance of this object and describes it to pd
+    peaktrack_class = class_new( gensym( "peaktrack~" ), ( t_newmethod )peaktrack_new, ( t_method )peaktrack_free, sizeof( t_peaktrack ), 0, A_GIMME, 0 );
+
+    // declares leftmost inlet as a signal inlet
+    CLASS_MAINSIGNALIN( peaktrack_class, t_peaktrack, inlet_1 );
+
+    // installs peaktrack_dsp so that it will be called when dsp is turned on
+    class_addmethod( peaktrack_class, ( t_method )peaktrack_dsp, gensym( "dsp" ), 0 );
+
+    // installs peaktrack_tracks to respond to "tracks" message
+    class_addmethod( peaktrack_class, ( t_method )peaktrack_tracks, gensym( "tracks" ), A_FLOAT, 0 );
+
+    // installs peaktrack_deviation to respond to "deviation" message
+    class_addmethod( peaktrack_class, ( t_method )peaktrack_deviation, gensym( "deviation" ), A_FLOAT, 0 );
+
+    // installs peaktrack_sparse to respond to "sparse" message
+    class_addmethod( peaktrack_class, ( t_method )peaktrack_sparse, gensym( "sparse" ), A_FLOAT, 0 );
+
+    // installs peaktrack_reset to respond to "reset" message
+    class_addmethod( peaktrack_class, ( t_method )peaktrack_reset, gensym( "reset" ), 0 );
+}
+
+
+//------------------------------------------------------------------------------
+// EOF
+//------------------------------------------------------------------------------
@@ -54,6 +54,9 @@ typedef struct phaseaccum
     // pointer to the array of phase sums
     t_float* phase_sums;
 
+    // memory size of the phase sums array
+    t_int memory_size;
+
 } t_phaseaccum;
 
 
@@ -62,6 +65,7 @@ typedef struct phaseaccum
 //------------------------------------------------------------------------------
 static t_int* phaseaccum_perform     ( t_int* io );
 static void   phaseaccum_dsp         ( t_phaseaccum* object, t_signal **sig );
+static void   phaseaccum_reset       ( t_phaseaccum* object );
 static void*  phaseaccum_new         ( void );
 static void   phaseaccum_free        ( t_phaseaccum* object );
 void          phaseaccum_tilde_setup ( void );
@@ -84,8 +88,9 @@ static t_int* phaseaccum_perform( t_int* io )
     // the dsp loop
     while( ++n < frames )
     {
-        // accumulate successive phase values into phase_sums array
-        phase_sums[ n ] += in[ n ];
+        // accumulate successive phase values into phase_sums array, flushing
+        // sums of a decaying input before they go subnormal
+        phase_sums[ n ] = FlushDenormal( phase_sums[ n ] + in[ n ] );
 
         // output accumulated phase
         out[ n ] = phase_sums[ n ];
@@ -105,11 +110,18 @@ static void phaseaccum_dsp( t_phaseaccum* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_float memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate enough memory to hold the sums of frame phases
-    object->phase_sums = realloc( object->phase_sums, memory_size );
+    // only reallocate and clear memory when the vector size has changed
+    if( memory_size != object->memory_size )
+    {
+        // allocate enough memory to hold the sums of frame phases
+        object->phase_sums = realloc( object->phase_sums, memory_size );
+
+        // set allocated memory values to 0
+        memset( object->phase_sums, 0, memory_size );
 
-    // set allocated memory values to 0
-    memset( object->phase_sums, 0, memory_size );
+        // save memory size for reset and dsp change detection
+        object->memory_size = memory_size;
+    }
 
     // dsp_add arguments
     //--------------------------------------------------------------------------
@@ -123,6 +135,19 @@ static void phaseaccum_dsp( t_phaseaccum* object, t_signal **sig )
 }
 
 
+//------------------------------------------------------------------------------
+// phaseaccum_reset - clears the accumulated phase sums
+//------------------------------------------------------------------------------
+static void phaseaccum_reset( t_phaseaccum* object )
+{
+    // only clear memory that has been allocated
+    if( object->phase_sums )
+    {
+        memset( object->phase_sums, 0, object->memory_size );
+    }
+}
+
+
 //------------------------------------------------------------------------------
 // phaseaccum_new - instantiates a copy of this object in pd
 //------------------------------------------------------------------------------
@@ -137,6 +162,9 @@ static void* phaseaccum_new( void )
     // initialize the array pointer to null
     object->phase_sums = NULL;
 
+    // initialize memory size
+    object->memory_size = 0;
+
     return object;
 }
 
@@ -172,6 +200,9 @@ void phaseaccum_tilde_setup( void )
 
     // installs phaseaccum_dsp so that it will be called when dsp is turned on
     class_addmethod( phaseaccum_class, ( t_method )phaseaccum_dsp, gensym( "dsp" ), 0 );
+
+    // installs phaseaccum_reset to respond to "reset" message
+    class_addmethod( phaseaccum_class, ( t_method )phaseaccum_reset, gensym( "reset" ), 0 );
 }
 
 
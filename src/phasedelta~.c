@@ -57,6 +57,9 @@ typedef struct phasedelta
     // pointer to an array for temporary signal vector storage
     t_float* temp;
 
+    // memory size of the signal vector arrays
+    t_int memory_size;
+
 } t_phasedelta;
 
 
@@ -65,6 +68,7 @@ typedef struct phasedelta
 //------------------------------------------------------------------------------
 static t_int* phasedelta_perform     ( t_int* io );
 static void   phasedelta_dsp         ( t_phasedelta* object, t_signal **sig );
+static void   phasedelta_reset       ( t_phasedelta* object );
 static void*  phasedelta_new         ( void );
 static void   phasedelta_free        ( t_phasedelta* object );
 void          phasedelta_tilde_setup ( void );
@@ -113,13 +117,20 @@ static void phasedelta_dsp( t_phasedelta* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate enough memory to hold signal vector data
-    object->in_old = realloc( object->in_old, memory_size );
-    object->temp   = realloc( object->temp,   memory_size );
+    // only reallocate and clear memory when the vector size has changed
+    if( memory_size != object->memory_size )
+    {
+        // allocate enough memory to hold signal vector data
+        object->in_old = realloc( object->in_old, memory_size );
+        object->temp   = realloc( object->temp,   memory_size );
+
+        // set allocated memory values to 0
+        memset( object->in_old, 0, memory_size );
+        memset( object->temp,   0, memory_size );
 
-    // set allocated memory values to 0
-    memset( object->in_old, 0, memory_size );
-    memset( object->temp,   0, memory_size );
+        // save memory size for reset and dsp change detection
+        object->memory_size = memory_size;
+    }
 
     // dsp_add arguments
     //--------------------------------------------------------------------------
@@ -135,6 +146,20 @@ static void phasedelta_dsp( t_phasedelta* object, t_signal **sig )
 }
 
 
+//------------------------------------------------------------------------------
+// phasedelta_reset - clears the previous fft phase data
+//------------------------------------------------------------------------------
+static void phasedelta_reset( t_phasedelta* object )
+{
+    // only clear memory that has been allocated
+    if( object->in_old )
+    {
+        memset( object->in_old, 0, object->memory_size );
+        memset( object->temp,   0, object->memory_size );
+    }
+}
+
+
 //------------------------------------------------------------------------------
 // phasedelta_new - instantiates a copy of this object in pd
 //------------------------------------------------------------------------------
@@ -195,6 +220,9 @@ void phasedelta_tilde_setup( void )
 
     // installs phasedelta_dsp so that it will be called when dsp is turned on
     class_addmethod( phasedelta_class, ( t_method )phasedelta_dsp, gensym( "dsp" ), 0 );
+
+    // installs phasedelta_reset to respond to "reset" message
+    class_addmethod( phasedelta_class, ( t_method )phasedelta_reset, gensym( "reset" ), 0 );
 }
 
 
@@ -69,6 +69,9 @@ typedef struct phasetofreq
     // the local sample rate
     t_float sample_rate;
 
+    // dsp timing record read by spectprof ( empty unless profiling is compiled in )
+    PROFILE_MEMBER
+
 } t_phasetofreq;
 
 
@@ -77,6 +80,7 @@ typedef struct phasetofreq
 //------------------------------------------------------------------------------
 static t_int* phasetofreq_perform     ( t_int* io );
 static void   phasetofreq_dsp         ( t_phasetofreq* object, t_signal **sig );
+static void   phasetofreq_reset       ( t_phasetofreq* object );
 static void   phasetofreq_overlap     ( t_phasetofreq* object, t_floatarg overlap );
 static void*  phasetofreq_new         ( t_symbol* symbol, t_int items, t_atom* list );
 static void   phasetofreq_free        ( t_phasetofreq* object );
@@ -89,10 +93,11 @@ void          phasetofreq_tilde_setup ( void );
 static t_int* phasetofreq_perform( t_int* io )
 {
     // store variables from dsp input/output array
-    t_float*       in1    = ( t_float*       )( io[ 1 ] );
-    t_float*       out1   = ( t_float*       )( io[ 2 ] );
-    t_float        frames = ( t_int          )( io[ 3 ] );
-    t_phasetofreq* object = ( t_phasetofreq* )( io[ 4 ] );
+    t_float*       in1      = ( t_float*       )( io[ 1 ] );
+    t_float*       out1     = ( t_float*       )( io[ 2 ] );
+    t_float        frames   = ( t_int          )( io[ 3 ] );
+    t_int          channels = ( t_int          )( io[ 4 ] );
+    t_phasetofreq* object   = ( t_phasetofreq* )( io[ 5 ] );
 
     // store values from object's data structure
     t_float* delta_temp  = object->delta_array_temp;
@@ -107,8 +112,9 @@ static t_int* phasetofreq_perform( t_int* io )
     // sample rate multiplied by overlap factor
     sample_rate = sample_rate / overlap;
 
-    // signal vector iterator variable
-    t_int n = -1;
+    // signal vector and channel iterator variables
+    t_int n;
+    t_int channel;
 
     // allocate calculation variables
     t_float phase;
@@ -116,37 +122,49 @@ static t_int* phasetofreq_perform( t_int* io )
     t_float freq_offset;
     t_float frequency;
 
-    // copy input1 to delta temp array
+    // copy input1 to delta temp array ( every channel )
     memcpy( delta_temp, in1, memory_size );
 
-    // the dsp loop
-    while( ++n < frames )
+    // the channel loop - each channel is a block of frames after the last
+    for( channel = 0 ; channel < channels ; ++channel )
     {
-        // calculate phase deviation
-        phase = in1[ n ] - delta_old[ n ];
+        // reset signal vector iterator
+        n = -1;
+
+        // the dsp loop
+        while( ++n < frames )
+        {
+            // calculate phase deviation
+            phase = in1[ n ] - delta_old[ n ];
+
+            // wrap phase between -pi and pi
+            phase = WrapPosNegPi( phase );
 
-        // wrap phase between -pi and pi
-        phase = WrapPosNegPi( phase );
+            // calculate center frequency of each bin
+            bin_freq = ( ( t_float )n / frames ) * sample_rate;
 
-        // calculate center frequency of each bin
-        bin_freq = ( ( t_float )n / frames ) * sample_rate;
+            // calculate frequency offset of contents of each bin
+            freq_offset = phase * ( ( ( sample_rate * overlap ) / frames ) / C_2_PI );
 
-        // calculate frequency offset of contents of each bin
-        freq_offset = phase * ( ( ( sample_rate * overlap ) / frames ) / C_2_PI );
+            // calculate frequency present in each bin
+            frequency = bin_freq + freq_offset;
 
-        // calculate frequency present in each bin
-        frequency = bin_freq + freq_offset;
+            // store output samples
+            out1[ n ] = frequency;
+        }
 
-        // store output samples
-        out1[ n ] = frequency;
+        // move on to the next channel
+        in1       += ( t_int )frames;
+        out1      += ( t_int )frames;
+        delta_old += ( t_int )frames;
     }
 
     // copy delta_temp array into delta_old array for next dsp vector calculation
-    memcpy( delta_old, delta_temp, memory_size );
+    memcpy( object->delta_array_old, delta_temp, memory_size );
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
-    return &( io[ 5 ] );
+    return &( io[ 6 ] );
 }
 
 
@@ -155,19 +173,33 @@ static t_int* phasetofreq_perform( t_int* io )
 //------------------------------------------------------------------------------
 static void phasetofreq_dsp( t_phasetofreq* object, t_signal **sig )
 {
-    // calculate memory size for realloc and memset
-    t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
+    // number of channels in the inlet
+    t_int channels = SignalChannels( sig[ 0 ] );
 
-    // allocate enough memory to hold signal vector data
-    object->delta_array_temp = realloc( object->delta_array_temp, memory_size );
-    object->delta_array_old  = realloc( object->delta_array_old,  memory_size );
+    // calculate memory size for realloc and memset ( all channels )
+    t_int memory_size = sig[ 0 ]->s_n * channels * sizeof( t_float );
 
-    // set allocated memory values to 0
-    memset( object->delta_array_temp, 0, memory_size );
-    memset( object->delta_array_old,  0, memory_size );
+    // give the outlet as many channels as the inlet
+    SignalSetChannels( &sig[ 1 ], channels );
 
-    object->memory_size = memory_size;
-    object->sample_rate = sig[ 0 ]->s_sr;
+    // only reallocate and clear memory when the vector size or sample rate has changed
+    if( ( memory_size != object->memory_size ) || ( sig[ 0 ]->s_sr != object->sample_rate ) )
+    {
+        // allocate enough memory to hold signal vector data
+        object->delta_array_temp = realloc( object->delta_array_temp, memory_size );
+        object->delta_array_old  = realloc( object->delta_array_old,  memory_size );
+
+        // set allocated memory values to 0
+        memset( object->delta_array_temp, 0, memory_size );
+        memset( object->delta_array_old,  0, memory_size );
+
+        // save vector memory size and sample rate
+        object->memory_size = memory_size;
+        object->sample_rate = sig[ 0 ]->s_sr;
+    }
+
+    // start timing this object ( when profiling is compiled in )
+    PROFILE_DSP_BEGIN( object );
 
     // dsp_add arguments
     //--------------------------------------------------------------------------
@@ -176,16 +208,35 @@ static void phasetofreq_dsp( t_phasetofreq* object, t_signal **sig )
     // inlet 1 sample vector
     // outlet 1 sample vector
     // sample frames to process (vector size)
+    // number of channels
     // pointer to this object
     dsp_add
     (
         phasetofreq_perform,
-        4,
+        5,
         sig[ 0 ]->s_vec,
         sig[ 1 ]->s_vec,
         sig[ 0 ]->s_n,
+        channels,
         object
     );
+
+    // stop timing this object
+    PROFILE_DSP_END( object );
+}
+
+
+//------------------------------------------------------------------------------
+// phasetofreq_reset - clears the previous phase deviation data
+//------------------------------------------------------------------------------
+static void phasetofreq_reset( t_phasetofreq* object )
+{
+    // only clear memory that has been allocated
+    if( object->delta_array_old )
+    {
+        memset( object->delta_array_temp, 0, object->memory_size );
+        memset( object->delta_array_old,  0, object->memory_size );
+    }
 }
 
 
@@ -206,6 +257,9 @@ static void* phasetofreq_new( t_symbol* symbol, t_int items, t_atom* list )
     // create a pointer to this object
     t_phasetofreq* object = ( t_phasetofreq* )pd_new( phasetofreq_class );
 
+    // register with the dsp profiler
+    PROFILE_REGISTER( object, "phasetofreq~" );
+
     // create a float inlet to receive overlap factor value
     inlet_new( &object->object, &object->object.ob_pd, gensym( "float" ), gensym( "overlap" ) );
 
@@ -235,6 +289,9 @@ static void* phasetofreq_new( t_symbol* symbol, t_int items, t_atom* list )
 //------------------------------------------------------------------------------
 static void phasetofreq_free( t_phasetofreq* object )
 {
+    // unregister from the dsp profiler
+    PROFILE_UNREGISTER( object );
+
     // if memory is allocated
     if( object->delta_array_temp )
     {
@@ -260,7 +317,7 @@ static void phasetofreq_free( t_phasetofreq* object )
 void phasetofreq_tilde_setup( void )
 {
     // creates an instance of this object and describes it to pd
-    phasetofreq_class = class_new( gensym( "phasetofreq~" ), ( t_newmethod )phasetofreq_new, ( t_method )phasetofreq_free, sizeof( t_phasetofreq ), 0, A_GIMME, 0 );
+    phasetofreq_class = class_new( gensym( "phasetofreq~" ), ( t_newmethod )phasetofreq_new, ( t_method )phasetofreq_free, sizeof( t_phasetofreq ), MULTICHANNEL, A_GIMME, 0 );
 
     // declares leftmost inlet as a signal inlet
     CLASS_MAINSIGNALIN( phasetofreq_class, t_phasetofreq, inlet_1 );
@@ -270,6 +327,9 @@ void phasetofreq_tilde_setup( void )
 
     // associate a method with the "overlap" symbol for subsequent overlap inlet handling
     class_addmethod( phasetofreq_class, ( t_method )phasetofreq_overlap, gensym( "overlap" ), A_FLOAT, 0 );
+
+    // installs phasetofreq_reset to respond to "reset" message
+    class_addmethod( phasetofreq_class, ( t_method )phasetofreq_reset, gensym( "reset" ), 0 );
 }
 
 
@@ -108,6 +108,24 @@ static t_int* polartocar_perform( t_int* io )
 //------------------------------------------------------------------------------
 static void polartocar_dsp( t_polartocar* object, t_signal **sig )
 {
+    // the left inlet sets the channel count and the right inlet's channels
+    // repeat across it when it has fewer
+    t_int frames     = sig[ 0 ]->s_n;
+    t_int channels   = SignalChannels( sig[ 0 ] );
+    t_int channels_2 = SignalChannels( sig[ 1 ] );
+    t_int channel;
+
+    // give the outlets as many channels as the left inlet
+    SignalSetChannels( &sig[ 2 ], channels );
+    SignalSetChannels( &sig[ 3 ], channels );
+
+    // matching inlets convert every channel in one pass
+    if( channels_2 == channels )
+    {
+        frames  *= channels;
+        channels = 1;
+    }
+
     // dsp_add arguments
     //--------------------------------------------------------------------------
     // perform routine
@@ -116,8 +134,11 @@ static void polartocar_dsp( t_polartocar* object, t_signal **sig )
     // inlet 2 sample vector
     // outlet 1 sample vector
     // outlet 2 sample vector
-    // sample frames to process (vector size)
-    dsp_add( polartocar_perform, 5, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 3 ]->s_vec, sig[ 0 ]->s_n );
+    // sample frames to process (vector size times channels when inlets match)
+    for( channel = 0 ; channel < channels ; ++channel )
+    {
+        dsp_add( polartocar_perform, 5, sig[ 0 ]->s_vec + channel * frames, sig[ 1 ]->s_vec + ( channel % channels_2 ) * frames, sig[ 2 ]->s_vec + channel * frames, sig[ 3 ]->s_vec + channel * frames, frames );
+    }
 }
 
 
@@ -147,7 +168,7 @@ static void* polartocar_new( void )
 void polartocar_tilde_setup( void )
 {
     // creates an instance of this object and describes it to pd
-    polartocar_class = class_new( gensym( "polartocar~" ), ( t_newmethod )polartocar_new, 0, sizeof( t_polartocar ), 0, 0, 0 );
+    polartocar_class = class_new( gensym( "polartocar~" ), ( t_newmethod )polartocar_new, 0, sizeof( t_polartocar ), MULTICHANNEL, 0, 0 );
 
     // declares leftmost inlet as a signal inlet
     CLASS_MAINSIGNALIN( polartocar_class, t_polartocar, inlet_1 );
@@ -69,6 +69,9 @@ typedef struct polartofreq
     // the local sample rate
     t_float sample_rate;
 
+    // dsp timing record read by spectprof ( empty unless profiling is compiled in )
+    PROFILE_MEMBER
+
 } t_polartofreq;
 
 
@@ -77,6 +80,7 @@ typedef struct polartofreq
 //------------------------------------------------------------------------------
 static t_int* polartofreq_perform     ( t_int* io );
 static void   polartofreq_dsp         ( t_polartofreq* object, t_signal **sig );
+static void   polartofreq_reset       ( t_polartofreq* object );
 static void   polartofreq_overlap     ( t_polartofreq* object, t_floatarg overlap );
 static void*  polartofreq_new         ( t_symbol* symbol, t_int items, t_atom* list );
 static void   polartofreq_free        ( t_polartofreq* object );
@@ -174,16 +178,24 @@ static void polartofreq_dsp( t_polartofreq* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate enough memory to hold signal vector data
-    object->delta_array_temp = realloc( object->delta_array_temp, memory_size );
-    object->delta_array_old  = realloc( object->delta_array_old,  memory_size );
+    // only reallocate and clear memory when the vector size or sample rate has changed
+    if( ( memory_size != object->memory_size ) || ( sig[ 0 ]->s_sr != object->sample_rate ) )
+    {
+        // allocate enough memory to hold signal vector data
+        object->delta_array_temp = realloc( object->delta_array_temp, memory_size );
+        object->delta_array_old  = realloc( object->delta_array_old,  memory_size );
 
-    // set allocated memory values to 0
-    memset( object->delta_array_temp, 0, memory_size );
-    memset( object->delta_array_old,  0, memory_size );
+        // set allocated memory values to 0
+        memset( object->delta_array_temp, 0, memory_size );
+        memset( object->delta_array_old,  0, memory_size );
 
-    object->memory_size = memory_size;
-    object->sample_rate = sig[ 0 ]->s_sr;
+        // save vector memory size and sample rate
+        object->memory_size = memory_size;
+        object->sample_rate = sig[ 0 ]->s_sr;
+    }
+
+    // start timing this object ( when profiling is compiled in )
+    PROFILE_DSP_BEGIN( object );
 
     // dsp_add arguments
     //--------------------------------------------------------------------------
@@ -206,6 +218,23 @@ static void polartofreq_dsp( t_polartofreq* object, t_signal **sig )
         sig[ 0 ]->s_n,
         object
     );
+
+    // stop timing this object
+    PROFILE_DSP_END( object );
+}
+
+
+//------------------------------------------------------------------------------
+// polartofreq_reset - clears the previous phase deviation data
+//------------------------------------------------------------------------------
+static void polartofreq_reset( t_polartofreq* object )
+{
+    // only clear memory that has been allocated
+    if( object->delta_array_old )
+    {
+        memset( object->delta_array_temp, 0, object->memory_size );
+        memset( object->delta_array_old,  0, object->memory_size );
+    }
 }
 
 
@@ -226,6 +255,9 @@ static void* polartofreq_new( t_symbol* symbol, t_int items, t_atom* list )
     // create a pointer to this object
     t_polartofreq* object = ( t_polartofreq* )pd_new( polartofreq_class );
 
+    // register with the dsp profiler
+    PROFILE_REGISTER( object, "polartofreq~" );
+
     // create a second signal inlet
     signalinlet_new( &object->object, object->inlet_2 );
 
@@ -259,6 +291,9 @@ static void* polartofreq_new( t_symbol* symbol, t_int items, t_atom* list )
 //------------------------------------------------------------------------------
 static void polartofreq_free( t_polartofreq* object )
 {
+    // unregister from the dsp profiler
+    PROFILE_UNREGISTER( object );
+
     // if memory is allocated
     if( object->delta_array_temp )
     {
@@ -294,6 +329,9 @@ void polartofreq_tilde_setup( void )
 
     // associate a method with the "overlap" symbol for subsequent overlap inlet handling
     class_addmethod( polartofreq_class, ( t_method )polartofreq_overlap, gensym( "overlap" ), A_FLOAT, 0 );
+
+    // installs polartofreq_reset to respond to "reset" message
+    class_addmethod( polartofreq_class, ( t_method )polartofreq_reset, gensym( "reset" ), 0 );
 }
 
 
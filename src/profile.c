@@ -0,0 +1,188 @@
+//------------------------------------------------------------------------------
+//  Pd Spectral Toolkit
+//
+//  profile.c
+//
+//  Registry and perform chain hooks for opt-in per object dsp timing
+//
+//  Copyright (C) 2019 Cooper Baker. All Rights Reserved.
+//------------------------------------------------------------------------------
+
+//------------------------------------------------------------------------------
+// headers
+//------------------------------------------------------------------------------
+#include "profile.h"
+
+#ifdef SPECTRAL_PROFILE
+
+#include <string.h>
+
+
+//------------------------------------------------------------------------------
+// profile_list - every registered instance, newest first
+//------------------------------------------------------------------------------
+static t_profile* profile_list;
+
+
+//------------------------------------------------------------------------------
+// ProfileBucket - maps an elapsed time onto a quarter octave histogram bucket
+//------------------------------------------------------------------------------
+static t_int ProfileBucket( unsigned long long elapsed )
+{
+    t_int octave = 0;
+
+    if( elapsed < 4 )
+    {
+        return ( t_int )elapsed;
+    }
+
+    while( elapsed >> ( octave + 1 ) )
+    {
+        ++octave;
+    }
+
+    return octave * 4 + ( t_int )( ( elapsed >> ( octave - 2 ) ) & 3 );
+}
+
+
+//------------------------------------------------------------------------------
+// ProfileRegister - adds an instance to the registry
+//------------------------------------------------------------------------------
+void ProfileRegister( t_profile* profile, void* owner, const char* name )
+{
+    memset( profile, 0, sizeof( t_profile ) );
+
+    profile->name  = name;
+    profile->owner = owner;
+    profile->next  = profile_list;
+
+    if( profile_list )
+    {
+        profile_list->previous = profile;
+    }
+
+    profile_list = profile;
+}
+
+
+//------------------------------------------------------------------------------
+// ProfileUnregister - removes an instance from the registry
+//------------------------------------------------------------------------------
+void ProfileUnregister( t_profile* profile )
+{
+    if( profile->previous )
+    {
+        profile->previous->next = profile->next;
+    }
+    else if( profile_list == profile )
+    {
+        profile_list = profile->next;
+    }
+
+    if( profile->next )
+    {
+        profile->next->previous = profile->previous;
+    }
+
+    profile->next     = NULL;
+    profile->previous = NULL;
+}
+
+
+//------------------------------------------------------------------------------
+// ProfileReset - clears the timing statistics of an instance
+//------------------------------------------------------------------------------
+void ProfileReset( t_profile* profile )
+{
+    profile->calls = 0;
+    profile->total = 0;
+    profile->max   = 0;
+
+    memset( profile->histogram, 0, sizeof( profile->histogram ) );
+}
+
+
+//------------------------------------------------------------------------------
+// ProfileFirst - head of the registry ( follow ->next for the rest )
+//------------------------------------------------------------------------------
+t_profile* ProfileFirst( void )
+{
+    return profile_list;
+}
+
+
+//------------------------------------------------------------------------------
+// ProfilePercentile - upper bound of the bucket holding the given fraction
+//------------------------------------------------------------------------------
+unsigned long long ProfilePercentile( t_profile* profile, double fraction )
+{
+    unsigned long long target = ( unsigned long long )( fraction * profile->calls );
+    unsigned long long count  = 0;
+    t_int              bucket;
+
+    for( bucket = 0 ; bucket < PROFILE_BUCKETS ; ++bucket )
+    {
+        count += profile->histogram[ bucket ];
+
+        if( count > target || count == profile->calls )
+        {
+            break;
+        }
+    }
+
+    if( bucket < 4 )
+    {
+        return bucket;
+    }
+
+    // first value of the next bucket
+    ++bucket;
+
+    return ( unsigned long long )( 4 + ( bucket & 3 ) ) << ( bucket / 4 - 2 );
+}
+
+
+//------------------------------------------------------------------------------
+// ProfileBegin - perform chain entry placed before a profiled perform routine
+//------------------------------------------------------------------------------
+t_int* ProfileBegin( t_int* io )
+{
+    t_profile* profile = ( t_profile* )( io[ 1 ] );
+
+    profile->start = ProfileTime();
+
+    return &( io[ 2 ] );
+}
+
+
+//------------------------------------------------------------------------------
+// ProfileEnd - perform chain entry placed after a profiled perform routine
+//------------------------------------------------------------------------------
+t_int* ProfileEnd( t_int* io )
+{
+    t_profile*         profile = ( t_profile* )( io[ 1 ] );
+    unsigned long long elapsed = ProfileTime() - profile->start;
+    t_int              bucket  = ProfileBucket( elapsed );
+
+    profile->calls += 1;
+    profile->total += elapsed;
+
+    if( elapsed > profile->max )
+    {
+        profile->max = elapsed;
+    }
+
+    if( bucket < PROFILE_BUCKETS )
+    {
+        ++profile->histogram[ bucket ];
+    }
+
+    return &( io[ 2 ] );
+}
+
+#endif
+
+
+//------------------------------------------------------------------------------
+// EOF
+//------------------------------------------------------------------------------
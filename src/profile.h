@@ -0,0 +1,138 @@
+//------------------------------------------------------------------------------
+//  Pd Spectral Toolkit
+//
+//  profile.h
+//
+//  Opt-in per object dsp timing, reported by the spectprof object
+//
+//  Compiled in only when SPECTRAL_PROFILE is defined ( make linux
+//  PROFILE=-DSPECTRAL_PROFILE ). Otherwise every macro below expands to
+//  nothing, so instrumented objects carry no extra data or dsp chain entries.
+//
+//  Copyright (C) 2019 Cooper Baker. All Rights Reserved.
+//------------------------------------------------------------------------------
+
+#pragma once
+
+//------------------------------------------------------------------------------
+// headers
+//------------------------------------------------------------------------------
+
+// main header for pd
+#include "m_pd.h"
+
+#ifdef SPECTRAL_PROFILE
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#elif defined( __i386__ ) || defined( __x86_64__ )
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+
+//------------------------------------------------------------------------------
+// definitions
+//------------------------------------------------------------------------------
+
+// histogram resolution - four buckets per octave of elapsed time
+#define PROFILE_BUCKETS 256
+
+// unit reported by ProfileTime
+#if defined( _MSC_VER ) || defined( __i386__ ) || defined( __x86_64__ )
+#define PROFILE_UNITS "cycles"
+#else
+#define PROFILE_UNITS "ns"
+#endif
+
+
+//------------------------------------------------------------------------------
+// t_profile - timing record for one object instance
+//------------------------------------------------------------------------------
+// written only by the dsp thread from the perform chain, and read by spectprof
+// from the message thread, so plain counters are enough - no locks are taken
+// and a reader at worst sees a record one block out of date
+//------------------------------------------------------------------------------
+typedef struct profile
+{
+    // class name and instance of the profiled object
+    const char* name;
+    void*       owner;
+
+    // time stamp taken before the profiled perform routine
+    unsigned long long start;
+
+    // call count, total, and maximum elapsed time per block
+    unsigned long long calls;
+    unsigned long long total;
+    unsigned long long max;
+
+    // elapsed time histogram for percentile estimates
+    unsigned int histogram[ PROFILE_BUCKETS ];
+
+    // registry links
+    struct profile* next;
+    struct profile* previous;
+
+} t_profile;
+
+
+//------------------------------------------------------------------------------
+// ProfileTime - current time stamp in PROFILE_UNITS
+//------------------------------------------------------------------------------
+static inline unsigned long long ProfileTime( void )
+{
+#if defined( _MSC_VER ) || defined( __i386__ ) || defined( __x86_64__ )
+    return __rdtsc();
+#else
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return ( unsigned long long )now.tv_sec * 1000000000ULL + now.tv_nsec;
+#endif
+}
+
+
+//------------------------------------------------------------------------------
+// functions
+//------------------------------------------------------------------------------
+void               ProfileRegister    ( t_profile* profile, void* owner, const char* name );
+void               ProfileUnregister  ( t_profile* profile );
+void               ProfileReset       ( t_profile* profile );
+t_profile*         ProfileFirst       ( void );
+unsigned long long ProfilePercentile  ( t_profile* profile, double fraction );
+t_int*             ProfileBegin       ( t_int* io );
+t_int*             ProfileEnd         ( t_int* io );
+
+
+//------------------------------------------------------------------------------
+// instrumentation macros
+//------------------------------------------------------------------------------
+
+// declares the timing record inside an object's data structure
+#define PROFILE_MEMBER t_profile profile;
+
+// adds and removes an instance from the registry ( in _new and _free )
+#define PROFILE_REGISTER( object, name ) ProfileRegister( &( object )->profile, ( object ), ( name ) )
+#define PROFILE_UNREGISTER( object )     ProfileUnregister( &( object )->profile )
+
+// brackets the object's dsp_add call so its perform routine is timed
+#define PROFILE_DSP_BEGIN( object )      dsp_add( ProfileBegin, 1, &( object )->profile )
+#define PROFILE_DSP_END( object )        dsp_add( ProfileEnd, 1, &( object )->profile )
+
+#else
+
+#define PROFILE_MEMBER
+#define PROFILE_REGISTER( object, name )
+#define PROFILE_UNREGISTER( object )
+#define PROFILE_DSP_BEGIN( object )
+#define PROFILE_DSP_END( object )
+
+#endif
+
+
+//------------------------------------------------------------------------------
+// EOF
+//------------------------------------------------------------------------------
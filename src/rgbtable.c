@@ -34,22 +34,6 @@
 t_class* rgbtable_class;
 
 
-//------------------------------------------------------------------------------
-// SCHEME_ID - enumerated color scheme names
-//------------------------------------------------------------------------------
-enum SCHEME_ID
-{
-    RGB,
-    PURPLE_YELLOW,
-    BLUE_GREEN,
-    AMBER,
-    RED,
-    GREEN,
-    BLUE,
-    GREY
-};
-
-
 //------------------------------------------------------------------------------
 // rgbtable - data structure holding this object's data
 //------------------------------------------------------------------------------
@@ -153,61 +137,16 @@ void rgbtable_float( t_rgbtable* object, t_floatarg number )
 //------------------------------------------------------------------------------
 void rgbtable_message_parse( t_rgbtable* object, t_symbol* selector, t_int items, t_atom* list )
 {
-    // get selector string
-    const char* message = selector->s_name;
-
-    // rgb
-    if( StringMatch( message, "rgb" ) )
-    {
-        object->scheme_id = RGB;
-    }
-
-    // purple yellow
-    else if( StringMatch( message, "purple-yellow" ) )
-    {
-        object->scheme_id = PURPLE_YELLOW;
-    }
-
-    // blue green
-    else if( StringMatch( message, "blue-green" ) )
-    {
-        object->scheme_id = BLUE_GREEN;
-    }
-
-    // amber
-    else if( StringMatch( message, "amber" ) )
-    {
-        object->scheme_id = AMBER;
-    }
-
-    // red
-    else if( StringMatch( message, "red" ) )
-    {
-        object->scheme_id = RED;
-    }
+    // look up the named color scheme
+    t_int scheme_id = ColorSchemeId( selector->s_name );
 
-    // green
-    else if( StringMatch( message, "green" ) )
+    if( scheme_id < 0 )
     {
-        object->scheme_id = GREEN;
-    }
-
-    // blue
-    else if( StringMatch( message, "blue" ) )
-    {
-        object->scheme_id = BLUE;
-    }
-
-    // grey
-    else if( StringMatch( message, "grey" ) )
-    {
-        object->scheme_id = GREY;
+        pd_error( object, "rgbtable: unknown color scheme name" );
     }
-
-    // unknown
     else
     {
-        pd_error( object, "rgbtable: unknown color scheme name" );
+        object->scheme_id = scheme_id;
     }
 
     rgbtable_set_scheme( object );
@@ -220,45 +159,45 @@ void rgbtable_set_scheme( t_rgbtable* object )
 {
     switch( object->scheme_id )
     {
-        case RGB            :   object->r = object->r_rgb;
-                                object->g = object->g_rgb;
-                                object->b = object->b_rgb;
-                                break;
-
-        case PURPLE_YELLOW  :   object->r = object->r_py;
-                                object->g = object->g_py;
-                                object->b = object->b_py;
-                                break;
-
-        case BLUE_GREEN     :   object->r = object->r_bg;
-                                object->g = object->g_bg;
-                                object->b = object->b_bg;
-                                break;
-
-        case AMBER          :   object->r = object->r_a;
-                                object->g = object->g_a;
-                                object->b = object->b_a;
-                                break;
-
-        case RED            :   object->r = object->r_r;
-                                object->g = object->g_r;
-                                object->b = object->b_r;
-                                break;
-
-        case GREEN          :   object->r = object->r_g;
-                                object->g = object->g_g;
-                                object->b = object->b_g;
-                                break;
-
-        case BLUE           :   object->r = object->r_b;
-                                object->g = object->g_b;
-                                object->b = object->b_b;
-                                break;
-
-        case GREY           :   object->r = object->r_b;
-                                object->g = object->g_b;
-                                object->b = object->b_b;
-                                break;
+        case COLOR_RGB           :   object->r = object->r_rgb;
+                                     object->g = object->g_rgb;
+                                     object->b = object->b_rgb;
+                                     break;
+
+        case COLOR_PURPLE_YELLOW :   object->r = object->r_py;
+                                     object->g = object->g_py;
+                                     object->b = object->b_py;
+                                     break;
+
+        case COLOR_BLUE_GREEN    :   object->r = object->r_bg;
+                                     object->g = object->g_bg;
+                                     object->b = object->b_bg;
+                                     break;
+
+        case COLOR_AMBER         :   object->r = object->r_a;
+                                     object->g = object->g_a;
+                                     object->b = object->b_a;
+                                     break;
+
+        case COLOR_RED           :   object->r = object->r_r;
+                                     object->g = object->g_r;
+                                     object->b = object->b_r;
+                                     break;
+
+        case COLOR_GREEN         :   object->r = object->r_g;
+                                     object->g = object->g_g;
+                                     object->b = object->b_g;
+                                     break;
+
+        case COLOR_BLUE          :   object->r = object->r_b;
+                                     object->g = object->g_b;
+                                     object->b = object->b_b;
+                                     break;
+
+        case COLOR_GREY          :   object->r = object->r_b;
+                                     object->g = object->g_b;
+                                     object->b = object->b_b;
+                                     break;
     }
 }
 
@@ -385,50 +324,18 @@ void* rgbtable_new( t_symbol* selector, t_int items, t_atom* list )
 
         // calculate the color curves and store into tables
         //----------------------------------------------------------------------
-
-        // rgb
-        object->r_rgb[ i ] = 0.5 * ( 1.0 - Cosine( C_PI * x * x ) );
-        object->g_rgb[ i ] = 0.5 * ( 1.0 - Cosine( C_2_PI * x * x ) );
-        object->b_rgb[ i ] = ( 1.0 - ( 0.5 * ( 1.0 - Cosine( C_PI * x ) ) ) ) * Power( x, 0.75 ) * 3;
-
-        // purple yellow
-        object->r_py[ i ] = 0.5 * ( 1.0 - Cosine( C_PI * Power( x, 1.5 ) ) );
-        object->g_py[ i ] = x * x * x * x;
-        object->b_py[ i ] = ( 1.0 - ( 0.5 * ( 1.0 - Cosine( C_PI * x * x ) ) ) ) * Power( x, 0.75 ) * 1.25;
-
-        // blue green
-        object->r_bg[ i ] = x * x * x * x;
-        object->g_bg[ i ] = 0.5 * ( 1.0 - Cosine( C_PI * Power( x, 1.5 ) ) );
-        object->b_bg[ i ] = ( 1.0 - ( 0.5 * ( 1.0 - Cosine( C_PI * x * x ) ) ) ) * Power( x, 0.75 ) * 1.25;
-
-        // amber
-        object->r_a[ i ] = ( 0.5 * ( 1.0 - Cosine( C_PI * x ) ) );
-        object->g_a[ i ] = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x ) ) );
-        object->b_a[ i ] = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x * x ) ) );
-
-        // red
-        object->r_r[ i ] = ( 0.5 * ( 1.0 - Cosine( C_PI * x ) ) );
-        object->g_r[ i ] = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x * x * x ) ) );
-        object->b_r[ i ] = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x * x * x ) ) );
-
-        // green
-        object->r_g[ i ] = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x * x ) ) );
-        object->g_g[ i ] = ( 0.5 * ( 1.0 - Cosine( C_PI * x ) ) );
-        object->b_g[ i ] = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x ) ) );
-
-        // blue
-        object->r_b[ i ] = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x * x ) ) );
-        object->g_b[ i ] = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x ) ) );
-        object->b_b[ i ] = ( 0.5 * ( 1.0 - Cosine( C_PI * x ) ) );
-
-        // grey
-        object->r_gr[ i ] = x;
-        object->g_gr[ i ] = x;
-        object->b_gr[ i ] = x;
+        ColorCurve( COLOR_RGB,           x, &object->r_rgb[ i ], &object->g_rgb[ i ], &object->b_rgb[ i ] );
+        ColorCurve( COLOR_PURPLE_YELLOW, x, &object->r_py[ i ],  &object->g_py[ i ],  &object->b_py[ i ]  );
+        ColorCurve( COLOR_BLUE_GREEN,    x, &object->r_bg[ i ],  &object->g_bg[ i ],  &object->b_bg[ i ]  );
+        ColorCurve( COLOR_AMBER,         x, &object->r_a[ i ],   &object->g_a[ i ],   &object->b_a[ i ]   );
+        ColorCurve( COLOR_RED,           x, &object->r_r[ i ],   &object->g_r[ i ],   &object->b_r[ i ]   );
+        ColorCurve( COLOR_GREEN,         x, &object->r_g[ i ],   &object->g_g[ i ],   &object->b_g[ i ]   );
+        ColorCurve( COLOR_BLUE,          x, &object->r_b[ i ],   &object->g_b[ i ],   &object->b_b[ i ]   );
+        ColorCurve( COLOR_GREY,          x, &object->r_gr[ i ],  &object->g_gr[ i ],  &object->b_gr[ i ]  );
     }
 
     // set default color scheme id
-    object->scheme_id = RGB;
+    object->scheme_id = COLOR_RGB;
 
     // set the color scheme
     rgbtable_set_scheme( object );
@@ -57,6 +57,9 @@ typedef struct rotate
     // pointer to array for temporary sample vector storage
     t_float* temp_vector;
 
+    // memory size of the temporary sample vector
+    t_int memory_size;
+
 } t_rotate;
 
 
@@ -166,8 +169,15 @@ static void rotate_dsp( t_rotate* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_float memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate a temporary signal vector for rotating the signal data
-    object->temp_vector = realloc( object->temp_vector, memory_size );
+    // only reallocate memory when the vector size has changed
+    if( memory_size != object->memory_size )
+    {
+        // allocate a temporary signal vector for rotating the signal data
+        object->temp_vector = realloc( object->temp_vector, memory_size );
+
+        // save memory size for dsp change detection
+        object->memory_size = memory_size;
+    }
 
     // dsp_add arguments
     //--------------------------------------------------------------------------
@@ -190,8 +200,15 @@ static void rotate_arg_dsp( t_rotate* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_float memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate a temporary signal vector for rotating the signal data
-    object->temp_vector = realloc( object->temp_vector, memory_size );
+    // only reallocate memory when the vector size has changed
+    if( memory_size != object->memory_size )
+    {
+        // allocate a temporary signal vector for rotating the signal data
+        object->temp_vector = realloc( object->temp_vector, memory_size );
+
+        // save memory size for dsp change detection
+        object->memory_size = memory_size;
+    }
 
     // dsp_add arguments
     //--------------------------------------------------------------------------
@@ -0,0 +1,225 @@
+//------------------------------------------------------------------------------
+//  Pd Spectral Toolkit
+//
+//  spectprof.c
+//
+//  Reports the toolkit objects using the most dsp time
+//  ( requires a build with PROFILE=-DSPECTRAL_PROFILE )
+//
+//  Copyright (C) 2019 Cooper Baker. All Rights Reserved.
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// headers
+//------------------------------------------------------------------------------
+
+// main header for pd
+#include "m_pd.h"
+
+// utility header for Pd Spectral Toolkit project
+#include "utility.h"
+
+// standard headers
+#include <stdlib.h>
+
+// disable compiler warnings on windows
+#ifdef NT
+#pragma warning( disable : 4244 )
+#pragma warning( disable : 4305 )
+#endif
+
+
+//------------------------------------------------------------------------------
+// constant definitions
+//------------------------------------------------------------------------------
+#define DEFAULT_TOP_COUNT 10
+
+
+//------------------------------------------------------------------------------
+// spectprof_class - pointer to this object's definition
+//------------------------------------------------------------------------------
+static t_class* spectprof_class;
+
+
+//------------------------------------------------------------------------------
+// spectprof - data structure holding this object's data
+//------------------------------------------------------------------------------
+typedef struct spectprof
+{
+    // this object - must always be first variable in struct
+    t_object object;
+
+    // number of instances to report
+    t_float top_count;
+
+    // pointer to the outlet
+    t_outlet* outlet;
+
+} t_spectprof;
+
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+static void  spectprof_bang  ( t_spectprof* object );
+static void  spectprof_reset ( t_spectprof* object );
+static void  spectprof_top   ( t_spectprof* object, t_floatarg count );
+static void* spectprof_new   ( t_floatarg count );
+void         spectprof_setup ( void );
+
+
+#ifdef SPECTRAL_PROFILE
+//------------------------------------------------------------------------------
+// spectprof_compare - qsort comparison placing the largest total time first
+//------------------------------------------------------------------------------
+static int spectprof_compare( const void* a, const void* b )
+{
+    const t_profile* profile_a = *( const t_profile** )a;
+    const t_profile* profile_b = *( const t_profile** )b;
+
+    return ( profile_a->total < profile_b->total ) - ( profile_a->total > profile_b->total );
+}
+#endif
+
+
+//------------------------------------------------------------------------------
+// spectprof_bang - posts and outputs the hottest instances
+//------------------------------------------------------------------------------
+// each reported instance is output as a list:
+// rank name calls mean max p99 ( times per block in PROFILE_UNITS )
+//------------------------------------------------------------------------------
+static void spectprof_bang( t_spectprof* object )
+{
+#ifdef SPECTRAL_PROFILE
+    t_profile*  profile;
+    t_profile** sorted;
+    t_atom      list[ 6 ];
+    t_int       count = 0;
+    t_int       top   = ( t_int )object->top_count;
+    t_int       n;
+
+    for( profile = ProfileFirst() ; profile ; profile = profile->next )
+    {
+        ++count;
+    }
+
+    if( !count )
+    {
+        post( "spectprof: no profiled objects" );
+        return;
+    }
+
+    sorted = ( t_profile** )malloc( count * sizeof( t_profile* ) );
+
+    for( n = 0, profile = ProfileFirst() ; profile ; profile = profile->next )
+    {
+        sorted[ n++ ] = profile;
+    }
+
+    qsort( sorted, count, sizeof( t_profile* ), spectprof_compare );
+
+    if( top <= 0 || top > count )
+    {
+        top = count;
+    }
+
+    post( "spectprof: top %d of %d objects ( %s per block )", ( int )top, ( int )count, PROFILE_UNITS );
+    post( "spectprof: rank object           instance        calls       mean        max        p99" );
+
+    for( n = 0 ; n < top ; ++n )
+    {
+        double mean = sorted[ n ]->calls ? ( double )sorted[ n ]->total / sorted[ n ]->calls : 0;
+        double p99  = ( double )ProfilePercentile( sorted[ n ], 0.99 );
+
+        post( "spectprof: %4d %-16s %-12p %8llu %10.0f %10llu %10.0f",
+            ( int )( n + 1 ),
+            sorted[ n ]->name,
+            sorted[ n ]->owner,
+            sorted[ n ]->calls,
+            mean,
+            sorted[ n ]->max,
+            p99 );
+
+        SETFLOAT ( &list[ 0 ], n + 1 );
+        SETSYMBOL( &list[ 1 ], gensym( sorted[ n ]->name ) );
+        SETFLOAT ( &list[ 2 ], sorted[ n ]->calls );
+        SETFLOAT ( &list[ 3 ], mean );
+        SETFLOAT ( &list[ 4 ], sorted[ n ]->max );
+        SETFLOAT ( &list[ 5 ], p99 );
+
+        outlet_list( object->outlet, gensym( "list" ), 6, list );
+    }
+
+    free( sorted );
+#else
+    pd_error( object, "spectprof: dsp profiling is not compiled in ( build with PROFILE=-DSPECTRAL_PROFILE )" );
+#endif
+}
+
+
+//------------------------------------------------------------------------------
+// spectprof_reset - clears the statistics of every profiled instance
+//------------------------------------------------------------------------------
+static void spectprof_reset( t_spectprof* object )
+{
+#ifdef SPECTRAL_PROFILE
+    t_profile* profile;
+
+    for( profile = ProfileFirst() ; profile ; profile = profile->next )
+    {
+        ProfileReset( profile );
+    }
+#endif
+}
+
+
+//------------------------------------------------------------------------------
+// spectprof_top - sets the number of instances to report ( 0 reports all )
+//------------------------------------------------------------------------------
+static void spectprof_top( t_spectprof* object, t_floatarg count )
+{
+    object->top_count = count < 0 ? 0 : count;
+}
+
+
+//------------------------------------------------------------------------------
+// spectprof_new - instantiates a copy of this object in pd
+//------------------------------------------------------------------------------
+static void* spectprof_new( t_floatarg count )
+{
+    // create a pointer to this object
+    t_spectprof* object = ( t_spectprof* )pd_new( spectprof_class );
+
+    // create a list outlet for this object
+    object->outlet = outlet_new( &object->object, gensym( "list" ) );
+
+    // report the default number of instances unless specified
+    spectprof_top( object, count > 0 ? count : DEFAULT_TOP_COUNT );
+
+    return object;
+}
+
+
+//------------------------------------------------------------------------------
+// spectprof_setup - describes the attributes of this object to pd so it may be properly instantiated
+//------------------------------------------------------------------------------
+void spectprof_setup( void )
+{
+    // creates an instance of this object and describes it to pd
+    spectprof_class = class_new( gensym( "spectprof" ), ( t_newmethod )spectprof_new, 0, sizeof( t_spectprof ), 0, A_DEFFLOAT, 0 );
+
+    // add a bang handler to this class
+    class_addbang( spectprof_class, spectprof_bang );
+
+    // installs spectprof_reset to respond to "reset" message
+    class_addmethod( spectprof_class, ( t_method )spectprof_reset, gensym( "reset" ), 0 );
+
+    // installs spectprof_top to respond to "top" message
+    class_addmethod( spectprof_class, ( t_method )spectprof_top, gensym( "top" ), A_FLOAT, 0 );
+}
+
+
+//------------------------------------------------------------------------------
+// EOF
+//------------------------------------------------------------------------------
@@ -0,0 +1,559 @@
+//------------------------------------------------------------------------------
+//  Pd Spectral Toolkit
+//
+//  spectrogram~.c
+//
+//  Keeps a history of magnitude spectra as decibel intensities and publishes
+//  it to an array at a capped rate, or to a color image file
+//
+//  Copyright (C) 2019 Cooper Baker. All Rights Reserved.
+//------------------------------------------------------------------------------
+
+
+//------------------------------------------------------------------------------
+// headers
+//------------------------------------------------------------------------------
+
+// main header for pd
+#include "m_pd.h"
+
+// utility header for Pd Spectral Toolkit project
+#include "utility.h"
+
+// standard headers
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// disable compiler warnings on windows
+#ifdef NT
+#pragma warning( disable : 4244 )
+#pragma warning( disable : 4305 )
+#pragma warning( disable : 4996 )
+#endif
+
+
+//------------------------------------------------------------------------------
+// constant definitions
+//------------------------------------------------------------------------------
+#define DEFAULT_COLUMNS  256
+#define DEFAULT_RANGE    60
+#define DEFAULT_INTERVAL 50
+#define COLOR_STEPS      256
+
+
+//------------------------------------------------------------------------------
+// spectrogram_class - pointer to this object's definition
+//------------------------------------------------------------------------------
+static t_class* spectrogram_class;
+
+
+//------------------------------------------------------------------------------
+// spectrogram - data structure holding this object's data
+//------------------------------------------------------------------------------
+typedef struct spectrogram
+{
+    // this object - must always be first variable in struct
+    t_object object;
+
+    // needed for CLASS_MAINSIGNALIN macro call in spectrogram_tilde_setup
+    t_float inlet_1;
+
+    // name of the array the history is published to
+    t_symbol* array_name;
+
+    // history of intensity columns - a ring of columns, each holding rows values
+    t_float* history;
+
+    // bins in a column ( half the block size ) and columns in the history
+    t_int rows;
+    t_int columns;
+
+    // column the next block is written to
+    t_int write_column;
+
+    // decibel range mapped to intensities from 0 to 1
+    t_float range;
+
+    // overlap factor variable
+    t_float overlap;
+
+    // clock that publishes the history after it has been written
+    t_clock* clock;
+
+    // TRUE while the clock is waiting to fire
+    t_int clock_pending;
+
+    // milliseconds between publishes
+    t_float interval;
+
+    // color scheme lookup of COLOR_STEPS red, green, and blue bytes
+    unsigned char colors[ COLOR_STEPS * 3 ];
+
+    // canvas used to resolve file names
+    t_canvas* canvas;
+
+} t_spectrogram;
+
+
+//------------------------------------------------------------------------------
+// function prototypes
+//------------------------------------------------------------------------------
+static t_int* spectrogram_perform     ( t_int* io );
+static void   spectrogram_dsp         ( t_spectrogram* object, t_signal **sig );
+static void   spectrogram_allocate    ( t_spectrogram* object, t_int rows );
+static void   spectrogram_bang        ( t_spectrogram* object );
+static void   spectrogram_tick        ( t_spectrogram* object );
+static void   spectrogram_set         ( t_spectrogram* object, t_symbol* symbol );
+static void   spectrogram_columns     ( t_spectrogram* object, t_floatarg columns );
+static void   spectrogram_range       ( t_spectrogram* object, t_floatarg range );
+static void   spectrogram_rate        ( t_spectrogram* object, t_floatarg interval );
+static void   spectrogram_overlap     ( t_spectrogram* object, t_floatarg overlap );
+static void   spectrogram_clear       ( t_spectrogram* object );
+static void   spectrogram_color       ( t_spectrogram* object, t_symbol* symbol );
+static void   spectrogram_write       ( t_spectrogram* object, t_symbol* symbol );
+static void*  spectrogram_new         ( t_symbol* selector, t_int items, t_atom* list );
+static void   spectrogram_free        ( t_spectrogram* object );
+void          spectrogram_tilde_setup ( void );
+
+
+//------------------------------------------------------------------------------
+// spectrogram_perform - the signal processing function of this object
+//------------------------------------------------------------------------------
+static t_int* spectrogram_perform( t_int* io )
+{
+    // store variables from dsp input/output array
+    t_float*       in1    = ( t_float*       )( io[ 1 ] );
+    t_int          frames = ( t_int          )( io[ 2 ] );
+    t_spectrogram* object = ( t_spectrogram* )( io[ 3 ] );
+
+    // local copies of the history variables
+    t_int    rows = object->rows;
+    t_float* column;
+
+    // magnitude to amplitude and decibel to intensity coefficients
+    t_float amplitude = object->overlap / frames;
+    t_float scale     = 1.0 / object->range;
+
+    // signal vector iterator variable
+    t_int n = -1;
+
+    // make sure the history matches the block size
+    if( object->history == NULL || rows != frames / 2 )
+    {
+        return &( io[ 4 ] );
+    }
+
+    column = &( object->history[ object->write_column * rows ] );
+
+    // the dsp loop - only decibels are calculated per bin, coloring and
+    // display happen when the history is published
+    while( ++n < rows )
+    {
+        column[ n ] = Clip( FixNan( 1.0 + AToDb( ClipMin( in1[ n ] * amplitude, C_FLOAT_MIN ) ) * scale ), 0, 1 );
+    }
+
+    object->write_column = ( object->write_column + 1 ) % object->columns;
+
+    // schedule publishing on the scheduler side unless already pending
+    if( !object->clock_pending )
+    {
+        object->clock_pending = TRUE;
+        clock_delay( object->clock, object->interval );
+    }
+
+    // return the dsp input/output array address plus one more than its size
+    // to provide a pointer to the next perform function in pd's call list
+    return &( io[ 4 ] );
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_dsp - installs this object's dsp function in pd's callback list
+//------------------------------------------------------------------------------
+static void spectrogram_dsp( t_spectrogram* object, t_signal **sig )
+{
+    // only reallocate the history when the vector size has changed
+    if( object->history == NULL || object->rows != sig[ 0 ]->s_n / 2 )
+    {
+        spectrogram_allocate( object, sig[ 0 ]->s_n / 2 );
+    }
+
+    // dsp_add arguments
+    //--------------------------------------------------------------------------
+    // perform routine
+    // number of passed parameters
+    // inlet 1 sample vector
+    // sample frames to process (vector size)
+    // pointer to this object
+    dsp_add( spectrogram_perform, 3, sig[ 0 ]->s_vec, sig[ 0 ]->s_n, object );
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_allocate - replaces the history with an empty one of rows bins
+//------------------------------------------------------------------------------
+static void spectrogram_allocate( t_spectrogram* object, t_int rows )
+{
+    if( object->history )
+    {
+        free( object->history );
+    }
+
+    object->rows         = rows;
+    object->write_column = 0;
+    object->history      = NULL;
+
+    // the block size is unknown until dsp starts
+    if( rows > 0 )
+    {
+        object->history = ( t_float* )calloc( rows * object->columns, sizeof( t_float ) );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_bang - publishes the history to the array, oldest column first
+//------------------------------------------------------------------------------
+static void spectrogram_bang( t_spectrogram* object )
+{
+    t_garray* array;
+    t_word*   array_data;
+    int       array_size;
+    t_int     size = object->rows * object->columns;
+    t_int     split;
+    t_int     n;
+
+    if( object->history == NULL || object->array_name == NULL )
+    {
+        return;
+    }
+
+    array = ( t_garray* )pd_findbyclass( object->array_name, garray_class );
+
+    if( array == NULL )
+    {
+        pd_error( object, "spectrogram~: %s: no such array", object->array_name->s_name );
+        return;
+    }
+
+    if( garray_getfloatwords( array, &array_size, &array_data ) == 0 )
+    {
+        pd_error( object, "spectrogram~: %s: bad template for spectrogram~", object->array_name->s_name );
+        return;
+    }
+
+    // fit the array to the history
+    if( array_size != size )
+    {
+        garray_resize_long( array, size );
+        garray_getfloatwords( array, &array_size, &array_data );
+    }
+
+    // the oldest column is the one written next
+    split = object->write_column * object->rows;
+
+    for( n = split ; n < size ; ++n )
+    {
+        array_data[ n - split ].w_float = object->history[ n ];
+    }
+
+    for( n = 0 ; n < split ; ++n )
+    {
+        array_data[ n + size - split ].w_float = object->history[ n ];
+    }
+
+    garray_redraw( array );
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_tick - publishes the history after the perform routine has written it
+//------------------------------------------------------------------------------
+static void spectrogram_tick( t_spectrogram* object )
+{
+    object->clock_pending = FALSE;
+
+    spectrogram_bang( object );
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_set - sets the array the history is published to
+//------------------------------------------------------------------------------
+static void spectrogram_set( t_spectrogram* object, t_symbol* symbol )
+{
+    object->array_name = symbol;
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_columns - sets the number of columns in the history ( clears it )
+//------------------------------------------------------------------------------
+static void spectrogram_columns( t_spectrogram* object, t_floatarg columns )
+{
+    object->columns = ClipMin( columns, 1 );
+
+    spectrogram_allocate( object, object->rows );
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_range - sets the decibel range shown below full scale
+//------------------------------------------------------------------------------
+static void spectrogram_range( t_spectrogram* object, t_floatarg range )
+{
+    object->range = ClipMin( range, 1 );
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_rate - sets the minimum time between publishes
+//------------------------------------------------------------------------------
+static void spectrogram_rate( t_spectrogram* object, t_floatarg interval )
+{
+    object->interval = Clip( interval, 0, 10000 );
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_overlap - sets the overlap factor for use in dsp calculations
+//------------------------------------------------------------------------------
+static void spectrogram_overlap( t_spectrogram* object, t_floatarg overlap )
+{
+    object->overlap = ClipMin( overlap, 1 );
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_clear - zeroes the history
+//------------------------------------------------------------------------------
+static void spectrogram_clear( t_spectrogram* object )
+{
+    if( object->history )
+    {
+        memset( object->history, 0, object->rows * object->columns * sizeof( t_float ) );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_color - sets the color scheme used for image files
+//------------------------------------------------------------------------------
+static void spectrogram_color( t_spectrogram* object, t_symbol* symbol )
+{
+    t_int   scheme = ColorSchemeId( symbol->s_name );
+    t_float r;
+    t_float g;
+    t_float b;
+    t_int   step;
+
+    if( scheme < 0 )
+    {
+        pd_error( object, "spectrogram~: %s: unknown color scheme name", symbol->s_name );
+        return;
+    }
+
+    // tabulate the scheme once so writing an image is a lookup per pixel
+    for( step = 0 ; step < COLOR_STEPS ; ++step )
+    {
+        ColorCurve( scheme, ( t_float )step / ( COLOR_STEPS - 1 ), &r, &g, &b );
+
+        object->colors[ step * 3 + 0 ] = Clip( r, 0, 1 ) * 255 + 0.5;
+        object->colors[ step * 3 + 1 ] = Clip( g, 0, 1 ) * 255 + 0.5;
+        object->colors[ step * 3 + 2 ] = Clip( b, 0, 1 ) * 255 + 0.5;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_write - writes the history as a binary ppm image, newest column
+// on the right and highest bin on top
+//------------------------------------------------------------------------------
+static void spectrogram_write( t_spectrogram* object, t_symbol* symbol )
+{
+    char           path[ MAXPDSTRING ];
+    FILE*          file;
+    unsigned char* line;
+    unsigned char* color;
+    t_int          row;
+    t_int          column;
+    t_int          step;
+
+    if( object->history == NULL )
+    {
+        pd_error( object, "spectrogram~: no history to write" );
+        return;
+    }
+
+    canvas_makefilename( object->canvas, symbol->s_name, path, MAXPDSTRING );
+    sys_bashfilename( path, path );
+
+    file = fopen( path, "wb" );
+
+    if( file == NULL )
+    {
+        pd_error( object, "spectrogram~: %s: could not write file", path );
+        return;
+    }
+
+    line = ( unsigned char* )malloc( object->columns * 3 );
+
+    fprintf( file, "P6\n%d %d\n255\n", ( int )object->columns, ( int )object->rows );
+
+    for( row = object->rows - 1 ; row >= 0 ; --row )
+    {
+        for( column = 0 ; column < object->columns ; ++column )
+        {
+            step  = object->history[ ( ( object->write_column + column ) % object->columns ) * object->rows + row ] * ( COLOR_STEPS - 1 );
+            color = &( object->colors[ step * 3 ] );
+
+            line[ column * 3 + 0 ] = color[ 0 ];
+            line[ column * 3 + 1 ] = color[ 1 ];
+            line[ column * 3 + 2 ] = color[ 2 ];
+        }
+
+        fwrite( line, 3, object->columns, file );
+    }
+
+    free( line );
+    fclose( file );
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_new - instantiates a copy of this object in pd
+//------------------------------------------------------------------------------
+static void* spectrogram_new( t_symbol* selector, t_int items, t_atom* list )
+{
+    // create a pointer to this object
+    t_spectrogram* object = ( t_spectrogram* )pd_new( spectrogram_class );
+
+    // create a float inlet to receive overlap factor value
+    floatinlet_new( &object->object, &object->overlap );
+
+    // initialize variables
+    object->inlet_1       = 0;
+    object->array_name    = NULL;
+    object->history       = NULL;
+    object->rows          = 0;
+    object->columns       = DEFAULT_COLUMNS;
+    object->write_column  = 0;
+    object->range         = DEFAULT_RANGE;
+    object->overlap       = 1;
+    object->interval      = DEFAULT_INTERVAL;
+    object->clock         = clock_new( object, ( t_method )spectrogram_tick );
+    object->clock_pending = FALSE;
+    object->canvas        = canvas_getcurrent();
+
+    // images default to the rgbtable default scheme
+    spectrogram_color( object, gensym( "rgb" ) );
+
+    // parse initialization arguments
+    //--------------------------------------------------------------------------
+    if( items > 0 )
+    {
+        if( list[ 0 ].a_type == A_SYMBOL )
+        {
+            object->array_name = list[ 0 ].a_w.w_symbol;
+        }
+        else
+        {
+            pd_error( object, "spectrogram~: invalid argument 1 type" );
+        }
+    }
+
+    if( items > 1 )
+    {
+        if( list[ 1 ].a_type == A_FLOAT )
+        {
+            object->columns = ClipMin( atom_getfloatarg( 1, ( int )items, list ), 1 );
+        }
+        else
+        {
+            pd_error( object, "spectrogram~: invalid argument 2 type" );
+        }
+    }
+
+    if( items > 2 )
+    {
+        if( list[ 2 ].a_type == A_SYMBOL )
+        {
+            spectrogram_color( object, list[ 2 ].a_w.w_symbol );
+        }
+        else
+        {
+            pd_error( object, "spectrogram~: invalid argument 3 type" );
+        }
+    }
+
+    if( items > 3 )
+    {
+        pd_error( object, "spectrogram~: extra arguments ignored" );
+    }
+
+    return object;
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_free - cleans up memory allocated by this object
+//------------------------------------------------------------------------------
+static void spectrogram_free( t_spectrogram* object )
+{
+    clock_free( object->clock );
+
+    if( object->history )
+    {
+        free( object->history );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// spectrogram_tilde_setup - describes the attributes of this object to pd so it may be properly instantiated
+// (must always be named with _tilde replacing ~ in the object name)
+//------------------------------------------------------------------------------
+void spectrogram_tilde_setup( void )
+{
+    // creates an instance of this object and describes it to pd
+    spectrogram_class = class_new( gensym( "spectrogram~" ), ( t_newmethod )spectrogram_new, ( t_method )spectrogram_free, sizeof( t_spectrogram ), 0, A_GIMME, 0 );
+
+    // declares leftmost inlet as a signal inlet
+    CLASS_MAINSIGNALIN( spectrogram_class, t_spectrogram, inlet_1 );
+
+    // installs spectrogram_dsp so that it will be called when dsp is turned on
+    class_addmethod( spectrogram_class, ( t_method )spectrogram_dsp, gensym( "dsp" ), 0 );
+
+    // installs spectrogram_bang to publish the history on demand
+    class_addbang( spectrogram_class, spectrogram_bang );
+
+    // installs spectrogram_set to respond to "set ___" messages
+    class_addmethod( spectrogram_class, ( t_method )spectrogram_set, gensym( "set" ), A_SYMBOL, 0 );
+
+    // installs spectrogram_columns to respond to "columns #" messages
+    class_addmethod( spectrogram_class, ( t_method )spectrogram_columns, gensym( "columns" ), A_FLOAT, 0 );
+
+    // installs spectrogram_range to respond to "range #" messages
+    class_addmethod( spectrogram_class, ( t_method )spectrogram_range, gensym( "range" ), A_FLOAT, 0 );
+
+    // installs spectrogram_rate to respond to "rate #" messages
+    class_addmethod( spectrogram_class, ( t_method )spectrogram_rate, gensym( "rate" ), A_FLOAT, 0 );
+
+    // installs spectrogram_overlap to respond to "overlap #" messages
+    class_addmethod( spectrogram_class, ( t_method )spectrogram_overlap, gensym( "overlap" ), A_FLOAT, 0 );
+
+    // installs spectrogram_clear to respond to "clear" messages
+    class_addmethod( spectrogram_class, ( t_method )spectrogram_clear, gensym( "clear" ), 0 );
+
+    // installs spectrogram_color to respond to "color ___" messages
+    class_addmethod( spectrogram_class, ( t_method )spectrogram_color, gensym( "color" ), A_SYMBOL, 0 );
+
+    // installs spectrogram_write to respond to "write ___" messages
+    class_addmethod( spectrogram_class, ( t_method )spectrogram_write, gensym( "write" ), A_SYMBOL, 0 );
+}
+
+
+//------------------------------------------------------------------------------
+// EOF
+//------------------------------------------------------------------------------
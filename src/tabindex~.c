@@ -63,6 +63,20 @@ typedef struct tabindex
     // flag to store state of buffer clearing option
     t_int clear_flag;
 
+    // lowest and highest array indices written since the last clear
+    // ( nothing is dirty when dirty_min is above dirty_max )
+    t_int dirty_min;
+    t_int dirty_max;
+
+    // clock that redraws the array after it has been written
+    t_clock* clock;
+
+    // TRUE while the clock is waiting to fire
+    t_int clock_pending;
+
+    // milliseconds between redraws ( 0 turns redrawing off )
+    t_float interval;
+
 } t_tabindex;
 
 
@@ -75,7 +89,10 @@ static void   tabindex_set_array   ( t_tabindex* object );
 static void   tabindex_bang        ( t_tabindex* object );
 static void   tabindex_set         ( t_tabindex* object, t_symbol* symbol );
 static void   tabindex_clear       ( t_tabindex* object, t_floatarg clear_state );
+static void   tabindex_redraw      ( t_tabindex* object, t_floatarg interval );
+static void   tabindex_tick        ( t_tabindex* object );
 static void*  tabindex_new         ( t_symbol* selector, t_int itmes, t_atom* list );
+static void   tabindex_free        ( t_tabindex* object );
 void          tabindex_tilde_setup ( void );
 
 
@@ -92,35 +109,79 @@ static t_int* tabindex_perform( t_int* io )
 
     // make local copies of array variables
     t_word* array_data = object->array_data;
-    t_float array_size = object->array_size;
+    t_int   array_size = object->array_size;
+
+    // range of indices written this block
+    t_int dirty_min = array_size;
+    t_int dirty_max = -1;
+
+    // first index of a contiguous ramp of indices
+    t_int ramp;
+
+    // temporary array index variable
+    t_int index;
+
+    // signal vector iterator variable
+    t_int n = -1;
 
     // make sure array is valid
     if( ( array_data != NULL ) && array_size )
     {
         // see if memory should be cleared before writing
-        if( object->clear_flag )
+        if( object->clear_flag && object->dirty_min <= object->dirty_max && object->dirty_max < array_size )
         {
-            // clear array memory
-            memset( array_data, 0, array_size * sizeof( t_word ) );
+            // clear only the array memory written since the last clear
+            memset( &( array_data[ object->dirty_min ] ), 0, ( object->dirty_max - object->dirty_min + 1 ) * sizeof( t_word ) );
         }
 
-        // temporary array index variable
-        t_int index;
+        // index ramps that fit the array ( such as binindex~ output ) are
+        // written without clipping until the first index off the ramp
+        if( ( in2[ 0 ] >= 0 ) && ( in2[ 0 ] + frames <= array_size ) )
+        {
+            ramp = in2[ 0 ];
+
+            while( ( ++n < frames ) && ( in2[ n ] == ramp + n ) )
+            {
+                array_data[ ramp + n ].w_float = in1[ n ];
+            }
+
+            if( n > 0 )
+            {
+                dirty_min = ramp;
+                dirty_max = ramp + n - 1;
+            }
 
-        // signal vector iterator variable
-        t_int n = -1;
+            --n;
+        }
 
         // the dsp loop
         while( ++n < frames )
         {
             // constrain index to bounds of array
-            index = Clip( in2[ n ], 0, array_size );
+            index = Clip( in2[ n ], 0, array_size - 1 );
 
             // write data into array
             array_data[ index ].w_float = in1[ n ];
+
+            // track the written range
+            dirty_min = index < dirty_min ? index : dirty_min;
+            dirty_max = index > dirty_max ? index : dirty_max;
         }
-    }
 
+        // remember what to clear next block
+        if( object->clear_flag )
+        {
+            object->dirty_min = dirty_min;
+            object->dirty_max = dirty_max;
+        }
+
+        // schedule a redraw on the scheduler side unless already pending
+        if( ( object->interval > 0 ) && !object->clock_pending )
+        {
+            object->clock_pending = TRUE;
+            clock_delay( object->clock, object->interval );
+        }
+    }
 
     // return the dsp input/output array address plus one more than its size
     // to provide a pointer to the next perform function in pd's call list
@@ -188,6 +249,10 @@ static void tabindex_set_array( t_tabindex* object )
     }
 
     garray_usedindsp( object->array );
+
+    // the new array may hold anything, so the first clear covers all of it
+    object->dirty_min = 0;
+    object->dirty_max = object->array_size - 1;
 }
 
 
@@ -222,10 +287,37 @@ static void tabindex_clear( t_tabindex* object, t_floatarg clear_state )
 {
     t_int clear_flag = Clip( clear_state, 0, 1 );
 
+    // turning clearing on clears the whole array first
+    if( clear_flag && !object->clear_flag )
+    {
+        object->dirty_min = 0;
+        object->dirty_max = object->array_size - 1;
+    }
+
     object->clear_flag = clear_flag;
 }
 
 
+//------------------------------------------------------------------------------
+// tabindex_redraw - sets the minimum time between array redraws
+//------------------------------------------------------------------------------
+static void tabindex_redraw( t_tabindex* object, t_floatarg interval )
+{
+    object->interval = Clip( interval, 0, 10000 );
+}
+
+
+//------------------------------------------------------------------------------
+// tabindex_tick - redraws the array after the perform routine has written it
+//------------------------------------------------------------------------------
+static void tabindex_tick( t_tabindex* object )
+{
+    object->clock_pending = FALSE;
+
+    tabindex_bang( object );
+}
+
+
 //------------------------------------------------------------------------------
 // tabindex_new - instantiates a copy of this object in pd
 //------------------------------------------------------------------------------
@@ -245,6 +337,13 @@ static void* tabindex_new( t_symbol* selector, t_int items, t_atom* list )
     object->array_name = NULL;
     object->array_size = 0;
     object->clear_flag = 0;
+    object->dirty_min  = 0;
+    object->dirty_max  = -1;
+    object->interval   = 0;
+
+    // create a clock to redraw the array
+    object->clock         = clock_new( object, ( t_method )tabindex_tick );
+    object->clock_pending = FALSE;
 
     const char* clear_arg;
 
@@ -293,6 +392,15 @@ static void* tabindex_new( t_symbol* selector, t_int items, t_atom* list )
 }
 
 
+//------------------------------------------------------------------------------
+// tabindex_free - frees this object's clock
+//------------------------------------------------------------------------------
+static void tabindex_free( t_tabindex* object )
+{
+    clock_free( object->clock );
+}
+
+
 //------------------------------------------------------------------------------
 // tabindex_tilde_setup - describes the attributes of this object to pd so it may be properly instantiated
 // (must always be named with _tilde replacing ~ in the object name)
@@ -303,7 +411,7 @@ void tabindex_tilde_setup( void )
     //--------------------------------------------------------------------------
 
     // creates an instance of this object and describes it to pd
-    tabindex_class = class_new( gensym( "tabindex~" ), ( t_newmethod )tabindex_new, 0, sizeof( t_tabindex ), 0, A_GIMME, 0 );
+    tabindex_class = class_new( gensym( "tabindex~" ), ( t_newmethod )tabindex_new, ( t_method )tabindex_free, sizeof( t_tabindex ), 0, A_GIMME, 0 );
 
     // declares leftmost inlet as a signal inlet
     CLASS_MAINSIGNALIN( tabindex_class, t_tabindex, inlet_1 );
@@ -317,6 +425,9 @@ void tabindex_tilde_setup( void )
     // installs tabindex_clear to respond to "clear #" messages
     class_addmethod( tabindex_class, ( t_method )tabindex_clear, gensym( "clear" ), A_FLOAT, 0 );
 
+    // installs tabindex_redraw to respond to "redraw #" messages
+    class_addmethod( tabindex_class, ( t_method )tabindex_redraw, gensym( "redraw" ), A_FLOAT, 0 );
+
     // add bang handler
     class_addbang( tabindex_class, tabindex_bang );
 }
@@ -16,12 +16,34 @@
 //------------------------------------------------------------------------------
 #include "m_pd.h"
 #include "stdio.h"
+#include "stdlib.h"
 #include "string.h"
 
 // utility header for Pd Spectral Toolkit project
 #include "utility.h"
 
-#define STRING_MAX 65535
+// process and thread headers for running commands in the background
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#define STRING_MAX                 65535
+#define COMMAND_MAX                1024
+#define LINE_QUEUE_SIZE            256
+#define LINE_QUEUE_MASK            ( LINE_QUEUE_SIZE - 1 )
+#define POLL_INTERVAL_MILLISECONDS 10.0
+
+// most descriptors the shell closes before running the command
+#define DESCRIPTOR_MAX             65536
+
+// how each line of output leaves the object
+#define OUTPUT_MODE_LINE  0
+#define OUTPUT_MODE_LIST  1
+#define OUTPUT_MODE_ARRAY 2
 
 
 //------------------------------------------------------------------------------
@@ -41,8 +63,52 @@ typedef struct terminal
     // pointer to the outlet
     t_outlet* outlet;
 
+    // pointer to the exit status outlet
+    t_outlet* status_outlet;
+
     // character string to hold a terminal command
-    char* terminal_command[ 1024 ];
+    char terminal_command[ COMMAND_MAX ];
+
+    // worker thread reading the command's output
+    pthread_t thread;
+
+    // process id of the shell running the command
+    pid_t pid;
+
+    // read end of the pipe from the shell's output
+    int pipe_read;
+
+    // TRUE from bang until the exit status has been output
+    t_int running;
+
+    // set by the worker thread once the shell has exited
+    int done;
+
+    // set under the lock as the worker reaps the shell, after which its
+    // process group id may belong to another process
+    pthread_mutex_t reap_lock;
+    t_int           reaped;
+
+    // the shell's exit status ( negative signal number if it was killed )
+    int exit_status;
+
+    // output lines queued by the worker thread for output by the clock
+    char* lines[ LINE_QUEUE_SIZE ];
+    int   line_write;
+    int   line_read;
+
+    // clock that polls the line queue on the scheduler side
+    t_clock* clock;
+
+    // one of the OUTPUT_MODE definitions above
+    t_int output_mode;
+
+    // parses lines into atoms in list mode
+    t_binbuf* binbuf;
+
+    // array receiving character codes in array mode, and the next index to write
+    t_symbol* array_name;
+    t_int     array_index;
 
 } t_terminal;
 
@@ -50,11 +116,22 @@ typedef struct terminal
 //------------------------------------------------------------------------------
 // function prototypes
 //------------------------------------------------------------------------------
-char* terminal_itoa  ( t_int number );
-void  terminal_parse ( t_terminal* object, t_symbol* selector, t_int items, t_atom* list );
-void  terminal_bang  ( t_terminal* object );
-void* terminal_new   ( void );
-void  terminal_setup ( void );
+char*        terminal_itoa    ( t_int number );
+static void  terminal_append  ( t_terminal* object, const char* text );
+static t_int terminal_enqueue ( t_terminal* object, char* line );
+static char* terminal_dequeue ( t_terminal* object );
+static void* terminal_worker  ( void* pointer );
+static void  terminal_output  ( t_terminal* object, char* line );
+static void  terminal_finish  ( t_terminal* object );
+static void  terminal_tick    ( t_terminal* object );
+static void  terminal_signal  ( t_terminal* object, int signal_number );
+void         terminal_parse   ( t_terminal* object, t_symbol* selector, t_int items, t_atom* list );
+void         terminal_kill    ( t_terminal* object, t_symbol* selector, t_int items, t_atom* list );
+void         terminal_mode    ( t_terminal* object, t_symbol* mode, t_symbol* array_name );
+void         terminal_bang    ( t_terminal* object );
+void*        terminal_new     ( void );
+static void  terminal_free    ( t_terminal* object );
+void         terminal_setup   ( void );
 
 
 //------------------------------------------------------------------------------
@@ -107,37 +184,425 @@ char* terminal_itoa( t_int number )
 
 
 //------------------------------------------------------------------------------
-// terminal_bang - causes status list output
+// terminal_append - appends text to the command, truncating at COMMAND_MAX
 //------------------------------------------------------------------------------
-void terminal_bang( t_terminal* object )
+static void terminal_append( t_terminal* object, const char* text )
+{
+    size_t length = strlen( object->terminal_command );
+    size_t count  = strlen( text );
+
+    if( count > COMMAND_MAX - 1 - length )
+    {
+        count = COMMAND_MAX - 1 - length;
+    }
+
+    memcpy( object->terminal_command + length, text, count );
+
+    object->terminal_command[ length + count ] = 0;
+}
+
+
+//------------------------------------------------------------------------------
+// terminal_enqueue - hands a line from the worker thread to the clock
+// ( single producer, single consumer - returns FALSE when the queue is full )
+//------------------------------------------------------------------------------
+static t_int terminal_enqueue( t_terminal* object, char* line )
+{
+    int write_index = object->line_write;
+
+    if( ( ( write_index + 1 ) & LINE_QUEUE_MASK ) == __atomic_load_n( &object->line_read, __ATOMIC_ACQUIRE ) )
+    {
+        return FALSE;
+    }
+
+    object->lines[ write_index ] = line;
+
+    __atomic_store_n( &object->line_write, ( write_index + 1 ) & LINE_QUEUE_MASK, __ATOMIC_RELEASE );
+
+    return TRUE;
+}
+
+
+//------------------------------------------------------------------------------
+// terminal_dequeue - takes the oldest queued line, or NULL when empty
+//------------------------------------------------------------------------------
+static char* terminal_dequeue( t_terminal* object )
+{
+    int   read_index = object->line_read;
+    char* line;
+
+    if( read_index == __atomic_load_n( &object->line_write, __ATOMIC_ACQUIRE ) )
+    {
+        return NULL;
+    }
+
+    line = object->lines[ read_index ];
+
+    __atomic_store_n( &object->line_read, ( read_index + 1 ) & LINE_QUEUE_MASK, __ATOMIC_RELEASE );
+
+    return line;
+}
+
+
+//------------------------------------------------------------------------------
+// terminal_worker - reads the shell's output on a background thread
+//------------------------------------------------------------------------------
+static void* terminal_worker( void* pointer )
 {
-    // location of null terminator in each output string
-    t_int null_terminator;
+    t_terminal* object = ( t_terminal* )pointer;
 
     // an os FILE pointer for the pipe
-    FILE* terminal_pipe;
+    FILE* terminal_pipe = fdopen( object->pipe_read, "r" );
 
     // string to hold what comes out of the pipe
     char output[ STRING_MAX ];
 
-    // open a "read" pipe and send it the object's command
-    terminal_pipe = popen( ( char* )object->terminal_command, "r" );
+    // the shell's exit information and wait status
+    siginfo_t exited;
+    int       status = 0;
 
     // move through the output to its end
-    while( fgets( output, STRING_MAX, terminal_pipe ) != NULL )
+    while( terminal_pipe && fgets( output, STRING_MAX, terminal_pipe ) != NULL )
     {
-        // find the null terminator location
-        null_terminator = strchr( output, '\n' ) - output;
+        // remove the trailing newline
+        output[ strcspn( output, "\n" ) ] = 0;
 
-        // remove the null terminator
-        output[ null_terminator ] = 0;
+        char* line = strdup( output );
 
-        // send the output out the object's outlet
-        outlet_anything( object->outlet, gensym( output ), 0, NULL );
+        // wait for the scheduler to catch up rather than dropping output
+        while( line && !terminal_enqueue( object, line ) )
+        {
+            usleep( 1000 );
+        }
     }
 
     // close the pipe
-    pclose( terminal_pipe );
+    if( terminal_pipe )
+    {
+        fclose( terminal_pipe );
+    }
+    else
+    {
+        close( object->pipe_read );
+    }
+
+    // wait for the shell to exit while leaving it unreaped, so its process
+    // group id cannot be reused until kill can no longer signal it
+    while( ( waitid( P_PID, object->pid, &exited, WEXITED | WNOWAIT ) != 0 ) && ( errno == EINTR ) )
+    {
+        continue;
+    }
+
+    // collect the shell's exit status
+    pthread_mutex_lock( &object->reap_lock );
+    object->reaped = TRUE;
+    waitpid( object->pid, &status, 0 );
+    pthread_mutex_unlock( &object->reap_lock );
+
+    if( WIFEXITED( status ) )
+    {
+        object->exit_status = WEXITSTATUS( status );
+    }
+    else if( WIFSIGNALED( status ) )
+    {
+        object->exit_status = -WTERMSIG( status );
+    }
+
+    __atomic_store_n( &object->done, TRUE, __ATOMIC_RELEASE );
+
+    return NULL;
+}
+
+
+//------------------------------------------------------------------------------
+// terminal_output - outputs one line according to the output mode
+//------------------------------------------------------------------------------
+static void terminal_output( t_terminal* object, char* line )
+{
+    t_garray* array;
+    t_word*   array_words;
+    int       array_size;
+    t_atom*   atoms;
+    int       atom_count;
+    t_int     character;
+
+    if( object->output_mode == OUTPUT_MODE_LIST )
+    {
+        // numbers become floats, so only words are added to the symbol table
+        binbuf_text( object->binbuf, line, strlen( line ) );
+
+        atom_count = binbuf_getnatom( object->binbuf );
+        atoms      = binbuf_getvec( object->binbuf );
+
+        if( !atom_count )
+        {
+            return;
+        }
+
+        if( atoms[ 0 ].a_type == A_SYMBOL )
+        {
+            outlet_anything( object->outlet, atoms[ 0 ].a_w.w_symbol, atom_count - 1, atoms + 1 );
+        }
+        else
+        {
+            outlet_list( object->outlet, gensym( "list" ), atom_count, atoms );
+        }
+    }
+    else if( object->output_mode == OUTPUT_MODE_ARRAY )
+    {
+        // the array is looked up every line in case it was deleted or renamed
+        array = ( t_garray* )pd_findbyclass( object->array_name, garray_class );
+
+        if( !array || !garray_getfloatwords( array, &array_size, &array_words ) )
+        {
+            return;
+        }
+
+        // write the line's character codes followed by a newline, dropping what does not fit
+        for( character = 0 ; line[ character ] && object->array_index < array_size ; ++character )
+        {
+            array_words[ object->array_index++ ].w_float = ( unsigned char )line[ character ];
+        }
+
+        if( object->array_index < array_size )
+        {
+            array_words[ object->array_index++ ].w_float = '\n';
+        }
+    }
+    else
+    {
+        // send the output out the object's outlet
+        outlet_anything( object->outlet, gensym( line ), 0, NULL );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// terminal_finish - completes array output once the command has exited
+//------------------------------------------------------------------------------
+static void terminal_finish( t_terminal* object )
+{
+    t_garray* array;
+    t_word*   array_words;
+    int       array_size;
+    t_int     index;
+
+    if( object->output_mode != OUTPUT_MODE_ARRAY )
+    {
+        return;
+    }
+
+    array = ( t_garray* )pd_findbyclass( object->array_name, garray_class );
+
+    if( !array || !garray_getfloatwords( array, &array_size, &array_words ) )
+    {
+        pd_error( object, "terminal: %s: no such array", object->array_name->s_name );
+        return;
+    }
+
+    // clear what is left of the previous output
+    for( index = object->array_index ; index < array_size ; ++index )
+    {
+        array_words[ index ].w_float = 0;
+    }
+
+    garray_redraw( array );
+
+    // output the number of characters written
+    outlet_float( object->outlet, object->array_index );
+}
+
+
+//------------------------------------------------------------------------------
+// terminal_tick - outputs queued lines, then the exit status once finished
+//------------------------------------------------------------------------------
+static void terminal_tick( t_terminal* object )
+{
+    char* line;
+
+    // check for completion before draining so no trailing lines are missed
+    int done = __atomic_load_n( &object->done, __ATOMIC_ACQUIRE );
+
+    while( ( line = terminal_dequeue( object ) ) )
+    {
+        terminal_output( object, line );
+
+        free( line );
+    }
+
+    if( done )
+    {
+        pthread_join( object->thread, NULL );
+
+        object->running = FALSE;
+
+        terminal_finish( object );
+
+        outlet_float( object->status_outlet, object->exit_status );
+    }
+    else
+    {
+        clock_delay( object->clock, POLL_INTERVAL_MILLISECONDS );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// terminal_signal - signals the command's process group until it is reaped
+//------------------------------------------------------------------------------
+static void terminal_signal( t_terminal* object, int signal_number )
+{
+    pthread_mutex_lock( &object->reap_lock );
+
+    if( !object->reaped )
+    {
+        kill( -object->pid, signal_number );
+    }
+
+    pthread_mutex_unlock( &object->reap_lock );
+}
+
+
+//------------------------------------------------------------------------------
+// terminal_bang - runs the command in the background
+//------------------------------------------------------------------------------
+void terminal_bang( t_terminal* object )
+{
+    // pipe file descriptors ( read end, write end )
+    int pipe_ends[ 2 ];
+
+    // descriptor iterator variable and the highest one the shell may inherit
+    int descriptor;
+    int descriptor_max;
+
+    if( object->running )
+    {
+        pd_error( object, "terminal: a command is still running ( send kill to stop it )" );
+        return;
+    }
+
+    if( pipe( pipe_ends ) != 0 )
+    {
+        pd_error( object, "terminal: could not open a pipe" );
+        return;
+    }
+
+    // keep the pipe out of commands other objects start
+    fcntl( pipe_ends[ 0 ], F_SETFD, FD_CLOEXEC );
+    fcntl( pipe_ends[ 1 ], F_SETFD, FD_CLOEXEC );
+
+    // looked up before the fork, leaving the child only async-signal-safe calls
+    descriptor_max = ( int )sysconf( _SC_OPEN_MAX );
+
+    if( ( descriptor_max < 0 ) || ( descriptor_max > DESCRIPTOR_MAX ) )
+    {
+        descriptor_max = DESCRIPTOR_MAX;
+    }
+
+    object->pid = fork();
+
+    if( object->pid < 0 )
+    {
+        pd_error( object, "terminal: could not start a shell" );
+        close( pipe_ends[ 0 ] );
+        close( pipe_ends[ 1 ] );
+        return;
+    }
+
+    if( object->pid == 0 )
+    {
+        // in the child - lead a new process group so kill reaches the whole command
+        setpgid( 0, 0 );
+
+        dup2( pipe_ends[ 1 ], STDOUT_FILENO );
+
+        // dup2 leaves close-on-exec set when the pipe already was stdout
+        fcntl( STDOUT_FILENO, F_SETFD, 0 );
+
+        // the shell inherits only stdin, stdout, and stderr, not pd's files,
+        // sockets, and audio devices
+        for( descriptor = STDERR_FILENO + 1 ; descriptor < descriptor_max ; ++descriptor )
+        {
+            close( descriptor );
+        }
+
+        execl( "/bin/sh", "sh", "-c", object->terminal_command, ( char* )NULL );
+        _exit( 127 );
+    }
+
+    // also set the group from this side so an early kill cannot miss it
+    setpgid( object->pid, object->pid );
+
+    close( pipe_ends[ 1 ] );
+
+    object->pipe_read   = pipe_ends[ 0 ];
+    object->array_index = 0;
+    object->exit_status = 0;
+    object->done        = FALSE;
+    object->reaped      = FALSE;
+    object->running     = TRUE;
+
+    if( pthread_create( &object->thread, NULL, terminal_worker, object ) != 0 )
+    {
+        pd_error( object, "terminal: could not start a worker thread" );
+        kill( -object->pid, SIGKILL );
+        close( object->pipe_read );
+        waitpid( object->pid, NULL, 0 );
+        object->running = FALSE;
+        return;
+    }
+
+    // poll for output on the scheduler side
+    clock_delay( object->clock, 0 );
+}
+
+
+//------------------------------------------------------------------------------
+// terminal_mode - chooses how output lines are sent
+//------------------------------------------------------------------------------
+// line          - each line as one symbol ( adds every distinct line to pd's
+//                 symbol table, which is never freed )
+// list          - each line parsed into floats and symbols
+// array <name>  - character codes written into an array, then the count
+//------------------------------------------------------------------------------
+void terminal_mode( t_terminal* object, t_symbol* mode, t_symbol* array_name )
+{
+    if( mode == gensym( "line" ) )
+    {
+        object->output_mode = OUTPUT_MODE_LINE;
+    }
+    else if( mode == gensym( "list" ) )
+    {
+        object->output_mode = OUTPUT_MODE_LIST;
+    }
+    else if( mode == gensym( "array" ) && *array_name->s_name )
+    {
+        object->output_mode = OUTPUT_MODE_ARRAY;
+        object->array_name  = array_name;
+    }
+    else
+    {
+        pd_error( object, "terminal: mode must be line, list, or array <name>" );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// terminal_kill - stops the running command, or runs "kill ..." as a command
+//------------------------------------------------------------------------------
+void terminal_kill( t_terminal* object, t_symbol* selector, t_int items, t_atom* list )
+{
+    // with arguments this is the shell's own kill command
+    if( items )
+    {
+        terminal_parse( object, selector, items, list );
+        return;
+    }
+
+    if( object->running )
+    {
+        terminal_signal( object, SIGTERM );
+    }
 }
 
 
@@ -150,10 +615,10 @@ void terminal_parse( t_terminal* object, t_symbol* selector, t_int items, t_atom
     t_int item_index = 0;
 
     // clear out the last command
-    memset( object->terminal_command, 0, 1024 * sizeof( char ) );
+    memset( object->terminal_command, 0, COMMAND_MAX * sizeof( char ) );
 
     // copy the first word into the command string
-    strcpy( ( char* )object->terminal_command, selector->s_name );
+    strncpy( object->terminal_command, selector->s_name, COMMAND_MAX - 1 );
 
     // iterate through the input mesage list
     for( item_index = 0 ; item_index < items ; ++item_index )
@@ -162,15 +627,15 @@ void terminal_parse( t_terminal* object, t_symbol* selector, t_int items, t_atom
         if( list[ item_index ].a_type == A_SYMBOL )
         {
             // first add a space then copy the item into the command string
-            strcat( ( char* )object->terminal_command, " " );
-            strcat( ( char* )object->terminal_command, list[ item_index ].a_w.w_symbol->s_name );
+            terminal_append( object, " " );
+            terminal_append( object, list[ item_index ].a_w.w_symbol->s_name );
         }
         // if the list item is a float
         else if( list[ item_index ].a_type == A_FLOAT )
         {
             // first add a space then copy the item into the command string
-            strcat( ( char* )object->terminal_command, " " );
-            strcat( ( char* )object->terminal_command, terminal_itoa( list[ item_index ].a_w.w_float ) );
+            terminal_append( object, " " );
+            terminal_append( object, terminal_itoa( list[ item_index ].a_w.w_float ) );
         }
     }
 
@@ -193,24 +658,82 @@ void* terminal_new( void )
     // create an outlet for anything
     object->outlet = outlet_new( &object->object, gensym( "anything" ) );
 
+    // create an outlet for the exit status
+    object->status_outlet = outlet_new( &object->object, gensym( "float" ) );
+
+    // create a clock to poll for output
+    object->clock = clock_new( object, ( t_method )terminal_tick );
+
+    // output whole lines as symbols until told otherwise
+    object->output_mode = OUTPUT_MODE_LINE;
+    object->binbuf      = binbuf_new();
+
+    // guards signaling the shell against reaping it
+    pthread_mutex_init( &object->reap_lock, NULL );
+    object->reaped = TRUE;
+
     // return the pointer to this class
     return ( void* )object;
 }
 
 
+//------------------------------------------------------------------------------
+// terminal_free - stops any running command and cleans up
+//------------------------------------------------------------------------------
+static void terminal_free( t_terminal* object )
+{
+    char* line;
+
+    if( object->running )
+    {
+        terminal_signal( object, SIGKILL );
+
+        // keep the worker from waiting on a full queue while it finishes
+        while( !__atomic_load_n( &object->done, __ATOMIC_ACQUIRE ) )
+        {
+            while( ( line = terminal_dequeue( object ) ) )
+            {
+                free( line );
+            }
+
+            usleep( 1000 );
+        }
+
+        pthread_join( object->thread, NULL );
+    }
+
+    while( ( line = terminal_dequeue( object ) ) )
+    {
+        free( line );
+    }
+
+    clock_free( object->clock );
+
+    binbuf_free( object->binbuf );
+
+    pthread_mutex_destroy( &object->reap_lock );
+}
+
+
 //------------------------------------------------------------------------------
 // terminal setup - defines this object and its properties to Pd
 //------------------------------------------------------------------------------
 void terminal_setup( void )
 {
     // create a new class and assign its pointer to terminal_class
-    terminal_class = class_new( gensym( "terminal" ), ( t_newmethod )terminal_new, 0, sizeof( t_terminal ), 0, 0 );
+    terminal_class = class_new( gensym( "terminal" ), ( t_newmethod )terminal_new, ( t_method )terminal_free, sizeof( t_terminal ), 0, 0 );
 
     // add message handler, responding to any message
     class_addmethod( terminal_class, ( t_method )terminal_parse, gensym( "anything" ), A_GIMME, 0 );
 
     // add bang handler
     class_addbang( terminal_class, ( t_method )terminal_bang );
+
+    // installs terminal_mode to respond to "mode" message
+    class_addmethod( terminal_class, ( t_method )terminal_mode, gensym( "mode" ), A_DEFSYMBOL, A_DEFSYMBOL, 0 );
+
+    // add kill handler, stopping the running command
+    class_addmethod( terminal_class, ( t_method )terminal_kill, gensym( "kill" ), A_GIMME, 0 );
 }
 
 
@@ -29,6 +29,11 @@
 
 #define MAX_DECIMAL_PLACES 8
 
+// decimal shifts and their nearest float reciprocals, written out because
+// -Ofast computes 1.0 / power with a less accurate reciprocal
+static const t_float decimal_powers[ MAX_DECIMAL_PLACES ] = { 1, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7 };
+static const t_float decimal_recips[ MAX_DECIMAL_PLACES ] = { 1, 1e-1, 1e-2, 1e-3, 1e-4, 1e-5, 1e-6, 1e-7 };
+
 //------------------------------------------------------------------------------
 // trunc_class - pointer to this object's definition
 //------------------------------------------------------------------------------
@@ -96,7 +101,7 @@ static t_int* trunc_perform( t_int* io )
             while( ++n < frames )
             {
                 sample   = in[ n ];
-                sample   = ( int )sample;
+                sample   = Truncate( sample );
                 out[ n ] = sample;
             }
 
@@ -114,16 +119,16 @@ static t_int* trunc_perform( t_int* io )
             break;
         }
 
-        // shift sample value, trunc, unshift sample value
+        // shift sample value, truncate, unshift sample value - samples already
+        // whole once shifted have no digits to truncate, so they pass through
+        // unchanged rather than overflowing the shift, and the rest convert
+        // without Truncate's own range test
         default :
         {
             while( ++n < frames )
             {
-                sample    = in[ n ];
-                sample   *= power;
-                sample    = ( int )sample;
-                sample   *= recip;
-                out[ n ]  = sample;
+                sample   = in[ n ] * power;
+                out[ n ] = Absolute( sample ) < FLOAT_INTEGER_LIMIT ? ( t_float )( t_floatbits )sample * recip : in[ n ];
             }
 
             break;
@@ -158,26 +163,18 @@ static void trunc_dsp( t_trunc* object, t_signal **sig )
 //------------------------------------------------------------------------------
 static void trunc_precision( t_trunc* object, t_floatarg precision )
 {
-    t_int i;
-    t_float power = 10;
-
     // constrain precision
-    precision = Clip( precision, 0, MAX_DECIMAL_PLACES );
+    t_int places = Clip( precision, 0, MAX_DECIMAL_PLACES );
 
-    // precalculate truncing math variables
-    if( ( precision > 0 ) && ( precision < MAX_DECIMAL_PLACES ) )
+    // look up truncing math variables
+    if( ( places > 0 ) && ( places < MAX_DECIMAL_PLACES ) )
     {
-        for( i = 1 ; i < precision ; ++i )
-        {
-            power *= 10;
-        }
-
-        object->power = power;
-        object->recip = 1.0 / power;
+        object->power = decimal_powers[ places ];
+        object->recip = decimal_recips[ places ];
     }
 
     // store precision
-    object->precision = precision;
+    object->precision = places;
 }
 
 
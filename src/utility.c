@@ -31,9 +31,12 @@ extern t_float          ArcTangent              ( t_float number );
 extern t_float          ArcTangent2             ( t_float imaginary, t_float real );
 extern t_float          SquareRoot              ( t_float number );
 extern t_float          Modulo                  ( t_float numerator, t_float denominator );
+extern t_floatbits      FloatBits               ( t_float number );
 extern t_float          FixNan                  ( t_float number );
 extern t_float          FixInf                  ( t_float number );
 extern t_float          FixNanInf               ( t_float number );
+extern t_int            FiniteVector            ( const t_float* vector, t_int frames );
+extern t_int            FiniteCopy              ( const t_float* in, t_float* out, t_int frames );
 extern t_float          DegToRad                ( t_float degrees );
 extern t_float          DegToTurn               ( t_float degrees );
 extern t_float          RadToDeg                ( t_float radians );
@@ -52,6 +55,7 @@ extern t_int            StringMatch             ( const char* string_a, const ch
 extern t_float          Clip                    ( t_float number, t_float bottom, t_float top );
 extern t_float          ClipMin                 ( t_float number, t_float minimum );
 extern t_float          ClipMax                 ( t_float number, t_float maximum );
+extern t_float          Truncate                ( t_float number );
 extern t_float          Round                   ( t_float number );
 extern t_float          Polynomial              ( const t_float *coeff, const t_int n, const t_float x );
 extern t_float          BesselI0                ( t_float number );
@@ -65,6 +69,20 @@ extern void             BubbleSort              ( t_float array[], t_int size );
 extern void             QuickSort               ( t_float* array, t_int beginning, t_int end );
 extern t_float          Lerp                    ( t_float value_a, t_float value_b, t_float fraction );
 extern t_float          Reciprocal              ( t_float number );
+extern t_int            RingWrite               ( t_ring* ring, t_float value );
+extern t_int            RingRead                ( t_ring* ring, t_float* value );
+extern void             FillVector              ( t_float* vector, t_float value, t_int frames );
+extern t_float          FlushDenormal           ( t_float number );
+extern void             FlushDenormals          ( t_float* vector, t_int frames );
+extern void             ControlTick             ( t_control* control );
+extern void             ControlNew              ( t_control* control, t_object* owner, t_int count );
+extern void             ControlFree             ( t_control* control );
+extern void             ControlSet              ( t_control* control, const t_float* values );
+extern void             GateRange               ( t_float* in1, t_float* in2, t_float* out1, t_float* out2, t_float lower, t_float upper, t_int by_index, t_int frames );
+extern t_int            ColorSchemeId           ( const char* name );
+extern void             ColorCurve              ( t_int scheme, t_float x, t_float* r, t_float* g, t_float* b );
+extern t_int            PartialsCount           ( const t_float* list, t_int frames );
+extern t_int            PartialsPack            ( t_float* list, t_int frames, const t_float* mag, const t_float* freq, t_int bins );
 
 
 //------------------------------------------------------------------------------
@@ -21,6 +21,9 @@
 
 #include <float.h>
 
+// opt-in dsp timing for spectprof
+#include "profile.h"
+
 //------------------------------------------------------------------------------
 // definitions
 //------------------------------------------------------------------------------
@@ -40,6 +43,11 @@
 #define C_E            2.7182818284590452353602874713526624977572470936999595749
 #define C_FLOAT_MIN    FLT_MIN
 #define C_FLOAT_MAX    FLT_MAX
+#define RING_SIZE      1024
+#define RING_MASK      ( RING_SIZE - 1 )
+#define CONTROL_VALUES 3
+#define GATE_CHUNK     8
+#define DENORMAL_FLOOR 1e-30
 
 
 //------------------------------------------------------------------------------
@@ -53,6 +61,105 @@ typedef struct T_COMPLEX
 } t_complex;
 
 
+//------------------------------------------------------------------------------
+// color schemes shared by rgbtable and spectrogram~
+//------------------------------------------------------------------------------
+enum COLOR_SCHEME
+{
+    COLOR_RGB,
+    COLOR_PURPLE_YELLOW,
+    COLOR_BLUE_GREEN,
+    COLOR_AMBER,
+    COLOR_RED,
+    COLOR_GREEN,
+    COLOR_BLUE,
+    COLOR_GREY
+};
+
+
+//------------------------------------------------------------------------------
+// integer the size of a t_float, for masking samples bit by bit, the exponent
+// and mantissa fields of a t_float ( exponent all ones is inf or nan ), and the
+// magnitude from which every t_float is a whole number
+//------------------------------------------------------------------------------
+#if defined( PD_FLOATSIZE ) && PD_FLOATSIZE == 64
+typedef long long t_floatbits;
+#define FLOAT_EXPONENT_BITS 0x7ff0000000000000LL
+#define FLOAT_MANTISSA_BITS 0x000fffffffffffffLL
+#define FLOAT_INTEGER_LIMIT 4503599627370496.0
+#else
+typedef int t_floatbits;
+#define FLOAT_EXPONENT_BITS 0x7f800000
+#define FLOAT_MANTISSA_BITS 0x007fffff
+#define FLOAT_INTEGER_LIMIT 8388608.0f
+#endif
+
+
+//------------------------------------------------------------------------------
+// multichannel signals - pd 0.54 and later pass a channel count with each
+// signal and lay the channels out one block after another; older versions
+// see every signal as a single channel
+//------------------------------------------------------------------------------
+#ifdef CLASS_MULTICHANNEL
+#define MULTICHANNEL                     CLASS_MULTICHANNEL
+#define SignalChannels( signal )         ( ( signal )->s_nchans )
+#define SignalSetChannels( sig, count )  signal_setmultiout( ( sig ), ( count ) )
+#else
+#define MULTICHANNEL                     0
+#define SignalChannels( signal )         1
+#define SignalSetChannels( sig, count )
+#endif
+
+
+//------------------------------------------------------------------------------
+// single producer, single consumer queue of floats - the dsp side writes and
+// the scheduler side reads, each index being written by one side only
+//------------------------------------------------------------------------------
+typedef struct T_RING
+{
+    t_float values[ RING_SIZE ];
+
+    volatile t_int write_index;
+    volatile t_int read_index;
+
+} t_ring;
+
+
+//------------------------------------------------------------------------------
+// block constant values mirrored on a control outlet - the dsp side records
+// the values each block and a clock outputs them only when they have changed
+//------------------------------------------------------------------------------
+typedef struct T_CONTROL
+{
+    t_outlet* outlet;
+    t_clock*  clock;
+
+    t_int   count;
+    t_float values[ CONTROL_VALUES ];
+    t_int   valid;
+
+} t_control;
+
+
+//------------------------------------------------------------------------------
+// sparse partial list - a signal vector layout passed from peak pickers to
+// synthesizers, so work downstream follows the number of partials rather than
+// the fft size
+//
+//      [ 0 ]                                   count of partials
+//      [ 1 ... capacity ]                      bin indices
+//      [ 1 + capacity ... 2 * capacity ]       magnitudes
+//      [ 1 + 2 * capacity ... 3 * capacity ]   frequencies
+//
+// each section sits at a fixed offset for a vector size, so a writer fills all
+// three in one pass; samples past the count are zero
+//------------------------------------------------------------------------------
+#define PARTIALS_CAPACITY( frames )           ( ( ( frames ) - 1 ) / 3 )
+#define PARTIALS_BINS( list, frames )         ( ( list ) + 1 )
+#define PARTIALS_MAGS( list, frames )         ( ( list ) + 1 + PARTIALS_CAPACITY( frames ) )
+#define PARTIALS_FREQS( list, frames )        ( ( list ) + 1 + PARTIALS_CAPACITY( frames ) * 2 )
+
+
 //------------------------------------------------------------------------------
 // inlined functions
 //------------------------------------------------------------------------------
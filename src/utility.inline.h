@@ -135,30 +135,90 @@ inline t_float Modulo( t_float numerator, t_float denominator )
 }
 
 
+//------------------------------------------------------------------------------
+// FloatBits - raw bits of a t_float
+//------------------------------------------------------------------------------
+// the nan / inf tests below read exponent bits rather than calling isnan and
+// isinf, which -Ofast ( -ffinite-math-only ) compiles away to constant false
+//------------------------------------------------------------------------------
+inline t_floatbits FloatBits( t_float number )
+{
+    t_floatbits bits;
+
+    memcpy( &bits, &number, sizeof( bits ) );
+
+    return bits;
+}
+
+
 //------------------------------------------------------------------------------
 // FixNan - returns zero if number is not a number
 //------------------------------------------------------------------------------
 inline t_float FixNan( t_float number )
 {
-    return ( isnan( number ) ? 0.0f : number );
+    t_floatbits bits = FloatBits( number ) & ( FLOAT_EXPONENT_BITS | FLOAT_MANTISSA_BITS );
+
+    return bits > FLOAT_EXPONENT_BITS ? 0.0f : number;
 }
 
 
 //------------------------------------------------------------------------------
-// FixInf - returns zero if number is infinity
+// FixInf - returns maximum float if number is infinity
 //------------------------------------------------------------------------------
 inline t_float FixInf( t_float number )
 {
-    return isinf( number ) ? ( number > 0 ? FLT_MAX : -FLT_MAX ) : number;
+    t_floatbits bits = FloatBits( number ) & ( FLOAT_EXPONENT_BITS | FLOAT_MANTISSA_BITS );
+
+    return bits == FLOAT_EXPONENT_BITS ? ( number > 0 ? FLT_MAX : -FLT_MAX ) : number;
 }
 
 
 //------------------------------------------------------------------------------
-// FixNanInf - returns zero if number is not a number or infinity
+// FixNanInf - returns zero if number is not a number or maximum float if infinity
 //------------------------------------------------------------------------------
 inline t_float FixNanInf( t_float number )
 {
-    return ( isinf( number ) ? ( number > 0 ? FLT_MAX : -FLT_MAX ) : ( isnan( number ) ? 0.0f : number ) );
+    t_floatbits bits = FloatBits( number ) & ( FLOAT_EXPONENT_BITS | FLOAT_MANTISSA_BITS );
+
+    // the sign is masked off, so anything above the exponent field is nan
+    return bits < FLOAT_EXPONENT_BITS ? number : ( bits == FLOAT_EXPONENT_BITS ? ( number > 0 ? FLT_MAX : -FLT_MAX ) : 0.0f );
+}
+
+
+//------------------------------------------------------------------------------
+// FiniteVector - returns TRUE when no sample of a vector is nan or infinity
+//------------------------------------------------------------------------------
+inline t_int FiniteVector( const t_float* vector, t_int frames )
+{
+    t_floatbits found = 0;
+    t_int       n;
+
+    // or together one flag per sample, a reduction the compiler vectorizes
+    for( n = 0 ; n < frames ; ++n )
+    {
+        found |= ( FloatBits( vector[ n ] ) & FLOAT_EXPONENT_BITS ) == FLOAT_EXPONENT_BITS;
+    }
+
+    return !found;
+}
+
+
+//------------------------------------------------------------------------------
+// FiniteCopy - copies a vector, returning TRUE when no sample is nan or infinity
+//------------------------------------------------------------------------------
+inline t_int FiniteCopy( const t_float* in, t_float* out, t_int frames )
+{
+    t_floatbits found = 0;
+    t_int       n;
+
+    // checking while copying keeps the finite case to one pass
+    for( n = 0 ; n < frames ; ++n )
+    {
+        out[ n ] = in[ n ];
+        found   |= ( FloatBits( in[ n ] ) & FLOAT_EXPONENT_BITS ) == FLOAT_EXPONENT_BITS;
+    }
+
+    return !found;
 }
 
 
@@ -437,11 +497,28 @@ inline t_float ClipMax( t_float number, t_float maximum )
 
 
 //------------------------------------------------------------------------------
-// Round - rounds a number to the nearest integer
+// Truncate - rounds a number toward zero
+//------------------------------------------------------------------------------
+// numbers past FLOAT_INTEGER_LIMIT are already whole, so only smaller ones go
+// through the integer conversion - this keeps the full float range correct and
+// compiles to a packed convert and select rather than a call to truncf
+//------------------------------------------------------------------------------
+inline t_float Truncate( t_float number )
+{
+    return Absolute( number ) < FLOAT_INTEGER_LIMIT ? ( t_float )( t_floatbits )number : number;
+}
+
+
+//------------------------------------------------------------------------------
+// Round - rounds a number to the nearest integer, halves away from zero
 //------------------------------------------------------------------------------
 inline t_float Round( t_float number )
 {
-    return ( number >= 0 ) ? ( int )( number + 0.5 ) : ( int )( number - 0.5 );
+    t_float whole = Truncate( number );
+
+    // the dropped fraction is exact, so testing it avoids adding a half first,
+    // which rounds 0.49999997 up to one
+    return whole + ( Absolute( number - whole ) >= 0.5f ) * ( number < 0 ? -1.0f : 1.0f );
 }
 
 
@@ -468,26 +545,20 @@ inline t_float Polynomial( const t_float *coeff, const t_int n, const t_float x
 //------------------------------------------------------------------------------
 inline t_float BesselI0( t_float number )
 {
-    t_float ax;
-    t_float y;
-    t_float z;
-    t_float i0p [ 14 ];
-    t_float i0q [ 5  ];
-    t_float i0pp[ 5  ];
-    t_float i0qq[ 6  ];
-
-    ax = fabsf( number );
+    // sum of ( ( x / 2 )^k / k! )^2, each term built from the one before
+    t_float y    = number * number * 0.25;
+    t_float term = 1;
+    t_float sum  = 1;
+    t_int   k    = 0;
 
-    if( ax < 15.0 )
-    {
-        y = number * number;
-        return ( Polynomial( i0p, 13, y ) / Polynomial( i0q, 4, 225.0f - y ) );
-    }
-    else
+    while( term > sum * FLT_EPSILON && k < 100 )
     {
-        z = 1.0 - 15.0 / ax;
-        return ( expf( ax ) * Polynomial( i0pp, 4, z ) / ( Polynomial( i0qq, 5, z ) * sqrtf( ax ) ) );
+        ++k;
+        term *= y / ( k * k );
+        sum  += term;
     }
+
+    return sum;
 }
 
 
@@ -705,6 +776,394 @@ inline t_float Reciprocal( t_float number )
 }
 
 
+//------------------------------------------------------------------------------
+// RingWrite - queues a value, returning FALSE ( and dropping it ) when full
+//------------------------------------------------------------------------------
+inline t_int RingWrite( t_ring* ring, t_float value )
+{
+    t_int write_index = ring->write_index;
+
+    if( ( ( write_index + 1 ) & RING_MASK ) == ring->read_index )
+    {
+        return FALSE;
+    }
+
+    ring->values[ write_index ] = value;
+    ring->write_index           = ( write_index + 1 ) & RING_MASK;
+
+    return TRUE;
+}
+
+
+//------------------------------------------------------------------------------
+// RingRead - dequeues the oldest value, returning FALSE when empty
+//------------------------------------------------------------------------------
+inline t_int RingRead( t_ring* ring, t_float* value )
+{
+    t_int read_index = ring->read_index;
+
+    if( read_index == ring->write_index )
+    {
+        return FALSE;
+    }
+
+    *value           = ring->values[ read_index ];
+    ring->read_index = ( read_index + 1 ) & RING_MASK;
+
+    return TRUE;
+}
+
+
+//------------------------------------------------------------------------------
+// FillVector - sets every sample of a signal vector to one value
+//------------------------------------------------------------------------------
+inline void FillVector( t_float* vector, t_float value, t_int frames )
+{
+    t_int n;
+
+    // zero fills are a plain memset
+    if( value == 0 )
+    {
+        memset( vector, 0, frames * sizeof( t_float ) );
+        return;
+    }
+
+    for( n = 0 ; n < frames ; ++n )
+    {
+        vector[ n ] = value;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// FlushDenormal - zeroes a value too small to matter before it goes subnormal
+//------------------------------------------------------------------------------
+// state decaying toward zero across blocks ends up subnormal when the input
+// goes silent, where x86 arithmetic is many times slower than normal
+//------------------------------------------------------------------------------
+inline t_float FlushDenormal( t_float number )
+{
+    return Absolute( number ) < ( t_float )DENORMAL_FLOOR ? 0 : number;
+}
+
+
+//------------------------------------------------------------------------------
+// FlushDenormals - zeroes every sample of a state vector too small to matter
+//------------------------------------------------------------------------------
+inline void FlushDenormals( t_float* vector, t_int frames )
+{
+    t_int n;
+
+    // a branchless select the compiler vectorizes
+    for( n = 0 ; n < frames ; ++n )
+    {
+        vector[ n ] = FlushDenormal( vector[ n ] );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// ControlTick - clock callback sending a control's values out its outlet
+//------------------------------------------------------------------------------
+inline void ControlTick( t_control* control )
+{
+    t_atom list[ CONTROL_VALUES ];
+    t_int  index;
+
+    if( control->count == 1 )
+    {
+        outlet_float( control->outlet, control->values[ 0 ] );
+        return;
+    }
+
+    for( index = 0 ; index < control->count ; ++index )
+    {
+        SETFLOAT( &list[ index ], control->values[ index ] );
+    }
+
+    outlet_list( control->outlet, gensym( "list" ), ( int )control->count, list );
+}
+
+
+//------------------------------------------------------------------------------
+// ControlNew - creates a control outlet mirroring count block constant values
+//------------------------------------------------------------------------------
+inline void ControlNew( t_control* control, t_object* owner, t_int count )
+{
+    control->count  = count < CONTROL_VALUES ? count : CONTROL_VALUES;
+    control->valid  = FALSE;
+    control->outlet = outlet_new( owner, count == 1 ? gensym( "float" ) : gensym( "list" ) );
+    control->clock  = clock_new( control, ( t_method )ControlTick );
+}
+
+
+//------------------------------------------------------------------------------
+// ControlFree - releases a control's clock
+//------------------------------------------------------------------------------
+inline void ControlFree( t_control* control )
+{
+    clock_free( control->clock );
+}
+
+
+//------------------------------------------------------------------------------
+// ControlSet - records this block's values, scheduling output if they changed
+//------------------------------------------------------------------------------
+inline void ControlSet( t_control* control, const t_float* values )
+{
+    t_int index;
+    t_int changed = !control->valid;
+
+    for( index = 0 ; index < control->count ; ++index )
+    {
+        if( control->values[ index ] != values[ index ] )
+        {
+            control->values[ index ] = values[ index ];
+            changed = TRUE;
+        }
+    }
+
+    if( changed )
+    {
+        control->valid = TRUE;
+        clock_delay( control->clock, 0 );
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// GateRange - passes bin pairs whose key lies within lower to upper inclusive
+// and zeroes the rest, keying on the in1 value or, with by_index, the bin number
+//------------------------------------------------------------------------------
+// every bin is read before it is written, so outlets may share inlet vectors
+//------------------------------------------------------------------------------
+inline void GateRange( t_float* in1, t_float* in2, t_float* out1, t_float* out2, t_float lower, t_float upper, t_int by_index, t_int frames )
+{
+    t_floatbits a[ GATE_CHUNK ];
+    t_floatbits b[ GATE_CHUNK ];
+    t_floatbits mask;
+    t_float     key[ GATE_CHUNK ];
+    t_float     value_a;
+    t_float     value_b;
+    t_int       n = 0;
+    t_int       i;
+
+    // by index the mask is known per span - copy within, then clear below and above
+    if( by_index )
+    {
+        t_int first = Clip( ceilf( lower ), 0, frames );
+        t_int last  = Clip( floorf( upper ) + 1, first, frames );
+        t_int bytes = ( last - first ) * sizeof( t_float );
+
+        if( out1 == in2 && out2 == in1 )
+        {
+            // outlets swap the inlet vectors, so each pair is read before it is written
+            for( n = first ; n < last ; ++n )
+            {
+                value_a   = in1[ n ];
+                value_b   = in2[ n ];
+                out1[ n ] = value_a;
+                out2[ n ] = value_b;
+            }
+        }
+        else if( out1 == in2 )
+        {
+            // move inlet 2 out of the way before outlet 1 overwrites it
+            memmove( out2 + first, in2 + first, bytes );
+            memmove( out1 + first, in1 + first, bytes );
+        }
+        else
+        {
+            memmove( out1 + first, in1 + first, bytes );
+            memmove( out2 + first, in2 + first, bytes );
+        }
+
+        memset( out1, 0, first * sizeof( t_float ) );
+        memset( out2, 0, first * sizeof( t_float ) );
+        memset( out1 + last, 0, ( frames - last ) * sizeof( t_float ) );
+        memset( out2 + last, 0, ( frames - last ) * sizeof( t_float ) );
+
+        return;
+    }
+
+    // by value, whole chunks - load as bits before anything is stored, compare,
+    // then keep or clear every bit of each bin pair
+    for( ; n + GATE_CHUNK <= frames ; n += GATE_CHUNK )
+    {
+        memcpy( a,   in1 + n, sizeof( a ) );
+        memcpy( b,   in2 + n, sizeof( b ) );
+        memcpy( key, in1 + n, sizeof( key ) );
+
+        for( i = 0 ; i < GATE_CHUNK ; ++i )
+        {
+            mask = -( t_floatbits )( ( key[ i ] >= lower ) & ( key[ i ] <= upper ) );
+
+            a[ i ] &= mask;
+            b[ i ] &= mask;
+        }
+
+        memcpy( out1 + n, a, sizeof( a ) );
+        memcpy( out2 + n, b, sizeof( b ) );
+    }
+
+    // remaining bins of block sizes that are not a multiple of the chunk
+    for( ; n < frames ; ++n )
+    {
+        value_a = in1[ n ];
+        value_b = in2[ n ];
+        mask    = ( value_a >= lower ) & ( value_a <= upper );
+
+        out1[ n ] = mask ? value_a : 0;
+        out2[ n ] = mask ? value_b : 0;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// ColorSchemeId - returns the COLOR_SCHEME named by a string, or -1 if unknown
+//------------------------------------------------------------------------------
+inline t_int ColorSchemeId( const char* name )
+{
+    t_int scheme = -1;
+
+    if( StringMatch( name, "rgb" ) )
+    {
+        scheme = COLOR_RGB;
+    }
+    else if( StringMatch( name, "purple-yellow" ) )
+    {
+        scheme = COLOR_PURPLE_YELLOW;
+    }
+    else if( StringMatch( name, "blue-green" ) )
+    {
+        scheme = COLOR_BLUE_GREEN;
+    }
+    else if( StringMatch( name, "amber" ) )
+    {
+        scheme = COLOR_AMBER;
+    }
+    else if( StringMatch( name, "red" ) )
+    {
+        scheme = COLOR_RED;
+    }
+    else if( StringMatch( name, "green" ) )
+    {
+        scheme = COLOR_GREEN;
+    }
+    else if( StringMatch( name, "blue" ) )
+    {
+        scheme = COLOR_BLUE;
+    }
+    else if( StringMatch( name, "grey" ) )
+    {
+        scheme = COLOR_GREY;
+    }
+
+    return scheme;
+}
+
+
+//------------------------------------------------------------------------------
+// ColorCurve - calculates the red, green, and blue values of a color scheme
+// for x from 0 to 1
+//------------------------------------------------------------------------------
+inline void ColorCurve( t_int scheme, t_float x, t_float* r, t_float* g, t_float* b )
+{
+    switch( scheme )
+    {
+        case COLOR_RGB           :  *r = 0.5 * ( 1.0 - Cosine( C_PI * x * x ) );
+                                    *g = 0.5 * ( 1.0 - Cosine( C_2_PI * x * x ) );
+                                    *b = ( 1.0 - ( 0.5 * ( 1.0 - Cosine( C_PI * x ) ) ) ) * Power( x, 0.75 ) * 3;
+                                    break;
+
+        case COLOR_PURPLE_YELLOW :  *r = 0.5 * ( 1.0 - Cosine( C_PI * Power( x, 1.5 ) ) );
+                                    *g = x * x * x * x;
+                                    *b = ( 1.0 - ( 0.5 * ( 1.0 - Cosine( C_PI * x * x ) ) ) ) * Power( x, 0.75 ) * 1.25;
+                                    break;
+
+        case COLOR_BLUE_GREEN    :  *r = x * x * x * x;
+                                    *g = 0.5 * ( 1.0 - Cosine( C_PI * Power( x, 1.5 ) ) );
+                                    *b = ( 1.0 - ( 0.5 * ( 1.0 - Cosine( C_PI * x * x ) ) ) ) * Power( x, 0.75 ) * 1.25;
+                                    break;
+
+        case COLOR_AMBER         :  *r = ( 0.5 * ( 1.0 - Cosine( C_PI * x ) ) );
+                                    *g = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x ) ) );
+                                    *b = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x * x ) ) );
+                                    break;
+
+        case COLOR_RED           :  *r = ( 0.5 * ( 1.0 - Cosine( C_PI * x ) ) );
+                                    *g = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x * x * x ) ) );
+                                    *b = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x * x * x ) ) );
+                                    break;
+
+        case COLOR_GREEN         :  *r = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x * x ) ) );
+                                    *g = ( 0.5 * ( 1.0 - Cosine( C_PI * x ) ) );
+                                    *b = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x ) ) );
+                                    break;
+
+        case COLOR_BLUE          :  *r = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x * x ) ) );
+                                    *g = ( 0.5 * ( 1.0 - Cosine( C_PI * x * x ) ) );
+                                    *b = ( 0.5 * ( 1.0 - Cosine( C_PI * x ) ) );
+                                    break;
+
+        default                  :  *r = x;
+                                    *g = x;
+                                    *b = x;
+                                    break;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// PartialsCount - number of partials in a sparse partial list, kept within its capacity
+//------------------------------------------------------------------------------
+inline t_int PartialsCount( const t_float* list, t_int frames )
+{
+    return ( t_int )Clip( FixNan( list[ 0 ] ), 0, ClipMin( PARTIALS_CAPACITY( frames ), 0 ) );
+}
+
+
+//------------------------------------------------------------------------------
+// PartialsPack - writes the non-zero bins of dense magnitude / frequency vectors
+// as a sparse partial list, in bin order, until the list is full
+//------------------------------------------------------------------------------
+// every bin is stored at the list's end and the count only moves past it when
+// the magnitude is non-zero, so the loop has no branch to mispredict
+//------------------------------------------------------------------------------
+inline t_int PartialsPack( t_float* list, t_int frames, const t_float* mag, const t_float* freq, t_int bins )
+{
+    t_float* bin_list  = PARTIALS_BINS ( list, frames );
+    t_float* mag_list  = PARTIALS_MAGS ( list, frames );
+    t_float* freq_list = PARTIALS_FREQS( list, frames );
+    t_int    capacity  = PARTIALS_CAPACITY( frames );
+    t_int    count     = 0;
+    t_int    n;
+
+    memset( list, 0, frames * sizeof( t_float ) );
+
+    for( n = 0 ; ( n < bins ) && ( count < capacity ) ; ++n )
+    {
+        bin_list [ count ] = n;
+        mag_list [ count ] = mag [ n ];
+        freq_list[ count ] = freq[ n ];
+
+        count += ( mag[ n ] != 0 );
+    }
+
+    // clear the slot left by a trailing zero bin
+    if( count < capacity )
+    {
+        bin_list [ count ] = 0;
+        mag_list [ count ] = 0;
+        freq_list[ count ] = 0;
+    }
+
+    list[ 0 ] = count;
+
+    return count;
+}
+
+
 //------------------------------------------------------------------------------
 // EOF
 //------------------------------------------------------------------------------
@@ -227,25 +227,30 @@ static void valleys_dsp( t_valleys* object, t_signal **sig )
     // calculate memory size of signal vector for memset and realloc
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // save memory_size for use in dsp loop
-    object->memory_size = memory_size;
-
-    // allocate enough memory to hold signal vector data ( in1 and indices need an extra location for sorting )
-    object->in1_valleys  = realloc( object->in1_valleys,  memory_size + sizeof( t_float ) );
-    object->in2_valleys  = realloc( object->in2_valleys,  memory_size );
-    object->in1_temp     = realloc( object->in1_temp,     memory_size );
-    object->in2_temp     = realloc( object->in2_temp,     memory_size );
-    object->indices      = realloc( object->indices,      memory_size + sizeof( t_float ) );
-    object->vector_index = realloc( object->vector_index, memory_size );
-
-    // init extra sorting values
-    object->in1_valleys[ frames ] = C_FLOAT_MIN;
-    object->indices    [ frames ] = 0;
-
-    // increment values stored in vector_index
-    for( t_int index = 0 ; index < frames ; ++index )
+    // only reallocate memory when the vector size has changed
+    if( memory_size != object->memory_size )
     {
-        object->vector_index[ index ] = ( t_float )index;
+
+        // allocate enough memory to hold signal vector data ( in1 and indices need an extra location for sorting )
+        object->in1_valleys  = realloc( object->in1_valleys,  memory_size + sizeof( t_float ) );
+        object->in2_valleys  = realloc( object->in2_valleys,  memory_size );
+        object->in1_temp     = realloc( object->in1_temp,     memory_size );
+        object->in2_temp     = realloc( object->in2_temp,     memory_size );
+        object->indices      = realloc( object->indices,      memory_size + sizeof( t_float ) );
+        object->vector_index = realloc( object->vector_index, memory_size );
+
+        // init extra sorting values
+        object->in1_valleys[ frames ] = C_FLOAT_MIN;
+        object->indices    [ frames ] = 0;
+
+        // increment values stored in vector_index
+        for( t_int index = 0 ; index < frames ; ++index )
+        {
+            object->vector_index[ index ] = ( t_float )index;
+        }
+
+        // save memory_size for use in dsp loop
+        object->memory_size = memory_size;
     }
 
     // dsp_add arguments
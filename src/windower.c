@@ -21,6 +21,9 @@
 // utility header for Pd Spectral Toolkit project
 #include "utility.h"
 
+// standard headers
+#include <stdlib.h>
+
 // disable compiler warnings on windows
 #ifdef NT
 #pragma warning( disable : 4244 )
@@ -28,12 +31,28 @@
 #endif
 
 
+//------------------------------------------------------------------------------
+// constant definitions
+//------------------------------------------------------------------------------
+
+// terms of the bessel series - enough for float precision up to the largest
+// kaiser coefficient
+#define BESSEL_TERMS 24
+
+
 //------------------------------------------------------------------------------
 // windower_class - pointer to this object's definition
 //------------------------------------------------------------------------------
 t_class* windower_class;
 
 
+//------------------------------------------------------------------------------
+// windower_bessel - ratios 1 / k^2 between successive terms of the zeroth
+// order modified bessel function series in ( x / 2 )^2, shared by every windower
+//------------------------------------------------------------------------------
+static t_float windower_bessel[ BESSEL_TERMS + 1 ];
+
+
 //------------------------------------------------------------------------------
 // WINDOW_ID - enumerated window names
 //------------------------------------------------------------------------------
@@ -96,6 +115,19 @@ typedef struct windower
     // hann-poisson window coefficient
     t_float     hann_poisson_coeff;
 
+    // first half of the window shapes shared by several windows, kept
+    // between fills so coefficient changes only redo the per window math
+    //--------------------------------------------------------------------------
+
+    // cosine( 2 pi n / ( N - 1 ) )
+    t_float*    cosine_table;
+
+    // 1 - ( 2 n / ( N - 1 ) - 1 )^2
+    t_float*    taper_table;
+
+    // array size the tables were made for
+    t_int       table_size;
+
 } t_windower;
 
 
@@ -103,11 +135,90 @@ typedef struct windower
 // function prototypes
 //------------------------------------------------------------------------------
 
-static void  windower_fill_array    ( t_windower* object );
-void         windower_message_parse ( t_windower* object, t_symbol* selector, t_int items, t_atom* list );
-void         windower_bang          ( t_windower* object );
-static void* windower_new           ( t_symbol* selector, t_int items, t_atom* list );
-void         windower_setup         ( void );
+static void    windower_make_tables   ( t_windower* object, t_int size );
+static t_float windower_bessel_series ( t_float y );
+static void    windower_cosine_sum    ( t_windower* object, t_word* array_data, t_float a0, t_float a1, t_float a2, t_float a3 );
+static void    windower_fill_array    ( t_windower* object );
+void           windower_message_parse ( t_windower* object, t_symbol* selector, t_int items, t_atom* list );
+void           windower_bang          ( t_windower* object );
+static void*   windower_new           ( t_symbol* selector, t_int items, t_atom* list );
+static void    windower_free          ( t_windower* object );
+void           windower_setup         ( void );
+
+
+//------------------------------------------------------------------------------
+// windower_make_tables - calculates the shared window shapes for an array size
+//------------------------------------------------------------------------------
+static void windower_make_tables( t_windower* object, t_int size )
+{
+    // only the first half is needed since every window is symmetric
+    t_int   half = ( size + 1 ) / 2;
+    t_float N    = size;
+    t_float r;
+    t_int   n;
+
+    if( size == object->table_size )
+    {
+        return;
+    }
+
+    object->cosine_table = ( t_float* )realloc( object->cosine_table, half * sizeof( t_float ) );
+    object->taper_table  = ( t_float* )realloc( object->taper_table,  half * sizeof( t_float ) );
+    object->table_size   = size;
+
+    for( n = 0 ; n < half ; ++n )
+    {
+        r = ( 2.0 * n ) / ( N - 1 ) - 1;
+
+        object->cosine_table[ n ] = Cosine( ( C_2_PI * n ) / ( N - 1 ) );
+        object->taper_table[ n ]  = 1 - r * r;
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// windower_bessel_series - bessel function I0( x ) for y = ( x / 2 )^2
+//------------------------------------------------------------------------------
+static t_float windower_bessel_series( t_float y )
+{
+    t_float result = 1;
+    t_int   k;
+
+    // nested from the last term so no coefficient gets small enough to underflow
+    for( k = BESSEL_TERMS ; k > 0 ; --k )
+    {
+        result = 1 + result * y * windower_bessel[ k ];
+    }
+
+    return result;
+}
+
+
+//------------------------------------------------------------------------------
+// windower_cosine_sum - writes a0 - a1 cos( x ) + a2 cos( 2x ) - a3 cos( 3x )
+// into the first half of the array
+//------------------------------------------------------------------------------
+// the multiple angles are chebyshev polynomials of cos( x ), so each sample
+// is a cubic in one table value
+//------------------------------------------------------------------------------
+static void windower_cosine_sum( t_windower* object, t_word* array_data, t_float a0, t_float a1, t_float a2, t_float a3 )
+{
+    t_float* cosine = object->cosine_table;
+    t_int    half   = ( object->table_size + 1 ) / 2;
+    t_float  p0     = a0 - a2;
+    t_float  p1     = 3 * a3 - a1;
+    t_float  p2     = 2 * a2;
+    t_float  p3     = -4 * a3;
+    t_float  c;
+    t_int    n;
+
+    for( n = 0 ; n < half ; ++n )
+    {
+        c = cosine[ n ];
+
+        array_data[ n ].w_float = p0 + c * ( p1 + c * ( p2 + c * p3 ) );
+    }
+}
 
 
 //------------------------------------------------------------------------------
@@ -136,11 +247,11 @@ static void windower_fill_array( t_windower* object )
     // array index iterator
     t_int index;
 
-    // array value pointer
-    t_float* value;
+    // first half of the array, which is mirrored into the second
+    t_int half;
 
     // temp variables for window function calculation
-    t_float a, a0, a1, a2, a3, temp;
+    t_float a, b, c, temp;
 
     // check to make sure windower has an array name to work with
     //--------------------------------------------------------------------------
@@ -170,140 +281,197 @@ static void windower_fill_array( t_windower* object )
         return;
     }
 
-    // save array size into N for easy reading in the window formulae
-    N = array_size;
-
-    // iterate through the array
-    for( index = 0 ; index < N ; ++index )
+    // a single point window has no shape
+    if( array_size < 2 )
     {
-        // assign index to n instead of typecasting index to float for easier reading in formulae
-        n = index;
-
-        // assign w_float element address to value for easier reading in formulae
-        value = &( array_data[ index ].w_float );
-
-        // calculate window values based on window_id
-        switch( object->window_id )
+        for( index = 0 ; index < array_size ; ++index )
         {
-            // rectangle
-            //------------------------------------------------------------------
-            case RECTANGLE          :   *value = 1;
-                                        break;
+            array_data[ index ].w_float = 1;
+        }
 
-            // hann
-            //------------------------------------------------------------------
-            case HANN               :   *value = 0.5 * ( 1 - Cosine( ( C_2_PI * n ) / ( N - 1 ) ) );
-                                        break;
+        garray_redraw( array );
+        return;
+    }
 
-            // hamming
-            //------------------------------------------------------------------
-            case HAMMING            :   *value = 0.54 - 0.46 * Cosine( ( C_2_PI * n ) / ( N - 1 ) );
-                                        break;
+    // save array size into N for easy reading in the window formulae
+    N    = array_size;
+    half = ( array_size + 1 ) / 2;
 
-            // tukey
-            //------------------------------------------------------------------
-            case TUKEY              :   a = object->tukey_coeff;
+    windower_make_tables( object, array_size );
 
-                                        if( ( n >= 0 ) && ( n <= ( ( a * ( N - 1 ) ) / 2 ) ) )
-                                        {
-                                            *value = 0.5 * ( 1 + Cosine( C_PI * ( ( ( 2 * n ) / ( a * ( N - 1 ) ) ) - 1 ) ) );
-                                        }
-                                        else if( ( n >= ( ( a * ( N - 1 ) ) / 2 ) ) && ( n <= ( ( N - 1 ) * ( 1 - ( a / 2 ) ) ) ) )
+    // calculate the first half of the window, choosing the window once
+    switch( object->window_id )
+    {
+        // rectangle
+        //----------------------------------------------------------------------
+        case RECTANGLE          :   for( index = 0 ; index < half ; ++index )
+                                    {
+                                        array_data[ index ].w_float = 1;
+                                    }
+
+                                    break;
+
+        // hann
+        //----------------------------------------------------------------------
+        case HANN               :   windower_cosine_sum( object, array_data, 0.5, 0.5, 0, 0 );
+                                    break;
+
+        // hamming
+        //----------------------------------------------------------------------
+        case HAMMING            :   windower_cosine_sum( object, array_data, 0.54, 0.46, 0, 0 );
+                                    break;
+
+        // tukey
+        //----------------------------------------------------------------------
+        case TUKEY              :   a = object->tukey_coeff;
+                                    b = ( a * ( N - 1 ) ) / 2;
+
+                                    for( index = 0 ; index < half ; ++index )
+                                    {
+                                        n = index;
+
+                                        if( n <= b )
                                         {
-                                            *value = 1;
+                                            array_data[ index ].w_float = 0.5 * ( 1 + Cosine( C_PI * ( ( n / b ) - 1 ) ) );
                                         }
-                                        else if( ( n >= ( ( N - 1 ) * ( 1 - ( a / 2 ) ) ) ) && ( n <= ( N - 1 ) ) )
+                                        else
                                         {
-                                            *value = 0.5 * ( 1 + Cosine( C_PI * ( ( ( 2 * n ) / ( a * ( N - 1 ) ) ) - ( 2 / a ) + 1 ) ) );
+                                            array_data[ index ].w_float = 1;
                                         }
+                                    }
 
-                                        break;
-
-            // cosine
-            //------------------------------------------------------------------
-            case COSINE             :   *value = Cosine( ( ( C_PI * n ) / ( N - 1 ) ) - C_PI_OVER_2 );
-                                        break;
-
-            // lanczos
-            //------------------------------------------------------------------
-            case LANCZOS            :   temp   = ( ( 2 * n ) / ( N - 1 ) ) - 1;
-                                        temp   = ( temp == 0 ? C_FLOAT_MIN : temp );
-                                        *value = NormalizedSinc( temp );
-                                        break;
-
-            // triangle
-            //------------------------------------------------------------------
-            case TRIANGLE           :   *value = ( 2 / ( N - 1 ) ) * ( ( ( N - 1 ) / 2 ) - Absolute( n - ( ( N - 1 ) / 2 ) ) );
-                                        break;
-
-            // gaussian
-            //------------------------------------------------------------------
-            case GAUSSIAN           :   a      = object->gaussian_coeff;
-                                        *value = Power( C_E, ( -0.5 * Power( ( ( n - ( ( N - 1 ) / 2 ) ) / ( a * ( ( N - 1 ) / 2 ) ) ), 2 ) ) );
-                                        break;
-
-            // bartlett-hann
-            //------------------------------------------------------------------
-            case BARTLETT_HANN      :   *value = 0.62 - 0.48 * Absolute( n / ( N - 1 ) - 0.5 ) - 0.38 * Cosine( ( C_2_PI * n ) / ( N - 1 ) );
-                                        break;
-
-            //  blackman
-            //------------------------------------------------------------------
-            case BLACKMAN           :   a0     = ( 1 - object->blackman_coeff ) * 0.5;
-                                        a1     = 0.5;
-                                        a2     = object->blackman_coeff * 0.5;
-                                        *value = a0 - a1 * Cosine( ( C_2_PI * n ) / ( N - 1 ) ) + a2 * Cosine( ( C_4_PI * n ) / ( N - 1 ) );
-                                        break;
-
-            // kaiser
-            //------------------------------------------------------------------
-            case KAISER             :   a      = object->kaiser_coeff;
-                                        *value = BesselI0( C_PI * a * SquareRoot( 1 - Power( ( ( 2 * n ) / ( N - 1 ) - 1 ), 2 ) ) ) / BesselI0( C_PI * a );
-                                        break;
-
-            // nuttall
-            //------------------------------------------------------------------
-            case NUTTALL            :   a0     = 0.355768;
-                                        a1     = 0.487396;
-                                        a2     = 0.144232;
-                                        a3     = 0.012604;
-                                        *value = a0 - a1 * Cosine( ( C_2_PI * n ) / ( N - 1 ) ) + a2 * Cosine( ( C_4_PI * n ) / ( N - 1 ) ) - a3 * Cosine( ( C_6_PI * n ) / ( N - 1 ) );
-                                        break;
-
-            // blackman-harris
-            //------------------------------------------------------------------
-            case BLACKMAN_HARRIS    :   a0     = 0.35875;
-                                        a1     = 0.48829;
-                                        a2     = 0.14128;
-                                        a3     = 0.01168;
-                                        *value = a0 - a1 * Cosine( ( C_2_PI * n ) / ( N - 1 ) ) + a2 * Cosine( ( C_4_PI * n ) / ( N - 1 ) ) - a3 * Cosine( ( C_6_PI * n ) / ( N - 1 ) );
-                                        break;
-
-            // blackman-nuttall
-            //------------------------------------------------------------------
-            case BLACKMAN_NUTTALL   :   a0     = 0.3635819;
-                                        a1     = 0.4891775;
-                                        a2     = 0.1365995;
-                                        a3     = 0.0106411;
-                                        *value = a0 - a1 * Cosine( ( C_2_PI * n ) / ( N - 1 ) ) + a2 * Cosine( ( C_4_PI * n ) / ( N - 1 ) ) - a3 * Cosine( ( C_6_PI * n ) / ( N - 1 ) );
-                                        break;
-
-            // poisson
-            //------------------------------------------------------------------
-            case POISSON            :   a      = object->poisson_coeff;
-                                        *value = Power( C_E, -Absolute( n - ( N - 1 ) / 2) * ( 1 / ( ( N - 1 ) / ( 2 * a ) ) ) );
-                                        break;
-
-            // hann-poisson
-            //------------------------------------------------------------------
-            case HANN_POISSON       :   a      = object->hann_poisson_coeff;
-                                        *value = ( 0.5 * ( 1 - Cosine( ( C_2_PI * n ) / ( N - 1 ) ) ) ) * Power( C_E, -Absolute( n - ( N - 1 ) / 2) * ( 1 / ( ( N - 1 ) / ( 2 * a ) ) ) );
-                                        break;
-
-            // end window calculation
-            //------------------------------------------------------------------
+                                    break;
+
+        // cosine
+        //----------------------------------------------------------------------
+        case COSINE             :   for( index = 0 ; index < half ; ++index )
+                                    {
+                                        n = index;
+
+                                        array_data[ index ].w_float = Sine( ( C_PI * n ) / ( N - 1 ) );
+                                    }
+
+                                    break;
+
+        // lanczos
+        //----------------------------------------------------------------------
+        case LANCZOS            :   for( index = 0 ; index < half ; ++index )
+                                    {
+                                        n    = index;
+                                        temp = ( ( 2 * n ) / ( N - 1 ) ) - 1;
+                                        temp = ( temp == 0 ? C_FLOAT_MIN : temp );
+
+                                        array_data[ index ].w_float = NormalizedSinc( temp );
+                                    }
+
+                                    break;
+
+        // triangle
+        //----------------------------------------------------------------------
+        case TRIANGLE           :   for( index = 0 ; index < half ; ++index )
+                                    {
+                                        n = index;
+
+                                        array_data[ index ].w_float = ( 2 * n ) / ( N - 1 );
+                                    }
+
+                                    break;
+
+        // gaussian
+        //----------------------------------------------------------------------
+        case GAUSSIAN           :   a = object->gaussian_coeff * ( ( N - 1 ) / 2 );
+
+                                    for( index = 0 ; index < half ; ++index )
+                                    {
+                                        n    = index;
+                                        temp = ( n - ( ( N - 1 ) / 2 ) ) / a;
+
+                                        array_data[ index ].w_float = expf( -0.5 * temp * temp );
+                                    }
+
+                                    break;
+
+        // bartlett-hann
+        //----------------------------------------------------------------------
+        case BARTLETT_HANN      :   for( index = 0 ; index < half ; ++index )
+                                    {
+                                        n = index;
+
+                                        array_data[ index ].w_float = 0.62 - 0.48 * ( 0.5 - n / ( N - 1 ) ) - 0.38 * object->cosine_table[ index ];
+                                    }
+
+                                    break;
+
+        //  blackman
+        //----------------------------------------------------------------------
+        case BLACKMAN           :   windower_cosine_sum( object, array_data, ( 1 - object->blackman_coeff ) * 0.5, 0.5, object->blackman_coeff * 0.5, 0 );
+                                    break;
+
+        // kaiser - the bessel argument squared over 4 is ( pi a / 2 )^2 times
+        // the taper, so the cached series needs no square root per sample
+        //----------------------------------------------------------------------
+        case KAISER             :   a = C_PI * object->kaiser_coeff * 0.5;
+                                    a = a * a;
+                                    b = 1 / windower_bessel_series( a );
+
+                                    for( index = 0 ; index < half ; ++index )
+                                    {
+                                        array_data[ index ].w_float = windower_bessel_series( a * object->taper_table[ index ] ) * b;
+                                    }
+
+                                    break;
+
+        // nuttall
+        //----------------------------------------------------------------------
+        case NUTTALL            :   windower_cosine_sum( object, array_data, 0.355768, 0.487396, 0.144232, 0.012604 );
+                                    break;
+
+        // blackman-harris
+        //----------------------------------------------------------------------
+        case BLACKMAN_HARRIS    :   windower_cosine_sum( object, array_data, 0.35875, 0.48829, 0.14128, 0.01168 );
+                                    break;
+
+        // blackman-nuttall
+        //----------------------------------------------------------------------
+        case BLACKMAN_NUTTALL   :   windower_cosine_sum( object, array_data, 0.3635819, 0.4891775, 0.1365995, 0.0106411 );
+                                    break;
+
+        // poisson
+        //----------------------------------------------------------------------
+        case POISSON            :   a = ( 2 * object->poisson_coeff ) / ( N - 1 );
+
+                                    for( index = 0 ; index < half ; ++index )
+                                    {
+                                        n = index;
+
+                                        array_data[ index ].w_float = expf( ( n - ( N - 1 ) / 2 ) * a );
+                                    }
+
+                                    break;
+
+        // hann-poisson
+        //----------------------------------------------------------------------
+        case HANN_POISSON       :   a = ( 2 * object->hann_poisson_coeff ) / ( N - 1 );
+
+                                    for( index = 0 ; index < half ; ++index )
+                                    {
+                                        n = index;
+                                        c = object->cosine_table[ index ];
+
+                                        array_data[ index ].w_float = ( 0.5 * ( 1 - c ) ) * expf( ( n - ( N - 1 ) / 2 ) * a );
+                                    }
+
+                                    break;
+
+        // end window calculation
+        //----------------------------------------------------------------------
 
-        }
+    }
+
+    // mirror the first half into the second
+    for( index = 0 ; index < array_size / 2 ; ++index )
+    {
+        array_data[ array_size - 1 - index ].w_float = array_data[ index ].w_float;
     }
 
     garray_redraw( array );
@@ -708,6 +876,11 @@ static void* windower_new( t_symbol* selector, t_int items, t_atom* list )
     // generate a new object and save its pointer in "object"
     object = ( t_windower* )pd_new( windower_class );
 
+    // window shape tables are made on the first fill
+    object->cosine_table = NULL;
+    object->taper_table  = NULL;
+    object->table_size   = 0;
+
     t_symbol init_selector;
     t_atom init_list;
 
@@ -785,19 +958,37 @@ static void* windower_new( t_symbol* selector, t_int items, t_atom* list )
 }
 
 
+//------------------------------------------------------------------------------
+// windower_free - cleans up memory allocated by this object
+//------------------------------------------------------------------------------
+static void windower_free( t_windower* object )
+{
+    free( object->cosine_table );
+    free( object->taper_table );
+}
+
+
 //------------------------------------------------------------------------------
 // windower setup - defines this object and its properties to Pd
 //------------------------------------------------------------------------------
 void windower_setup( void )
 {
     // create a new class and assign its pointer to windower_class
-    windower_class = class_new( gensym( "windower" ), ( t_newmethod )windower_new, 0, sizeof( t_windower ), 0, A_GIMME, 0 );
+    windower_class = class_new( gensym( "windower" ), ( t_newmethod )windower_new, ( t_method )windower_free, sizeof( t_windower ), 0, A_GIMME, 0 );
 
     // add message handlers
     class_addmethod( windower_class, ( t_method )windower_message_parse, gensym( "anything" ), A_GIMME, 0 );
 
     // add bang handler
     class_addbang( windower_class, ( t_method )windower_bang );
+
+    // calculate the bessel series term ratios
+    t_int k;
+
+    for( k = 1 ; k <= BESSEL_TERMS ; ++k )
+    {
+        windower_bessel[ k ] = 1 / ( ( t_float )k * k );
+    }
 }
 
 
@@ -75,6 +75,9 @@ typedef struct winfft
     // number of data elements in the window array
     int window_array_size;
 
+    // dsp timing record read by spectprof ( empty unless profiling is compiled in )
+    PROFILE_MEMBER
+
 } t_winfft;
 
 
@@ -159,21 +162,28 @@ static void winfft_dsp( t_winfft* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate enough memory to hold signal vector data
-    object->rfft_array = realloc( object->rfft_array, memory_size );
-    object->real_array = realloc( object->real_array, memory_size );
-    object->imag_array = realloc( object->imag_array, memory_size );
+    // only reallocate memory when the vector size has changed
+    if( memory_size != object->memory_size )
+    {
+        // allocate enough memory to hold signal vector data
+        object->rfft_array = realloc( object->rfft_array, memory_size );
+        object->real_array = realloc( object->real_array, memory_size );
+        object->imag_array = realloc( object->imag_array, memory_size );
 
-    // set real and imaginary memory to zero
-    memset( object->real_array,  0, memory_size );
-    memset( object->imag_array,  0, memory_size );
+        // set real and imaginary memory to zero
+        memset( object->real_array,  0, memory_size );
+        memset( object->imag_array,  0, memory_size );
 
-    // save memory size for use in dsp loop
-    object->memory_size = memory_size;
+        // save memory size for use in dsp loop
+        object->memory_size = memory_size;
+    }
 
     // set the window array associated with this object
     winfft_set_window_array( object );
 
+    // start timing this object ( when profiling is compiled in )
+    PROFILE_DSP_BEGIN( object );
+
     // dsp_add arguments
     //--------------------------------------------------------------------------
     // perform routine
@@ -184,6 +194,9 @@ static void winfft_dsp( t_winfft* object, t_signal **sig )
     // sample frames to process (vector size)
     // pointer to this object
     dsp_add( winfft_perform, 5, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 0 ]->s_n, object );
+
+    // stop timing this object
+    PROFILE_DSP_END( object );
 }
 
 
@@ -250,6 +263,9 @@ static void* winfft_new( t_symbol* selector, t_int items, t_atom* list )
     // create a pointer to this object
     t_winfft* object = ( t_winfft* )pd_new( winfft_class );
 
+    // register with the dsp profiler
+    PROFILE_REGISTER( object, "winfft~" );
+
     // create a two new signal outlets for this object
     outlet_new( &object->object, gensym( "signal" ) );
     outlet_new( &object->object, gensym( "signal" ) );
@@ -291,6 +307,9 @@ static void* winfft_new( t_symbol* selector, t_int items, t_atom* list )
 //------------------------------------------------------------------------------
 static void winfft_free( t_winfft* object )
 {
+    // unregister from the dsp profiler
+    PROFILE_UNREGISTER( object );
+
     // if memory is allocated
     if( object->rfft_array )
     {
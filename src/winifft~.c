@@ -75,6 +75,9 @@ typedef struct winifft
     // reciprocal of ifft size for normalization
     t_float size_recip;
 
+    // dsp timing record read by spectprof ( empty unless profiling is compiled in )
+    PROFILE_MEMBER
+
 } t_winifft;
 
 
@@ -160,11 +163,15 @@ static void winifft_dsp( t_winifft* object, t_signal **sig )
     // calculate memory size for realloc and memset
     t_int memory_size = sig[ 0 ]->s_n * sizeof( t_float );
 
-    // allocate enough memory to hold signal vector data
-    object->rifft_array = realloc( object->rifft_array, memory_size );
+    // only reallocate memory when the vector size has changed
+    if( memory_size != object->memory_size )
+    {
+        // allocate enough memory to hold signal vector data
+        object->rifft_array = realloc( object->rifft_array, memory_size );
 
-    // save memory size for use in dsp loop
-    object->memory_size = memory_size;
+        // save memory size for use in dsp loop
+        object->memory_size = memory_size;
+    }
 
     // reciprocal of ifft size for normalization
     object->size_recip = 1.0 / sig[ 0 ]->s_n;
@@ -172,6 +179,9 @@ static void winifft_dsp( t_winifft* object, t_signal **sig )
     // set the window array associated with this object
     winifft_set_window_array( object );
 
+    // start timing this object ( when profiling is compiled in )
+    PROFILE_DSP_BEGIN( object );
+
     // dsp_add arguments
     //--------------------------------------------------------------------------
     // perform routine
@@ -182,6 +192,9 @@ static void winifft_dsp( t_winifft* object, t_signal **sig )
     // sample frames to process (vector size)
     // pointer to this object
     dsp_add( winifft_perform, 5, sig[ 0 ]->s_vec, sig[ 1 ]->s_vec, sig[ 2 ]->s_vec, sig[ 0 ]->s_n, object );
+
+    // stop timing this object
+    PROFILE_DSP_END( object );
 }
 
 
@@ -248,6 +261,9 @@ static void* winifft_new( t_symbol* selector, t_int items, t_atom* list )
     // create a pointer to this object
     t_winifft* object = ( t_winifft* )pd_new( winifft_class );
 
+    // register with the dsp profiler
+    PROFILE_REGISTER( object, "winifft~" );
+
     // create a second signal inlet
     signalinlet_new( &object->object, object->inlet_2 );
 
@@ -289,6 +305,9 @@ static void* winifft_new( t_symbol* selector, t_int items, t_atom* list )
 //------------------------------------------------------------------------------
 static void winifft_free( t_winifft* object )
 {
+    // unregister from the dsp profiler
+    PROFILE_UNREGISTER( object );
+
     // if memory is allocated
     if( object->rifft_array )
     {